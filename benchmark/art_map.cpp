@@ -0,0 +1,111 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares memory, insertion, lookup and ordered iteration of tiny::art_map against std::map,
+// both for random keys and for dense sequential keys.
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <foonathan/tiny/art_map.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 16;
+constexpr std::size_t lookups     = 1u << 20;
+constexpr std::size_t repetitions = 10;
+
+using tiny_map_t = tiny::art_map<std::uint64_t, std::uint64_t>;
+using std_map_t  = std::map<std::uint64_t, std::uint64_t>;
+
+// the nodes of the common std::map implementations store the color and three pointers
+constexpr std::size_t std_map_node_size
+    = 4u * sizeof(void*) + sizeof(std::pair<const std::uint64_t, std::uint64_t>);
+
+void run(const char* name, const std::vector<std::uint64_t>& keys)
+{
+    std::printf("%s keys:\n", name);
+
+    tiny_map_t tiny_map;
+    std_map_t  std_map;
+    for (auto key : keys)
+    {
+        tiny_map.insert(key, key);
+        std_map.emplace(key, key);
+    }
+    std::printf("bytes per key: art_map %.1f, std::map %.1f (estimated)\n",
+                double(tiny_map.memory_usage()) / double(tiny_map.size()),
+                double(std_map_node_size));
+
+    auto tiny_insert = benchmark::measure(keys.size(), repetitions, [&] {
+        tiny_map_t map;
+        for (auto key : keys)
+            map.insert(key, key);
+        benchmark::do_not_optimize(map.size());
+    });
+    benchmark::print_result("art_map: insert", tiny_insert);
+
+    auto std_insert = benchmark::measure(keys.size(), repetitions, [&] {
+        std_map_t map;
+        for (auto key : keys)
+            map.emplace(key, key);
+        benchmark::do_not_optimize(map.size());
+    });
+    benchmark::print_result("std::map: insert", std_insert);
+
+    auto tiny_lookup = benchmark::measure(lookups, repetitions, [&] {
+        std::uint64_t sum = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            sum += *tiny_map.find(keys[i % keys.size()]);
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("art_map: lookup", tiny_lookup);
+
+    auto std_lookup = benchmark::measure(lookups, repetitions, [&] {
+        std::uint64_t sum = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            sum += std_map.find(keys[i % keys.size()])->second;
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("std::map: lookup", std_lookup);
+
+    auto tiny_iterate = benchmark::measure(keys.size(), repetitions, [&] {
+        std::uint64_t sum = 0;
+        tiny_map.for_each([&](std::uint64_t, std::uint64_t value) { sum += value; });
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("art_map: ordered iteration", tiny_iterate);
+
+    auto std_iterate = benchmark::measure(keys.size(), repetitions, [&] {
+        std::uint64_t sum = 0;
+        for (auto& entry : std_map)
+            sum += entry.second;
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("std::map: ordered iteration", std_iterate);
+}
+} // namespace
+
+int main()
+{
+    std::vector<std::uint64_t> random, sequential;
+    auto                       state = std::uint64_t(42);
+    for (auto i = 0u; i != size; ++i)
+    {
+        // xorshift
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        random.push_back(state);
+        sequential.push_back(i);
+    }
+
+    run("random", random);
+    run("sequential", sequential);
+}
@@ -0,0 +1,50 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_BENCHMARK_HPP_INCLUDED
+#define FOONATHAN_TINY_BENCHMARK_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdio>
+
+// Minimal benchmark helpers, so the benchmarks don't require an external library.
+namespace benchmark
+{
+// Prevents the compiler from optimizing away the computation of the value.
+template <typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+}
+
+// Runs the function `repetitions` times and returns the best time in nanoseconds per iteration.
+template <typename Fn>
+double measure(std::size_t iterations, std::size_t repetitions, Fn fn)
+{
+    auto best = 0.0;
+    for (auto i = 0u; i != repetitions; ++i)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+
+        auto time = std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+        if (i == 0u || time < best)
+            best = time;
+    }
+    return best;
+}
+
+inline void print_result(const char* name, double ns_per_iteration)
+{
+    std::printf("%-50s %8.3f ns\n", name, ns_per_iteration);
+}
+} // namespace benchmark
+
+#endif // FOONATHAN_TINY_BENCHMARK_HPP_INCLUDED
@@ -0,0 +1,96 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Stresses the metaprogramming of tiny_storage with FOONATHAN_TINY_FIELD_COUNT tiny types,
+// or, if FOONATHAN_TINY_JOINED_COUNT is defined, of a joined_bit_view of that many views.
+// It is only compiled, the build time and memory is the result of the benchmark.
+
+#include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+#ifndef FOONATHAN_TINY_FIELD_COUNT
+#    define FOONATHAN_TINY_FIELD_COUNT 32
+#endif
+
+namespace tiny = foonathan::tiny;
+
+#ifdef FOONATHAN_TINY_JOINED_COUNT
+namespace
+{
+// every view has the same number of bits, so the joined view can be extracted at once
+constexpr std::size_t view_bits = 64u / FOONATHAN_TINY_JOINED_COUNT;
+
+template <std::size_t I>
+using part_view = tiny::bit_view<std::uint8_t, 0, view_bits>;
+
+template <std::size_t... I>
+tiny::joined_bit_view<part_view<I>...> make_view(tiny::detail::index_sequence<I...>);
+
+using view = decltype(make_view(tiny::detail::make_index_sequence<FOONATHAN_TINY_JOINED_COUNT>{}));
+
+template <std::size_t... I>
+std::uintmax_t sum_parts(std::uint8_t (&parts)[FOONATHAN_TINY_JOINED_COUNT],
+                         tiny::detail::index_sequence<I...>)
+{
+    view v(parts[I]...);
+
+    // each subview of a part has to go through the joined views before it
+    bool assign[] = {(v.template subview<I * view_bits, (I + 1) * view_bits>().put(1u), true)...,
+                     true};
+    (void)assign;
+
+    std::uintmax_t result   = 0;
+    bool           access[] = {
+        (result += v.template subview<I * view_bits, (I + 1) * view_bits>().extract(), true)...,
+        true};
+    (void)access;
+    return result + v.extract();
+}
+} // namespace
+
+int main()
+{
+    std::uint8_t parts[FOONATHAN_TINY_JOINED_COUNT] = {};
+    return sum_parts(parts, tiny::detail::make_index_sequence<FOONATHAN_TINY_JOINED_COUNT>{}) != 0
+               ? 0
+               : 1;
+}
+#else
+namespace
+{
+// fields of different sizes, so the extracters differ as well
+template <std::size_t I>
+using field = typename std::conditional<I % 5 == 0, tiny::tiny_bool,
+                                        tiny::tiny_unsigned<I % 13 + 1, std::uint16_t>>::type;
+
+template <std::size_t... I>
+tiny::tiny_storage<field<I>...> make_storage(tiny::detail::index_sequence<I...>);
+
+using storage
+    = decltype(make_storage(tiny::detail::make_index_sequence<FOONATHAN_TINY_FIELD_COUNT>{}));
+
+template <std::size_t... I>
+unsigned sum_fields(storage& s, tiny::detail::index_sequence<I...>)
+{
+    bool assign[] = {(s.at<I>() = typename field<I>::object_type(1), true)..., true};
+    (void)assign;
+
+    unsigned result   = 0;
+    bool     access[] = {(result += unsigned(s.at<I>()), true)..., true};
+    (void)access;
+    return result;
+}
+} // namespace
+
+int main()
+{
+    storage s;
+    return sum_fields(s, tiny::detail::make_index_sequence<FOONATHAN_TINY_FIELD_COUNT>{})
+                   == FOONATHAN_TINY_FIELD_COUNT
+               ? 0
+               : 1;
+}
+#endif
@@ -0,0 +1,70 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares filtering a column of enums by decoding each row against a tiny::enum_bitmap_index.
+
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/enum_bitmap_index.hpp>
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 20;
+constexpr std::size_t repetitions = 20;
+
+enum class state
+{
+    a,
+    b,
+    c,
+    d,
+    e,
+    f,
+
+    unsigned_count_,
+};
+
+state state_of(std::size_t row)
+{
+    // cheap pseudo random distribution
+    return state((row * 2654435761u >> 7) % 6u);
+}
+} // namespace
+
+int main()
+{
+    std::vector<tiny::tiny_storage<tiny::tiny_enum<state>>> column;
+    tiny::enum_bitmap_index<state>                          index;
+    column.reserve(size);
+    index.reserve(size);
+    for (auto i = 0u; i != size; ++i)
+    {
+        column.emplace_back(state_of(i));
+        index.push_back(state_of(i));
+    }
+
+    auto decode = benchmark::measure(size, repetitions, [&] {
+        std::size_t count = 0;
+        for (auto& row : column)
+        {
+            auto value = row.at<0>();
+            count += value == state::a || value == state::c;
+        }
+        benchmark::do_not_optimize(count);
+    });
+    benchmark::print_result("decode column: count state IN (a, c)", decode);
+
+    auto bitmap = benchmark::measure(size, repetitions, [&] {
+        auto count = index.count(state::a, state::c);
+        benchmark::do_not_optimize(count);
+    });
+    benchmark::print_result("enum_bitmap_index: count state IN (a, c)", bitmap);
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares a tiny::hamt_map against a std::unordered_map:
+// lookups, building the map by insertion,
+// and updating a key while keeping a snapshot of the previous version,
+// which requires a full copy for the std::unordered_map.
+
+#include <cstdint>
+#include <unordered_map>
+
+#include <foonathan/tiny/hamt_map.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 14;
+constexpr std::size_t lookups     = 1u << 20;
+constexpr std::size_t updates     = 1u << 8;
+constexpr std::size_t repetitions = 10;
+
+struct key_hash
+{
+    std::size_t operator()(std::uint32_t key) const
+    {
+        return std::size_t(key * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+using tiny_map_t = tiny::hamt_map<std::uint32_t, std::uint32_t, key_hash>;
+using std_map_t  = std::unordered_map<std::uint32_t, std::uint32_t, key_hash>;
+} // namespace
+
+int main()
+{
+    tiny_map_t tiny_map;
+    std_map_t  std_map;
+    for (auto i = 0u; i != size; ++i)
+    {
+        tiny_map = tiny_map.set(i, i);
+        std_map.emplace(i, i);
+    }
+
+    auto tiny_lookup = benchmark::measure(lookups, repetitions, [&] {
+        std::uint32_t sum = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            sum += *tiny_map.find(i % size);
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("hamt_map: lookup", tiny_lookup);
+
+    auto std_lookup = benchmark::measure(lookups, repetitions, [&] {
+        std::uint32_t sum = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            sum += std_map.find(i % size)->second;
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("std::unordered_map: lookup", std_lookup);
+
+    auto tiny_insert = benchmark::measure(size, repetitions, [&] {
+        tiny_map_t map;
+        for (auto i = 0u; i != size; ++i)
+            map = map.set(i, i);
+        benchmark::do_not_optimize(map.size());
+    });
+    benchmark::print_result("hamt_map: insert", tiny_insert);
+
+    auto std_insert = benchmark::measure(size, repetitions, [&] {
+        std_map_t map;
+        for (auto i = 0u; i != size; ++i)
+            map.emplace(i, i);
+        benchmark::do_not_optimize(map.size());
+    });
+    benchmark::print_result("std::unordered_map: insert", std_insert);
+
+    auto tiny_snapshot = benchmark::measure(updates, repetitions, [&] {
+        auto cur = tiny_map;
+        for (auto i = 0u; i != updates; ++i)
+        {
+            auto snapshot = cur;
+            cur           = snapshot.set(i, i + 1u);
+            benchmark::do_not_optimize(snapshot.size());
+        }
+    });
+    benchmark::print_result("hamt_map: snapshot + update", tiny_snapshot);
+
+    auto std_snapshot = benchmark::measure(updates, repetitions, [&] {
+        auto cur = std_map;
+        for (auto i = 0u; i != updates; ++i)
+        {
+            auto snapshot = cur;
+            cur[i]        = i + 1u;
+            benchmark::do_not_optimize(snapshot.size());
+        }
+    });
+    benchmark::print_result("std::unordered_map: snapshot + update", std_snapshot);
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares the throughput of tiny::mpmc_queue against a std::queue protected by a std::mutex,
+// with 1 to 64 threads, half of them producers and half of them consumers.
+// The results depend a lot on the number of cores,
+// with more threads than cores it mostly measures the scheduler.
+
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <foonathan/tiny/mpmc_queue.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t items       = 1u << 18;
+constexpr std::size_t capacity    = 1u << 10;
+constexpr std::size_t repetitions = 3;
+
+class mutex_queue
+{
+public:
+    bool try_push(std::uint64_t value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() == capacity)
+            return false;
+        queue_.push(value);
+        return true;
+    }
+
+    bool try_pop(std::uint64_t& result)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+            return false;
+        result = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::mutex                mutex_;
+    std::queue<std::uint64_t> queue_;
+};
+
+// pushes and pops all items
+template <class Queue>
+void run(Queue& queue, std::size_t thread_count)
+{
+    if (thread_count == 1u)
+    {
+        // a single thread alternates between filling and emptying the queue
+        std::uint64_t sum = 0, value;
+        for (auto i = 0u; i != items; i += capacity)
+        {
+            for (auto j = 0u; j != capacity; ++j)
+                queue.try_push(i + j);
+            while (queue.try_pop(value))
+                sum += value;
+        }
+        benchmark::do_not_optimize(sum);
+        return;
+    }
+
+    auto                     pairs = thread_count / 2u;
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t != pairs; ++t)
+        threads.emplace_back([&] {
+            for (auto i = 0u; i != items / pairs; ++i)
+                while (!queue.try_push(i))
+                    std::this_thread::yield();
+        });
+    for (auto t = 0u; t != pairs; ++t)
+        threads.emplace_back([&] {
+            std::uint64_t sum = 0, value;
+            for (auto i = 0u; i != items / pairs; ++i)
+            {
+                while (!queue.try_pop(value))
+                    std::this_thread::yield();
+                sum += value;
+            }
+            benchmark::do_not_optimize(sum);
+        });
+    for (auto& thread : threads)
+        thread.join();
+}
+} // namespace
+
+int main()
+{
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    for (auto threads = 1u; threads <= 64u; threads *= 2u)
+    {
+        char name[64];
+
+        auto tiny_time = benchmark::measure(items, repetitions, [&] {
+            tiny::mpmc_queue<std::uint64_t> queue(capacity);
+            run(queue, threads);
+        });
+        std::snprintf(name, sizeof(name), "mpmc_queue: %u threads", threads);
+        benchmark::print_result(name, tiny_time);
+
+        auto mutex_time = benchmark::measure(items, repetitions, [&] {
+            mutex_queue queue;
+            run(queue, threads);
+        });
+        std::snprintf(name, sizeof(name), "std::queue + std::mutex: %u threads", threads);
+        benchmark::print_result(name, mutex_time);
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares emptying an array of tiny::optional_impl one by one against tiny::fill_empty().
+
+#include <memory>
+#include <new>
+
+#include <foonathan/tiny/optional_impl.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 20;
+constexpr std::size_t repetitions = 20;
+
+enum class state : std::uint8_t
+{
+    a,
+    b,
+    c,
+    unsigned_count_,
+};
+
+template <typename T>
+void run(const char* name_loop, const char* name_bulk)
+{
+    std::unique_ptr<tiny::optional_impl<T>[]> array(new tiny::optional_impl<T>[size]);
+
+    auto loop = benchmark::measure(size, repetitions, [&] {
+        for (auto i = 0u; i != size; ++i)
+            ::new (static_cast<void*>(&array[i])) tiny::optional_impl<T>();
+        benchmark::do_not_optimize(array[size / 2]);
+    });
+    benchmark::print_result(name_loop, loop);
+
+    auto bulk = benchmark::measure(size, repetitions, [&] {
+        tiny::fill_empty(array.get(), array.get() + size);
+        benchmark::do_not_optimize(array[size / 2]);
+    });
+    benchmark::print_result(name_bulk, bulk);
+}
+} // namespace
+
+int main()
+{
+    run<int*>("optional_impl<int*>: construct each", "optional_impl<int*>: fill_empty");
+    run<state>("optional_impl<enum>: construct each", "optional_impl<enum>: fill_empty");
+    run<bool>("optional_impl<bool>: construct each", "optional_impl<bool>: fill_empty");
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares range predicates on a tiny::packed_column by decoding each object against the kernels.
+
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/packed_column.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 22;
+constexpr std::size_t repetitions = 20;
+
+template <class TinyType>
+void run(const char* decode_name, const char* kernel_name, const char* sum_name)
+{
+    tiny::packed_column<TinyType> column;
+    column.reserve(size);
+    for (auto i = 0u; i != size; ++i)
+    {
+        auto value = (i * 2654435761u >> 7) % (1u << TinyType::bit_size());
+        column.push_back(static_cast<typename TinyType::object_type>(value));
+    }
+
+    auto range = tiny::in_range(3, 12);
+
+    auto decode = benchmark::measure(size, repetitions, [&] {
+        std::size_t count = 0;
+        for (auto i = 0u; i != column.size(); ++i)
+        {
+            auto value = std::intmax_t(column[i]);
+            count += range.lower <= value && value < range.upper;
+        }
+        benchmark::do_not_optimize(count);
+    });
+    benchmark::print_result(decode_name, decode);
+
+    auto kernel = benchmark::measure(size, repetitions, [&] {
+        auto count = tiny::count_if(column, range);
+        benchmark::do_not_optimize(count);
+    });
+    benchmark::print_result(kernel_name, kernel);
+
+    auto sum = benchmark::measure(size, repetitions, [&] {
+        auto result = tiny::sum(column);
+        benchmark::do_not_optimize(result);
+    });
+    benchmark::print_result(sum_name, sum);
+}
+} // namespace
+
+int main()
+{
+    run<tiny::tiny_unsigned<4>>("tiny_unsigned<4>: decode and compare",
+                                "tiny_unsigned<4>: count_if", "tiny_unsigned<4>: sum");
+    run<tiny::tiny_unsigned<8>>("tiny_unsigned<8>: decode and compare",
+                                "tiny_unsigned<8>: count_if", "tiny_unsigned<8>: sum");
+}
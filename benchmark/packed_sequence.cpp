@@ -0,0 +1,94 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares size and decoding speed of tiny::packed_sequence against delta + varint encoding.
+
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/packed_sequence.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 20;
+constexpr std::size_t repetitions = 20;
+
+std::vector<unsigned char> encode_varint(const std::vector<std::uint64_t>& values)
+{
+    std::vector<unsigned char> result;
+    std::uint64_t              prev = 0;
+    for (auto value : values)
+    {
+        auto delta = value - prev;
+        prev       = value;
+        while (delta >= 0x80u)
+        {
+            result.push_back(static_cast<unsigned char>(delta | 0x80u));
+            delta >>= 7;
+        }
+        result.push_back(static_cast<unsigned char>(delta));
+    }
+    return result;
+}
+} // namespace
+
+int main()
+{
+    // sorted timestamps with small gaps
+    std::vector<std::uint64_t> values;
+    values.reserve(size);
+    auto timestamp = std::uint64_t(1) << 40;
+    for (auto i = 0u; i != size; ++i)
+    {
+        timestamp += (i * 2654435761u >> 7) % 200u;
+        values.push_back(timestamp);
+    }
+
+    tiny::packed_sequence<std::uint64_t> seq(values.begin(), values.end());
+    auto                                 varint = encode_varint(values);
+    std::printf("bytes: raw %zu, varint %zu, packed_sequence %zu\n",
+                values.size() * sizeof(std::uint64_t), varint.size(), seq.memory_usage());
+
+    std::vector<std::uint64_t> out(size + tiny::packed_sequence<std::uint64_t>::block_size);
+
+    auto varint_time = benchmark::measure(size, repetitions, [&] {
+        std::uint64_t prev = 0;
+        auto          ptr  = varint.data();
+        for (auto i = 0u; i != size; ++i)
+        {
+            std::uint64_t delta = 0;
+            auto          shift = 0u;
+            while (*ptr & 0x80u)
+            {
+                delta |= std::uint64_t(*ptr++ & 0x7Fu) << shift;
+                shift += 7u;
+            }
+            delta |= std::uint64_t(*ptr++) << shift;
+            prev += delta;
+            out[i] = prev;
+        }
+        benchmark::do_not_optimize(out);
+    });
+    benchmark::print_result("varint: decode", varint_time);
+
+    auto block_time = benchmark::measure(size, repetitions, [&] {
+        auto ptr = out.data();
+        for (auto b = 0u; b != seq.block_count(); ++b)
+            ptr += seq.decode_block(b, ptr);
+        benchmark::do_not_optimize(out);
+    });
+    benchmark::print_result("packed_sequence: decode_block", block_time);
+
+    auto random_time = benchmark::measure(size, repetitions, [&] {
+        std::uint64_t sum = 0;
+        for (auto i = 0u; i != size; ++i)
+            sum += seq[(i * 2654435761u) % size];
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result("packed_sequence: random access", random_time);
+}
@@ -0,0 +1,121 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares hashing and comparing a padded key member-wise against the padding aware functions.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <foonathan/tiny/padding_aware.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 16;
+constexpr std::size_t repetitions = 200;
+
+struct key
+{
+    std::uint8_t  a;
+    std::uint32_t b;
+    std::uint64_t c;
+    std::uint16_t d;
+};
+
+struct member_hash
+{
+    std::size_t operator()(const key& k) const noexcept
+    {
+        // same mixing as the padding aware hash, but one step per member
+        std::uint64_t result = sizeof(key);
+        result               = tiny::detail::mix_hash_word(result, k.a);
+        result               = tiny::detail::mix_hash_word(result, k.b);
+        result               = tiny::detail::mix_hash_word(result, k.c);
+        result               = tiny::detail::mix_hash_word(result, k.d);
+        return static_cast<std::size_t>(tiny::detail::mix_hash_word(result, result >> 29));
+    }
+};
+
+struct memcmp_equal
+{
+    // only correct because the padding of the keys is zeroed
+    bool operator()(const key& lhs, const key& rhs) const noexcept
+    {
+        return std::memcmp(&lhs, &rhs, sizeof(key)) == 0;
+    }
+};
+
+struct member_equal
+{
+    bool operator()(const key& lhs, const key& rhs) const noexcept
+    {
+        return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c && lhs.d == rhs.d;
+    }
+};
+
+template <class Hash>
+double measure_hash(const std::vector<key>& keys)
+{
+    return benchmark::measure(keys.size(), repetitions, [&] {
+        std::size_t result = 0;
+        for (auto& k : keys)
+            result ^= Hash{}(k);
+        benchmark::do_not_optimize(result);
+    });
+}
+
+template <class Equal>
+double measure_equal(const std::vector<key>& lhs, const std::vector<key>& rhs)
+{
+    return benchmark::measure(lhs.size(), repetitions, [&] {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i != lhs.size(); ++i)
+            result += Equal{}(lhs[i], rhs[i]);
+        benchmark::do_not_optimize(result);
+    });
+}
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct padding_traits<key>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(key, a), FOONATHAN_TINY_MEMBER(key, b),
+                               FOONATHAN_TINY_MEMBER(key, c), FOONATHAN_TINY_MEMBER(key, d)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+int main()
+{
+    std::vector<key> lhs, rhs;
+    for (auto i = 0u; i != size; ++i)
+    {
+        auto value = std::uint64_t(i) * 2654435761u;
+        key k;
+        std::memset(&k, 0, sizeof(key));
+        k.a = std::uint8_t(value);
+        k.b = std::uint32_t(value >> 8);
+        k.c = value;
+        k.d = std::uint16_t(value >> 3);
+        lhs.push_back(k);
+        // every fourth key differs in the last member
+        rhs.push_back(lhs.back());
+        rhs.back().d = std::uint16_t(rhs.back().d + (i % 4u == 0u));
+    }
+
+    benchmark::print_result("member-wise hash", measure_hash<member_hash>(lhs));
+    benchmark::print_result("padding_aware_hash", measure_hash<tiny::padding_aware_hash<key>>(lhs));
+
+    benchmark::print_result("memcmp equal", measure_equal<memcmp_equal>(lhs, rhs));
+    benchmark::print_result("member-wise equal", measure_equal<member_equal>(lhs, rhs));
+    benchmark::print_result("padding_aware_equal",
+                            measure_equal<tiny::padding_aware_equal<key>>(lhs, rhs));
+}
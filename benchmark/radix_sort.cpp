@@ -0,0 +1,63 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares sorting tiny storages by two fields with std::sort against tiny::radix_sort.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/radix_sort.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 20;
+constexpr std::size_t repetitions = 5;
+
+using record = tiny::word_tiny_storage<tiny::tiny_unsigned<12>, tiny::tiny_unsigned<4>,
+                                       tiny::tiny_bool, tiny::tiny_unsigned<20>>;
+
+template <typename Fn>
+double measure_sort(const std::vector<record>& input, Fn sort)
+{
+    std::vector<record> records;
+    return benchmark::measure(input.size(), repetitions, [&] {
+        records = input;
+        sort(records);
+        benchmark::do_not_optimize(records);
+    });
+}
+} // namespace
+
+int main()
+{
+    std::vector<record> input;
+    input.reserve(size);
+    for (auto i = 0u; i != size; ++i)
+    {
+        auto random = i * 2654435761u;
+        input.emplace_back(random % 4096u, (random >> 12) % 16u, i % 3u == 0u, i % (1u << 20));
+    }
+
+    auto std_sort = measure_sort(input, [](std::vector<record>& records) {
+        std::stable_sort(records.begin(), records.end(), [](const record& a, const record& b) {
+            unsigned a_first = a.at<1>(), b_first = b.at<1>();
+            if (a_first != b_first)
+                return a_first < b_first;
+            return unsigned(a.at<0>()) < unsigned(b.at<0>());
+        });
+    });
+    benchmark::print_result("std::stable_sort: by (b, a)", std_sort);
+
+    auto radix = measure_sort(input, [](std::vector<record>& records) {
+        tiny::radix_sort<1, 0>(records.begin(), records.end());
+    });
+    benchmark::print_result("radix_sort: by (b, a)", radix);
+}
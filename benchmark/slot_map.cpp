@@ -0,0 +1,109 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares tiny::slot_map against a std::unordered_map with 64 bit IDs.
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <foonathan/tiny/slot_map.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 18;
+constexpr std::size_t repetitions = 10;
+
+struct entity
+{
+    float         position[3];
+    std::uint32_t flags;
+};
+
+// cheap pseudo random permutation of the indices
+std::size_t shuffled(std::size_t i)
+{
+    return (i * 2654435761u) % size;
+}
+} // namespace
+
+int main()
+{
+    using map = tiny::slot_map<entity>;
+
+    std::vector<map::handle> handles(size);
+    auto                     slot_insert = benchmark::measure(size, repetitions, [&] {
+        map m;
+        for (auto i = 0u; i != size; ++i)
+            handles[i] = m.insert(entity{{1.f, 2.f, 3.f}, i});
+        benchmark::do_not_optimize(m);
+    });
+    benchmark::print_result("slot_map: insert", slot_insert);
+
+    auto unordered_insert = benchmark::measure(size, repetitions, [&] {
+        std::unordered_map<std::uint64_t, entity> m;
+        for (auto i = 0u; i != size; ++i)
+            m.emplace(i, entity{{1.f, 2.f, 3.f}, i});
+        benchmark::do_not_optimize(m);
+    });
+    benchmark::print_result("unordered_map: insert", unordered_insert);
+
+    map                                       slots;
+    std::unordered_map<std::uint64_t, entity> unordered;
+    for (auto i = 0u; i != size; ++i)
+    {
+        handles[i] = slots.insert(entity{{1.f, 2.f, 3.f}, i});
+        unordered.emplace(i, entity{{1.f, 2.f, 3.f}, i});
+    }
+
+    auto slot_lookup = benchmark::measure(size, repetitions, [&] {
+        std::uint32_t result = 0;
+        for (auto i = 0u; i != size; ++i)
+            result += slots[handles[shuffled(i)]].flags;
+        benchmark::do_not_optimize(result);
+    });
+    benchmark::print_result("slot_map: random lookup", slot_lookup);
+
+    auto unordered_lookup = benchmark::measure(size, repetitions, [&] {
+        std::uint32_t result = 0;
+        for (auto i = 0u; i != size; ++i)
+            result += unordered.find(shuffled(i))->second.flags;
+        benchmark::do_not_optimize(result);
+    });
+    benchmark::print_result("unordered_map: random lookup", unordered_lookup);
+
+    auto slot_iterate = benchmark::measure(size, repetitions, [&] {
+        std::uint32_t result = 0;
+        for (auto& e : slots)
+            result += e.flags;
+        benchmark::do_not_optimize(result);
+    });
+    benchmark::print_result("slot_map: iterate", slot_iterate);
+
+    auto unordered_iterate = benchmark::measure(size, repetitions, [&] {
+        std::uint32_t result = 0;
+        for (auto& e : unordered)
+            result += e.second.flags;
+        benchmark::do_not_optimize(result);
+    });
+    benchmark::print_result("unordered_map: iterate", unordered_iterate);
+
+    auto slot_erase = benchmark::measure(size, 1, [&] {
+        for (auto i = 0u; i != size; ++i)
+            slots.erase(handles[shuffled(i)]);
+        benchmark::do_not_optimize(slots);
+    });
+    benchmark::print_result("slot_map: random erase", slot_erase);
+
+    auto unordered_erase = benchmark::measure(size, 1, [&] {
+        for (auto i = 0u; i != size; ++i)
+            unordered.erase(shuffled(i));
+        benchmark::do_not_optimize(unordered);
+    });
+    benchmark::print_result("unordered_map: random erase", unordered_erase);
+}
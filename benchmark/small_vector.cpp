@@ -0,0 +1,80 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares reallocating a std::vector against reallocating a tiny::small_vector,
+// which relocates trivially relocatable types using std::memcpy().
+
+#include <vector>
+
+#include <foonathan/tiny/small_vector.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 20;
+constexpr std::size_t repetitions = 20;
+
+// owns a resource, so moving needs to reset the old object
+struct resource
+{
+    int* ptr;
+
+    explicit resource(int* ptr) noexcept : ptr(ptr) {}
+    resource(resource&& other) noexcept : ptr(other.ptr)
+    {
+        other.ptr = nullptr;
+    }
+    resource& operator=(resource&& other) noexcept
+    {
+        delete ptr;
+        ptr       = other.ptr;
+        other.ptr = nullptr;
+        return *this;
+    }
+    ~resource() noexcept
+    {
+        delete ptr;
+    }
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct is_trivially_relocatable<resource> : std::true_type
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+namespace
+{
+template <class Vector>
+void run(const char* name)
+{
+    Vector vec;
+    for (auto i = 0u; i != size; ++i)
+        vec.emplace_back(nullptr);
+
+    // every reserve moves all objects into new memory
+    auto time = benchmark::measure(size, repetitions, [&] {
+        vec.reserve(vec.capacity() + 1u);
+        benchmark::do_not_optimize(vec[size / 2]);
+    });
+    benchmark::print_result(name, time);
+}
+} // namespace
+
+int main()
+{
+    run<std::vector<int*>>("std::vector<int*>: reallocate");
+    run<tiny::small_vector<int*>>("small_vector<int*>: reallocate");
+
+    run<std::vector<resource>>("std::vector<resource>: reallocate");
+    run<tiny::small_vector<resource>>("small_vector<resource>: reallocate");
+}
@@ -0,0 +1,117 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares lookups in a tiny::tagged_union_hash_set against a std::unordered_set,
+// both for keys that are in the set and keys that are not.
+
+#include <cstdint>
+#include <unordered_set>
+
+#include <foonathan/tiny/tagged_union_hash_set.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 16;
+constexpr std::size_t lookups     = 1u << 20;
+constexpr std::size_t repetitions = 10;
+
+using types = tiny::union_types<struct key_entry, struct other_entry>;
+
+struct key_entry
+{
+    tiny::tagged_union_tag<types> tag;
+    std::uint32_t                 key;
+
+    explicit key_entry(std::uint32_t key) : key(key) {}
+
+    friend bool operator==(const key_entry& lhs, const key_entry& rhs)
+    {
+        return lhs.key == rhs.key;
+    }
+};
+
+struct other_entry
+{
+    tiny::tagged_union_tag<types> tag;
+    double                        value;
+
+    friend bool operator==(const other_entry& lhs, const other_entry& rhs)
+    {
+        return lhs.value == rhs.value;
+    }
+};
+
+std::size_t hash_key(std::uint32_t key)
+{
+    return std::size_t(key * 0x9E3779B97F4A7C15ull);
+}
+
+struct entry_hash
+{
+    std::size_t operator()(const key_entry& entry) const
+    {
+        return hash_key(entry.key);
+    }
+    std::size_t operator()(const other_entry&) const
+    {
+        return 0u;
+    }
+};
+
+struct key_hash
+{
+    std::size_t operator()(std::uint32_t key) const
+    {
+        return hash_key(key);
+    }
+};
+} // namespace
+
+int main()
+{
+    tiny::tagged_union_hash_set<types, entry_hash> tiny_set;
+    std::unordered_set<std::uint32_t, key_hash>    std_set;
+    for (auto i = 0u; i != size; ++i)
+    {
+        // only even keys are in the set
+        tiny_set.insert(key_entry(2u * i));
+        std_set.insert(2u * i);
+    }
+
+    auto tiny_hit = benchmark::measure(lookups, repetitions, [&] {
+        std::size_t found = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            found += tiny_set.contains(key_entry(2u * (i % size)));
+        benchmark::do_not_optimize(found);
+    });
+    benchmark::print_result("tagged_union_hash_set: hit", tiny_hit);
+
+    auto std_hit = benchmark::measure(lookups, repetitions, [&] {
+        std::size_t found = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            found += std_set.count(2u * (i % size));
+        benchmark::do_not_optimize(found);
+    });
+    benchmark::print_result("std::unordered_set: hit", std_hit);
+
+    auto tiny_miss = benchmark::measure(lookups, repetitions, [&] {
+        std::size_t found = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            found += tiny_set.contains(key_entry(2u * (i % size) + 1u));
+        benchmark::do_not_optimize(found);
+    });
+    benchmark::print_result("tagged_union_hash_set: miss", tiny_miss);
+
+    auto std_miss = benchmark::measure(lookups, repetitions, [&] {
+        std::size_t found = 0;
+        for (auto i = 0u; i != lookups; ++i)
+            found += std_set.count(2u * (i % size) + 1u);
+        benchmark::do_not_optimize(found);
+    });
+    benchmark::print_result("std::unordered_set: miss", std_miss);
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Compares field access of tiny::tiny_storage and tiny::word_tiny_storage.
+
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+#include "benchmark.hpp"
+
+namespace tiny = foonathan::tiny;
+
+namespace
+{
+constexpr std::size_t size        = 1u << 16;
+constexpr std::size_t repetitions = 50;
+
+// the 20 bit field starts at bit 5, so it spans three bytes
+template <template <class...> class Storage>
+using storage_t = Storage<tiny::tiny_unsigned<5>, tiny::tiny_unsigned<20>, tiny::tiny_bool>;
+
+template <template <class...> class Storage>
+void run(const char* read_name, const char* write_name)
+{
+    std::vector<storage_t<Storage>> storages(size);
+    for (auto i = 0u; i != size; ++i)
+        storages[i] = storage_t<Storage>(i % 32, i, i % 2 == 0);
+
+    auto read = benchmark::measure(size, repetitions, [&] {
+        std::uint64_t sum = 0;
+        for (auto& s : storages)
+            sum += s.template at<1>();
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::print_result(read_name, read);
+
+    auto write = benchmark::measure(size, repetitions, [&] {
+        auto i = 0u;
+        for (auto& s : storages)
+            s.template at<1>() = i++;
+        benchmark::do_not_optimize(storages);
+    });
+    benchmark::print_result(write_name, write);
+}
+} // namespace
+
+int main()
+{
+    run<tiny::tiny_storage>("tiny_storage: read 20 bit field", "tiny_storage: write 20 bit field");
+    run<tiny::word_tiny_storage>("word_tiny_storage: read 20 bit field",
+                                 "word_tiny_storage: write 20 bit field");
+}
@@ -0,0 +1,815 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_ART_MAP_HPP_INCLUDED
+#define FOONATHAN_TINY_ART_MAP_HPP_INCLUDED
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/pointer_variant_impl.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace art_detail
+    {
+        // all nodes are aligned, so the pointer has three bits to store the kind
+        constexpr std::size_t node_alignment = 8u;
+
+        // the byte of the key at the given depth, starting with the most significant one
+        template <typename Key>
+        std::uint8_t key_byte(Key key, std::size_t depth) noexcept
+        {
+            // no integer promotion to int
+            using integer = typename std::common_type<Key, unsigned>::type;
+            auto shift = CHAR_BIT * (sizeof(Key) - 1u - depth);
+            return static_cast<std::uint8_t>(integer(key) >> shift);
+        }
+
+        template <typename Key, typename Value>
+        struct alignas(node_alignment) leaf
+        {
+            Key   key;
+            Value value;
+
+            leaf(Key key, Value value) : key(key), value(std::move(value)) {}
+        };
+
+        template <typename Key, typename Value, std::size_t Capacity>
+        struct sorted_node;
+        template <typename Key, typename Value>
+        struct indexed_node;
+        template <typename Key, typename Value>
+        struct direct_node;
+
+        template <typename Key, typename Value>
+        using node4 = sorted_node<Key, Value, 4>;
+        template <typename Key, typename Value>
+        using node16 = sorted_node<Key, Value, 16>;
+        template <typename Key, typename Value>
+        using node48 = indexed_node<Key, Value>;
+        template <typename Key, typename Value>
+        using node256 = direct_node<Key, Value>;
+
+        // same order as the types of the pointer variant
+        enum class node_kind : std::size_t
+        {
+            leaf,
+            node4,
+            node16,
+            node48,
+            node256,
+        };
+
+        // a non-owning pointer to a leaf or one of the inner nodes
+        template <typename Key, typename Value>
+        class node_ptr
+        {
+            // aligned_obj, as the nodes contain node_ptr and are thus incomplete here
+            using ptr_type = pointer_variant_impl<aligned_obj<leaf<Key, Value>, node_alignment>,
+                                                  aligned_obj<node4<Key, Value>, node_alignment>,
+                                                  aligned_obj<node16<Key, Value>, node_alignment>,
+                                                  aligned_obj<node48<Key, Value>, node_alignment>,
+                                                  aligned_obj<node256<Key, Value>, node_alignment>>;
+
+        public:
+            node_ptr() noexcept : ptr_(nullptr) {}
+
+            template <typename T>
+            explicit node_ptr(T* ptr) noexcept : ptr_(ptr)
+            {}
+
+            explicit operator bool() const noexcept
+            {
+                return ptr_.has_value();
+            }
+
+            node_kind kind() const noexcept
+            {
+                return static_cast<node_kind>(ptr_.tag());
+            }
+
+            bool is_leaf() const noexcept
+            {
+                return kind() == node_kind::leaf;
+            }
+
+            template <typename T>
+            T* get() const noexcept
+            {
+                return ptr_.template pointer_to<T>();
+            }
+
+        private:
+            ptr_type ptr_;
+        };
+
+        // the metadata shared by all inner nodes
+        template <typename Key>
+        class node_header
+        {
+        public:
+            std::size_t count() const noexcept
+            {
+                return metadata_.template at<0>();
+            }
+
+            void set_count(std::size_t count) noexcept
+            {
+                metadata_.template at<0>() = static_cast<std::uint16_t>(count);
+            }
+
+            // the bytes of the key skipped by the node, as they're the same for all children
+            std::size_t prefix_length() const noexcept
+            {
+                return metadata_.template at<1>();
+            }
+
+            std::uint8_t prefix(std::size_t i) const noexcept
+            {
+                return prefix_[i];
+            }
+
+            void set_prefix(Key key, std::size_t depth, std::size_t length) noexcept
+            {
+                for (std::size_t i = 0; i != length; ++i)
+                    prefix_[i] = key_byte(key, depth + i);
+                set_prefix_length(length);
+            }
+
+            void remove_prefix(std::size_t n) noexcept
+            {
+                std::memmove(prefix_, prefix_ + n, prefix_length() - n);
+                set_prefix_length(prefix_length() - n);
+            }
+
+            // prefix = parent prefix + byte + prefix
+            void prepend_prefix(const node_header& parent, std::uint8_t byte) noexcept
+            {
+                auto offset = parent.prefix_length() + 1u;
+                std::memmove(prefix_ + offset, prefix_, prefix_length());
+                std::memcpy(prefix_, parent.prefix_, parent.prefix_length());
+                prefix_[offset - 1u] = byte;
+                set_prefix_length(prefix_length() + offset);
+            }
+
+            // the index of the first byte of the prefix that doesn't match the key
+            std::size_t mismatch(Key key, std::size_t depth) const noexcept
+            {
+                for (std::size_t i = 0; i != prefix_length(); ++i)
+                    if (prefix_[i] != key_byte(key, depth + i))
+                        return i;
+                return prefix_length();
+            }
+
+            void copy_header(const node_header& other) noexcept
+            {
+                *this = other;
+                set_count(0u);
+            }
+
+        private:
+            void set_prefix_length(std::size_t length) noexcept
+            {
+                DEBUG_ASSERT(length < sizeof(Key), detail::assert_handler{});
+                metadata_.template at<1>() = static_cast<std::uint8_t>(length);
+            }
+
+            // up to 256 children and a prefix shorter than the key
+            tiny_storage<tiny_unsigned<9, std::uint16_t>, tiny_unsigned<4, std::uint8_t>>
+                         metadata_;
+            std::uint8_t prefix_[sizeof(Key)];
+        };
+
+        // node4 and node16: the bytes are sorted and searched linearly
+        template <typename Key, typename Value, std::size_t Capacity>
+        struct alignas(node_alignment) sorted_node : node_header<Key>
+        {
+            static constexpr std::size_t capacity = Capacity;
+
+            std::uint8_t          bytes[Capacity];
+            node_ptr<Key, Value> children[Capacity];
+
+            node_ptr<Key, Value>* find(std::uint8_t byte) noexcept
+            {
+                for (std::size_t i = 0; i != this->count() && bytes[i] <= byte; ++i)
+                    if (bytes[i] == byte)
+                        return &children[i];
+                return nullptr;
+            }
+
+            void add(std::uint8_t byte, node_ptr<Key, Value> child) noexcept
+            {
+                DEBUG_ASSERT(this->count() < Capacity, detail::assert_handler{});
+                auto i = this->count();
+                for (; i != 0u && bytes[i - 1u] > byte; --i)
+                {
+                    bytes[i]    = bytes[i - 1u];
+                    children[i] = children[i - 1u];
+                }
+                bytes[i]    = byte;
+                children[i] = child;
+                this->set_count(this->count() + 1u);
+            }
+
+            void remove(std::uint8_t byte) noexcept
+            {
+                auto i = std::size_t(0);
+                while (bytes[i] != byte)
+                    ++i;
+                for (; i + 1u != this->count(); ++i)
+                {
+                    bytes[i]    = bytes[i + 1u];
+                    children[i] = children[i + 1u];
+                }
+                this->set_count(this->count() - 1u);
+            }
+
+            template <typename Fn>
+            void for_each(Fn& f) const
+            {
+                for (std::size_t i = 0; i != this->count(); ++i)
+                    f(bytes[i], children[i]);
+            }
+        };
+
+        // node48: a byte indexes into the array of children
+        template <typename Key, typename Value>
+        struct alignas(node_alignment) indexed_node : node_header<Key>
+        {
+            static constexpr std::size_t capacity = 48u;
+
+            // zero if there is no child, otherwise the index of the child plus one
+            std::uint8_t          indices[256];
+            node_ptr<Key, Value> children[capacity];
+
+            indexed_node() noexcept : indices() {}
+
+            node_ptr<Key, Value>* find(std::uint8_t byte) noexcept
+            {
+                auto index = indices[byte];
+                return index == 0u ? nullptr : &children[index - 1u];
+            }
+
+            void add(std::uint8_t byte, node_ptr<Key, Value> child) noexcept
+            {
+                DEBUG_ASSERT(this->count() < capacity, detail::assert_handler{});
+                // the erased children leave holes
+                auto index = std::size_t(0);
+                while (children[index])
+                    ++index;
+                children[index] = child;
+                indices[byte]   = static_cast<std::uint8_t>(index + 1u);
+                this->set_count(this->count() + 1u);
+            }
+
+            void remove(std::uint8_t byte) noexcept
+            {
+                children[indices[byte] - 1u] = node_ptr<Key, Value>();
+                indices[byte]                = 0u;
+                this->set_count(this->count() - 1u);
+            }
+
+            template <typename Fn>
+            void for_each(Fn& f) const
+            {
+                for (std::size_t byte = 0; byte != 256u; ++byte)
+                    if (indices[byte] != 0u)
+                        f(static_cast<std::uint8_t>(byte), children[indices[byte] - 1u]);
+            }
+        };
+
+        // node256: a byte is the index of the child
+        template <typename Key, typename Value>
+        struct alignas(node_alignment) direct_node : node_header<Key>
+        {
+            static constexpr std::size_t capacity = 256u;
+
+            node_ptr<Key, Value> children[capacity];
+
+            node_ptr<Key, Value>* find(std::uint8_t byte) noexcept
+            {
+                return children[byte] ? &children[byte] : nullptr;
+            }
+
+            void add(std::uint8_t byte, node_ptr<Key, Value> child) noexcept
+            {
+                children[byte] = child;
+                this->set_count(this->count() + 1u);
+            }
+
+            void remove(std::uint8_t byte) noexcept
+            {
+                children[byte] = node_ptr<Key, Value>();
+                this->set_count(this->count() - 1u);
+            }
+
+            template <typename Fn>
+            void for_each(Fn& f) const
+            {
+                for (std::size_t byte = 0; byte != capacity; ++byte)
+                    if (children[byte])
+                        f(static_cast<std::uint8_t>(byte), children[byte]);
+            }
+        };
+    } // namespace art_detail
+
+    /// An ordered map from unsigned integers implemented as an adaptive radix tree (ART).
+    ///
+    /// Every inner node selects its child by one byte of the key, starting with the most
+    /// significant one, so iterating the tree visits the keys in ascending order.
+    /// Depending on the number of children, an inner node has one of four kinds:
+    /// a node with up to 4 or 16 children stores the bytes in a sorted array,
+    /// one with up to 48 children stores an index for every byte and one with up to 256 children
+    /// stores a child for every byte.
+    /// A node grows into the next bigger kind when it is full and shrinks once it is mostly empty.
+    /// Bytes that are the same for all children are skipped by the node and stored as its prefix,
+    /// a subtree with a single key is just a leaf.
+    ///
+    /// The kind of a child is stored in the alignment bits of the pointer to it using a
+    /// [tiny::pointer_variant_impl](),
+    /// so every child is one pointer and nodes don't need to store their own kind.
+    /// The number of children and the length of the prefix of a node are stored in a
+    /// [tiny::tiny_storage]() of two bytes.
+    ///
+    /// \requires `Key` must be an unsigned integer type.
+    template <typename Key, typename Value>
+    class art_map
+    {
+        static_assert(std::is_unsigned<Key>::value, "keys must be unsigned integers");
+        static_assert(sizeof(Key) <= 16u, "prefix length does not fit into the node");
+
+        using node_kind = art_detail::node_kind;
+        using node_ptr  = art_detail::node_ptr<Key, Value>;
+        using header    = art_detail::node_header<Key>;
+        using leaf      = art_detail::leaf<Key, Value>;
+        using node4     = art_detail::node4<Key, Value>;
+        using node16    = art_detail::node16<Key, Value>;
+        using node48    = art_detail::node48<Key, Value>;
+        using node256   = art_detail::node256<Key, Value>;
+
+    public:
+        using key_type    = Key;
+        using mapped_type = Value;
+
+        //=== constructors ===//
+        /// \effects Creates an empty map.
+        art_map() noexcept : size_(0) {}
+
+        art_map(const art_map&) = delete;
+        art_map& operator=(const art_map&) = delete;
+
+        /// \effects Takes over the nodes of `other`, leaving it empty.
+        art_map(art_map&& other) noexcept : root_(other.root_), size_(other.size_)
+        {
+            other.root_ = node_ptr();
+            other.size_ = 0;
+        }
+
+        /// \effects Destroys all keys and values and takes over the nodes of `other`,
+        /// leaving it empty.
+        art_map& operator=(art_map&& other) noexcept
+        {
+            art_map tmp(std::move(other));
+            std::swap(root_, tmp.root_);
+            std::swap(size_, tmp.size_);
+            return *this;
+        }
+
+        /// \effects Destroys all keys and values.
+        ~art_map() noexcept
+        {
+            clear();
+        }
+
+        //=== accessors ===//
+        /// \returns The number of keys.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no keys.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns A pointer to the value of the key, or `nullptr` if there is none.
+        /// \group find
+        Value* find(Key key) noexcept
+        {
+            auto depth = std::size_t(0);
+            auto node  = root_;
+            while (node && !node.is_leaf())
+            {
+                auto& h = header_of(node);
+                if (h.mismatch(key, depth) != h.prefix_length())
+                    return nullptr;
+                depth += h.prefix_length();
+
+                auto child = find_child(node, art_detail::key_byte(key, depth));
+                if (!child)
+                    return nullptr;
+                node = *child;
+                ++depth;
+            }
+
+            if (!node || node.template get<leaf>()->key != key)
+                return nullptr;
+            return &node.template get<leaf>()->value;
+        }
+        /// \group find
+        const Value* find(Key key) const noexcept
+        {
+            return const_cast<art_map&>(*this).find(key);
+        }
+
+        /// \returns Whether or not the map contains the key.
+        bool contains(Key key) const noexcept
+        {
+            return find(key) != nullptr;
+        }
+
+        /// \effects Calls `f(key, value)` for every key in ascending order.
+        template <typename Fn>
+        void for_each(Fn f) const
+        {
+            if (root_)
+                for_each(root_, f);
+        }
+
+        /// \returns The number of bytes allocated for the nodes and leaves.
+        /// \notes It has to visit every node.
+        std::size_t memory_usage() const noexcept
+        {
+            return root_ ? memory_usage(root_) : 0u;
+        }
+
+        //=== modifiers ===//
+        /// \effects Inserts the key with the value, if the key is not already in the map.
+        /// \returns A pointer to the value of the key, and whether or not it has been inserted.
+        std::pair<Value*, bool> insert(Key key, Value value)
+        {
+            auto depth = std::size_t(0);
+            auto slot  = &root_;
+            while (*slot && !slot->is_leaf())
+            {
+                auto& h        = header_of(*slot);
+                auto  mismatch = h.mismatch(key, depth);
+                if (mismatch != h.prefix_length())
+                {
+                    // the key differs in the prefix, so split it
+                    std::unique_ptr<leaf> new_leaf(new leaf(key, std::move(value)));
+                    auto                  node = new node4;
+                    node->set_prefix(key, depth, mismatch);
+                    node->add(h.prefix(mismatch), *slot);
+                    node->add(art_detail::key_byte(key, depth + mismatch),
+                              node_ptr(new_leaf.get()));
+                    h.remove_prefix(mismatch + 1u);
+
+                    *slot = node_ptr(node);
+                    return inserted(new_leaf.release());
+                }
+                depth += h.prefix_length();
+
+                auto byte  = art_detail::key_byte(key, depth);
+                auto child = find_child(*slot, byte);
+                if (!child)
+                {
+                    std::unique_ptr<leaf> new_leaf(new leaf(key, std::move(value)));
+                    add_child(*slot, byte, node_ptr(new_leaf.get()));
+                    return inserted(new_leaf.release());
+                }
+                slot = child;
+                ++depth;
+            }
+
+            if (!*slot)
+            {
+                auto new_leaf = new leaf(key, std::move(value));
+                *slot         = node_ptr(new_leaf);
+                return inserted(new_leaf);
+            }
+
+            auto existing = slot->template get<leaf>();
+            if (existing->key == key)
+                return std::make_pair(&existing->value, false);
+
+            // replace the leaf by a node containing both
+            std::unique_ptr<leaf> new_leaf(new leaf(key, std::move(value)));
+            auto                  end = depth;
+            while (art_detail::key_byte(existing->key, end) == art_detail::key_byte(key, end))
+                ++end;
+
+            auto node = new node4;
+            node->set_prefix(key, depth, end - depth);
+            node->add(art_detail::key_byte(existing->key, end), *slot);
+            node->add(art_detail::key_byte(key, end), node_ptr(new_leaf.get()));
+
+            *slot = node_ptr(node);
+            return inserted(new_leaf.release());
+        }
+
+        /// \effects Erases the key, if it is in the map.
+        /// \returns Whether or not the key has been erased.
+        bool erase(Key key) noexcept
+        {
+            if (!root_)
+                return false;
+            else if (root_.is_leaf())
+            {
+                if (root_.template get<leaf>()->key != key)
+                    return false;
+                delete root_.template get<leaf>();
+                root_ = node_ptr();
+                --size_;
+                return true;
+            }
+
+            auto depth = std::size_t(0);
+            auto slot  = &root_;
+            while (true)
+            {
+                auto& h = header_of(*slot);
+                if (h.mismatch(key, depth) != h.prefix_length())
+                    return false;
+                depth += h.prefix_length();
+
+                auto byte  = art_detail::key_byte(key, depth);
+                auto child = find_child(*slot, byte);
+                if (!child)
+                    return false;
+                else if (!child->is_leaf())
+                {
+                    slot = child;
+                    ++depth;
+                    continue;
+                }
+
+                auto l = child->template get<leaf>();
+                if (l->key != key)
+                    return false;
+                delete l;
+                remove_child(*slot, byte);
+                --size_;
+                return true;
+            }
+        }
+
+        /// \effects Erases all keys.
+        void clear() noexcept
+        {
+            if (root_)
+                destroy(root_);
+            root_ = node_ptr();
+            size_ = 0;
+        }
+
+    private:
+        std::pair<Value*, bool> inserted(leaf* new_leaf) noexcept
+        {
+            ++size_;
+            return std::make_pair(&new_leaf->value, true);
+        }
+
+        static header& header_of(node_ptr node) noexcept
+        {
+            switch (node.kind())
+            {
+            case node_kind::node4:
+                return *node.template get<node4>();
+            case node_kind::node16:
+                return *node.template get<node16>();
+            case node_kind::node48:
+                return *node.template get<node48>();
+            case node_kind::leaf:
+            case node_kind::node256:
+                break;
+            }
+            return *node.template get<node256>();
+        }
+
+        static node_ptr* find_child(node_ptr node, std::uint8_t byte) noexcept
+        {
+            switch (node.kind())
+            {
+            case node_kind::node4:
+                return node.template get<node4>()->find(byte);
+            case node_kind::node16:
+                return node.template get<node16>()->find(byte);
+            case node_kind::node48:
+                return node.template get<node48>()->find(byte);
+            case node_kind::leaf:
+            case node_kind::node256:
+                break;
+            }
+            return node.template get<node256>()->find(byte);
+        }
+
+        template <typename Fn>
+        static void for_each_child(node_ptr node, Fn& f)
+        {
+            switch (node.kind())
+            {
+            case node_kind::node4:
+                node.template get<node4>()->for_each(f);
+                break;
+            case node_kind::node16:
+                node.template get<node16>()->for_each(f);
+                break;
+            case node_kind::node48:
+                node.template get<node48>()->for_each(f);
+                break;
+            case node_kind::node256:
+                node.template get<node256>()->for_each(f);
+                break;
+            case node_kind::leaf:
+                DEBUG_UNREACHABLE(detail::assert_handler{});
+                break;
+            }
+        }
+
+        // moves the children into a node of another kind, destroying the old one
+        template <class To, class From>
+        static To* convert(To* to, From* from) noexcept
+        {
+            to->copy_header(*from);
+            auto add = [&](std::uint8_t byte, node_ptr child) { to->add(byte, child); };
+            from->for_each(add);
+            delete from;
+            return to;
+        }
+
+        template <class Node, class Bigger>
+        static void add_child(node_ptr& slot, Node* node, std::uint8_t byte, node_ptr child)
+        {
+            if (node->count() == Node::capacity)
+            {
+                auto bigger = convert(new Bigger, node);
+                bigger->add(byte, child);
+                slot = node_ptr(bigger);
+            }
+            else
+                node->add(byte, child);
+        }
+
+        static void add_child(node_ptr& slot, std::uint8_t byte, node_ptr child)
+        {
+            switch (slot.kind())
+            {
+            case node_kind::node4:
+                add_child<node4, node16>(slot, slot.template get<node4>(), byte, child);
+                break;
+            case node_kind::node16:
+                add_child<node16, node48>(slot, slot.template get<node16>(), byte, child);
+                break;
+            case node_kind::node48:
+                add_child<node48, node256>(slot, slot.template get<node48>(), byte, child);
+                break;
+            case node_kind::node256:
+                slot.template get<node256>()->add(byte, child);
+                break;
+            case node_kind::leaf:
+                DEBUG_UNREACHABLE(detail::assert_handler{});
+                break;
+            }
+        }
+
+        // shrinks once the children fill three quarters of the smaller kind,
+        // so alternating inserts and erases don't convert every time
+        template <class Node, class Smaller>
+        static void remove_child(node_ptr& slot, Node* node, std::uint8_t byte) noexcept
+        {
+            node->remove(byte);
+            if (node->count() <= Smaller::capacity * 3u / 4u)
+            {
+                // if the allocation fails, the node just stays bigger than necessary
+                if (auto smaller = new (std::nothrow) Smaller)
+                    slot = node_ptr(convert(smaller, node));
+            }
+        }
+
+        static void remove_child(node_ptr& slot, std::uint8_t byte) noexcept
+        {
+            switch (slot.kind())
+            {
+            case node_kind::node4:
+            {
+                auto node = slot.template get<node4>();
+                node->remove(byte);
+                if (node->count() == 1u)
+                {
+                    // replace the node by its only child
+                    auto child = node->children[0];
+                    if (!child.is_leaf())
+                        header_of(child).prepend_prefix(*node, node->bytes[0]);
+                    delete node;
+                    slot = child;
+                }
+                break;
+            }
+            case node_kind::node16:
+                remove_child<node16, node4>(slot, slot.template get<node16>(), byte);
+                break;
+            case node_kind::node48:
+                remove_child<node48, node16>(slot, slot.template get<node48>(), byte);
+                break;
+            case node_kind::node256:
+                remove_child<node256, node48>(slot, slot.template get<node256>(), byte);
+                break;
+            case node_kind::leaf:
+                DEBUG_UNREACHABLE(detail::assert_handler{});
+                break;
+            }
+        }
+
+        template <typename Fn>
+        static void for_each(node_ptr node, Fn& f)
+        {
+            if (node.is_leaf())
+            {
+                auto l = node.template get<leaf>();
+                f(static_cast<const Key&>(l->key), static_cast<const Value&>(l->value));
+            }
+            else
+            {
+                auto visit = [&](std::uint8_t, node_ptr child) { for_each(child, f); };
+                for_each_child(node, visit);
+            }
+        }
+
+        static std::size_t memory_usage(node_ptr node) noexcept
+        {
+            auto result = std::size_t(0);
+            switch (node.kind())
+            {
+            case node_kind::leaf:
+                return sizeof(leaf);
+            case node_kind::node4:
+                result = sizeof(node4);
+                break;
+            case node_kind::node16:
+                result = sizeof(node16);
+                break;
+            case node_kind::node48:
+                result = sizeof(node48);
+                break;
+            case node_kind::node256:
+                result = sizeof(node256);
+                break;
+            }
+
+            auto add = [&](std::uint8_t, node_ptr child) { result += memory_usage(child); };
+            for_each_child(node, add);
+            return result;
+        }
+
+        static void destroy(node_ptr node) noexcept
+        {
+            if (node.is_leaf())
+            {
+                delete node.template get<leaf>();
+                return;
+            }
+
+            auto destroy_child = [](std::uint8_t, node_ptr child) { destroy(child); };
+            for_each_child(node, destroy_child);
+            switch (node.kind())
+            {
+            case node_kind::node4:
+                delete node.template get<node4>();
+                break;
+            case node_kind::node16:
+                delete node.template get<node16>();
+                break;
+            case node_kind::node48:
+                delete node.template get<node48>();
+                break;
+            case node_kind::node256:
+                delete node.template get<node256>();
+                break;
+            case node_kind::leaf:
+                break;
+            }
+        }
+
+        node_ptr    root_;
+        std::size_t size_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_ART_MAP_HPP_INCLUDED
@@ -11,6 +11,12 @@
 #include <type_traits>
 
 #include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/config.hpp>
+#include <foonathan/tiny/detail/index_sequence.hpp>
+
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+#    include <foonathan/tiny/instrumentation.hpp>
+#endif
 
 namespace foonathan
 {
@@ -28,9 +34,9 @@ namespace tiny
             : modifier_([](void* ptr_, std::size_t index, bool value) {
                   auto ptr = static_cast<Integer*>(ptr_);
                   // clear
-                  *ptr &= ~(Integer(1) << index);
+                  *ptr = static_cast<Integer>(*ptr & ~(Integer(1) << index));
                   // set
-                  *ptr |= Integer(value) << index;
+                  *ptr = static_cast<Integer>(*ptr | (Integer(value) << index));
               }),
               pointer_(pointer), index_(index), value_((*pointer >> index_) & Integer(1))
             {
@@ -98,9 +104,35 @@ namespace tiny
             return static_cast<bool>((*pointer >> index) & Integer(1));
         }
 
+        //=== to_unsigned ===//
+        // signed integers are accessed through their unsigned type,
+        // but the cast is not allowed in constant expressions
+        template <typename Integer>
+        constexpr auto to_unsigned(Integer* pointer) noexcept ->
+            typename std::enable_if<std::is_unsigned<Integer>::value, Integer*>::type
+        {
+            return pointer;
+        }
+        template <typename Integer>
+        auto to_unsigned(Integer* pointer) noexcept -> typename std::enable_if<
+            std::is_signed<Integer>::value, typename std::make_unsigned<Integer>::type*>::type
+        {
+            return reinterpret_cast<typename std::make_unsigned<Integer>::type*>(pointer);
+        }
+
         //=== extracter ===//
         constexpr auto max_extract_bits = sizeof(std::uintmax_t) * CHAR_BIT;
 
+        // shifts that are also valid when shifting out all bits
+        constexpr std::uintmax_t shift_left(std::uintmax_t bits, std::size_t n) noexcept
+        {
+            return n >= max_extract_bits ? 0u : bits << n;
+        }
+        constexpr std::uintmax_t shift_right(std::uintmax_t bits, std::size_t n) noexcept
+        {
+            return n >= max_extract_bits ? 0u : bits >> n;
+        }
+
         template <typename Integer>
         constexpr Integer get_mask(std::size_t begin, std::size_t length) noexcept
         {
@@ -114,13 +146,15 @@ namespace tiny
         {
             static constexpr auto mask = get_mask<Integer>(BeginBit, EndBit - BeginBit);
 
-            static std::uintmax_t extract(const Integer* pointer) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+                const Integer* pointer) noexcept
             {
                 return static_cast<std::uintmax_t>(
                     (static_cast<std::uintmax_t>(pointer[Index]) & mask) >> BeginBit);
             }
 
-            static void put(Integer* pointer, std::uintmax_t bits) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 void put(Integer*       pointer,
+                                                       std::uintmax_t bits) noexcept
             {
                 pointer[Index] = static_cast<Integer>(pointer[Index] & ~mask);
                 pointer[Index] = static_cast<Integer>(pointer[Index] | ((bits << BeginBit) & mask));
@@ -136,14 +170,16 @@ namespace tiny
 
             using tail = bit_loop_extracter<Integer, BeginIndex, BeginBit, EndIndex, EndBit, I + 1>;
 
-            static std::uintmax_t extract(const Integer* pointer) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+                const Integer* pointer) noexcept
             {
                 auto head_result = static_cast<std::uintmax_t>(pointer[I]);
                 auto tail_result = tail::extract(pointer);
                 return (tail_result << bits_used) | head_result;
             }
 
-            static void put(Integer* pointer, std::uintmax_t bits) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 void put(Integer*       pointer,
+                                                       std::uintmax_t bits) noexcept
             {
                 pointer[I] = static_cast<Integer>(bits);
                 tail::put(pointer, bits >> bits_used);
@@ -157,12 +193,14 @@ namespace tiny
             static constexpr auto bits_used = sizeof(Integer) * CHAR_BIT - BeginBit;
             static constexpr auto mask      = get_mask<Integer>(BeginBit, bits_used);
 
-            static std::uintmax_t extract_head(const Integer* pointer) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract_head(
+                const Integer* pointer) noexcept
             {
                 return static_cast<std::uintmax_t>((pointer[BeginIndex] & mask) >> BeginBit);
             }
 
-            static void put_head(Integer* pointer, std::uintmax_t bits) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 void put_head(Integer*       pointer,
+                                                            std::uintmax_t bits) noexcept
             {
                 pointer[BeginIndex] = static_cast<Integer>(pointer[BeginIndex] & ~mask);
                 pointer[BeginIndex]
@@ -172,17 +210,20 @@ namespace tiny
             using tail = bit_loop_extracter<Integer, BeginIndex, BeginBit, EndIndex, EndBit,
                                             BeginIndex + 1>;
 
-            static std::uintmax_t extract(const Integer* pointer) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+                const Integer* pointer) noexcept
             {
                 auto head_result = extract_head(pointer);
                 auto tail_result = tail::extract(pointer);
-                return (tail_result << bits_used) | head_result;
+                // bits_used is the entire integer if BeginBit is zero
+                return shift_left(tail_result, bits_used) | head_result;
             }
 
-            static void put(Integer* pointer, std::uintmax_t bits) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 void put(Integer*       pointer,
+                                                       std::uintmax_t bits) noexcept
             {
                 put_head(pointer, bits);
-                tail::put(pointer, bits >> bits_used);
+                tail::put(pointer, shift_right(bits, bits_used));
             }
         };
 
@@ -192,17 +233,76 @@ namespace tiny
         {
             static constexpr auto mask = get_mask<Integer>(0, EndBit);
 
-            static std::uintmax_t extract(const Integer* pointer) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+                const Integer* pointer) noexcept
             {
                 return static_cast<std::uintmax_t>(pointer[EndIndex] & mask);
             }
 
-            static void put(Integer* pointer, std::uintmax_t bits) noexcept
+            static FOONATHAN_TINY_CONSTEXPR14 void put(Integer*       pointer,
+                                                       std::uintmax_t bits) noexcept
             {
                 pointer[EndIndex] = static_cast<Integer>(pointer[EndIndex] & ~mask);
                 pointer[EndIndex] = static_cast<Integer>(pointer[EndIndex] | (bits & mask));
             }
         };
+
+#if FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS
+        // same as bit_loop_extracter, but the elements between the head and the tail are folded
+        template <typename Integer, std::size_t BeginIndex, std::size_t BeginBit,
+                  std::size_t EndIndex, std::size_t EndBit,
+                  class Middle = detail::make_index_sequence<EndIndex - BeginIndex - 1>>
+        struct bit_fold_extracter;
+
+        template <typename Integer, std::size_t BeginIndex, std::size_t BeginBit,
+                  std::size_t EndIndex, std::size_t EndBit, std::size_t... Middle>
+        struct bit_fold_extracter<Integer, BeginIndex, BeginBit, EndIndex, EndBit,
+                                  detail::index_sequence<Middle...>>
+        {
+            static constexpr auto integer_bits = sizeof(Integer) * CHAR_BIT;
+            static constexpr auto head_bits    = integer_bits - BeginBit;
+            static constexpr auto head_mask    = get_mask<Integer>(BeginBit, head_bits);
+            static constexpr auto tail_mask    = get_mask<Integer>(0, EndBit);
+            static constexpr auto tail_shift   = head_bits + sizeof...(Middle) * integer_bits;
+
+            static FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+                const Integer* pointer) noexcept
+            {
+                auto result = static_cast<std::uintmax_t>((pointer[BeginIndex] & head_mask)
+                                                          >> BeginBit);
+                ((result |= shift_left(pointer[BeginIndex + 1 + Middle],
+                                       head_bits + Middle * integer_bits)),
+                 ...);
+                return result
+                       | shift_left(static_cast<std::uintmax_t>(pointer[EndIndex] & tail_mask),
+                                    tail_shift);
+            }
+
+            static FOONATHAN_TINY_CONSTEXPR14 void put(Integer*       pointer,
+                                                       std::uintmax_t bits) noexcept
+            {
+                pointer[BeginIndex] = static_cast<Integer>(pointer[BeginIndex] & ~head_mask);
+                pointer[BeginIndex] = static_cast<Integer>(pointer[BeginIndex]
+                                                           | ((bits << BeginBit) & head_mask));
+                ((pointer[BeginIndex + 1 + Middle] = static_cast<Integer>(
+                      shift_right(bits, head_bits + Middle * integer_bits))),
+                 ...);
+                pointer[EndIndex] = static_cast<Integer>(pointer[EndIndex] & ~tail_mask);
+                pointer[EndIndex] = static_cast<Integer>(
+                    pointer[EndIndex] | (shift_right(bits, tail_shift) & tail_mask));
+            }
+        };
+
+        template <typename Integer, std::size_t BeginIndex, std::size_t BeginBit,
+                  std::size_t EndIndex, std::size_t EndBit>
+        using bit_multi_extracter
+            = bit_fold_extracter<Integer, BeginIndex, BeginBit, EndIndex, EndBit>;
+#else
+        template <typename Integer, std::size_t BeginIndex, std::size_t BeginBit,
+                  std::size_t EndIndex, std::size_t EndBit>
+        using bit_multi_extracter
+            = bit_loop_extracter<Integer, BeginIndex, BeginBit, EndIndex, EndBit, BeginIndex>;
+#endif
     } // namespace bit_view_detail
 
     /// Constant to mark the remaining bits in an integer.
@@ -248,29 +348,29 @@ namespace tiny
         /// \effects Creates an empty view.
         /// \requires The bit  view is empty.
         template <std::size_t Size = size(), typename = typename std::enable_if<Size == 0>::type>
-        bit_view() noexcept : pointer_(nullptr)
-        {}
+        constexpr bit_view() noexcept : pointer_(nullptr) {}
 
         /// \effects Creates a view of the given integer.
-        explicit bit_view(Integer& integer) noexcept
-        : pointer_(reinterpret_cast<unsigned_integer*>(&integer))
+        explicit constexpr bit_view(Integer& integer) noexcept
+        : pointer_(bit_view_detail::to_unsigned(&integer))
         {}
 
         /// \effects Creates a view from the non-const version.
         template <typename U,
                   typename = typename std::enable_if<std::is_same<const U, Integer>::value>::type>
-        bit_view(bit_view<U, Begin, End> other) noexcept : pointer_(other.pointer_)
-        {}
+        constexpr bit_view(bit_view<U, Begin, End> other) noexcept : pointer_(other.pointer_) {}
 
         /// \returns A view to a subrange.
         /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit.
         template <std::size_t SubBegin, std::size_t SubEnd>
-        bit_view<Integer, Begin + SubBegin, Begin + SubEnd> subview() const noexcept
+        constexpr bit_view<Integer, Begin + SubBegin, SubEnd == last_bit ? End : Begin + SubEnd>
+            subview() const noexcept
         {
-            using result = bit_view<Integer, Begin + SubBegin, Begin + SubEnd>;
+            using result
+                = bit_view<Integer, Begin + SubBegin, SubEnd == last_bit ? End : Begin + SubEnd>;
             static_assert(begin() <= result::begin() && result::end() <= end(),
                           "view not a subview");
-            return result(*reinterpret_cast<Integer*>(pointer_));
+            return result(0, pointer_);
         }
 
         /// \returns A boolean reference to the given bit.
@@ -284,8 +384,11 @@ namespace tiny
         }
 
         /// \returns An integer containing the viewed bits in the `size()` lower bits.
-        std::uintmax_t extract() const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract() const noexcept
         {
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_read<bit_view>();
+#endif
             return extracter::extract(pointer_);
         }
 
@@ -293,15 +396,20 @@ namespace tiny
         /// \param T
         /// \exclude
         template <typename T = Integer>
-        void put(std::uintmax_t bits) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 void put(std::uintmax_t bits) const noexcept
         {
             static_assert(!std::is_const<T>::value, "cannot put in a view to const");
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_write<bit_view>();
+#endif
             extracter::put(pointer_, bits);
         }
 
     private:
         using extracter = bit_view_detail::bit_single_extracter<unsigned_integer, 0, begin_, end_>;
 
+        explicit constexpr bit_view(int, unsigned_integer* ptr) noexcept : pointer_(ptr) {}
+
         unsigned_integer* pointer_;
 
         template <typename, std::size_t, std::size_t>
@@ -368,27 +476,27 @@ namespace tiny
         /// \effects Creates an empty view.
         /// \requires The bit  view is empty.
         template <std::size_t Size = size(), typename = typename std::enable_if<Size == 0>::type>
-        bit_view() noexcept : pointer_(nullptr)
-        {}
+        constexpr bit_view() noexcept : pointer_(nullptr) {}
 
         /// \effects Creates a view of the given integer array.
-        explicit bit_view(Integer* ptr) noexcept
-        : pointer_(reinterpret_cast<unsigned_integer*>(ptr))
+        explicit constexpr bit_view(Integer* ptr) noexcept
+        : pointer_(bit_view_detail::to_unsigned(ptr))
         {}
 
         /// \effects Creates a view from the non-const version.
         template <typename U,
                   typename
                   = typename std::enable_if<std::is_same<const U[N], Integer[N]>::value>::type>
-        bit_view(bit_view<U[N], Begin, End> other) noexcept : pointer_(other.pointer_)
-        {}
+        constexpr bit_view(bit_view<U[N], Begin, End> other) noexcept : pointer_(other.pointer_) {}
 
         /// \returns A view to a subrange.
         /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit.
         template <std::size_t SubBegin, std::size_t SubEnd>
-        bit_view<Integer[N], Begin + SubBegin, Begin + SubEnd> subview() const noexcept
+        constexpr bit_view<Integer[N], Begin + SubBegin, SubEnd == last_bit ? End : Begin + SubEnd>
+            subview() const noexcept
         {
-            using result = bit_view<Integer[N], Begin + SubBegin, Begin + SubEnd>;
+            using result
+                = bit_view<Integer[N], Begin + SubBegin, SubEnd == last_bit ? End : Begin + SubEnd>;
             static_assert(begin() <= result::begin() && result::end() <= end(),
                           "view not a subview");
             return result(0, pointer_);
@@ -407,10 +515,13 @@ namespace tiny
         }
 
         /// \returns An integer containing the viewed bits in the `size()` lower bits.
-        std::uintmax_t extract() const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract() const noexcept
         {
             static_assert(size() <= bit_view_detail::max_extract_bits,
                           "too many bits to extract at once");
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_read<bit_view>();
+#endif
             return extract(std::integral_constant<bool, begin_index != end_index>{});
         }
 
@@ -418,42 +529,49 @@ namespace tiny
         /// \param T
         /// \exclude
         template <typename T = Integer>
-        void put(std::uintmax_t bits) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 void put(std::uintmax_t bits) const noexcept
         {
             static_assert(size() <= bit_view_detail::max_extract_bits,
                           "too many bits to put at once");
             static_assert(!std::is_const<T>::value, "cannot put in a view to const");
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_write<bit_view>();
+#endif
             put(std::integral_constant<bool, begin_index != end_index>{}, bits);
         }
 
     private:
-        std::uintmax_t extract(std::false_type /* single element */) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+            std::false_type /* single element */) const noexcept
         {
             return bit_view_detail::bit_single_extracter<
                 unsigned_integer, begin_index, begin_bit_index, end_bit_index>::extract(pointer_);
         }
 
-        void put(std::false_type /* single element */, std::uintmax_t bits) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 void put(std::false_type /* single element */,
+                                            std::uintmax_t bits) const noexcept
         {
             bit_view_detail::bit_single_extracter<unsigned_integer, begin_index, begin_bit_index,
                                                   end_bit_index>::put(pointer_, bits);
         }
 
-        std::uintmax_t extract(std::true_type /* multiple elements */) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract(
+            std::true_type /* multiple elements */) const noexcept
         {
-            return bit_view_detail::bit_loop_extracter<unsigned_integer, begin_index,
-                                                       begin_bit_index, end_index, end_bit_index,
-                                                       begin_index>::extract(pointer_);
+            return bit_view_detail::bit_multi_extracter<unsigned_integer, begin_index,
+                                                        begin_bit_index, end_index,
+                                                        end_bit_index>::extract(pointer_);
         }
 
-        void put(std::true_type /* multiple elements */, std::uintmax_t bits) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 void put(std::true_type /* multiple elements */,
+                                            std::uintmax_t bits) const noexcept
         {
-            return bit_view_detail::bit_loop_extracter<unsigned_integer, begin_index,
-                                                       begin_bit_index, end_index, end_bit_index,
-                                                       begin_index>::put(pointer_, bits);
+            return bit_view_detail::bit_multi_extracter<unsigned_integer, begin_index,
+                                                        begin_bit_index, end_index,
+                                                        end_bit_index>::put(pointer_, bits);
         }
 
-        explicit bit_view(int, unsigned_integer* ptr) noexcept : pointer_(ptr) {}
+        explicit constexpr bit_view(int, unsigned_integer* ptr) noexcept : pointer_(ptr) {}
 
         unsigned_integer* pointer_;
 
@@ -487,17 +605,16 @@ namespace tiny
         /// \effects Creates an empty view.
         /// \requires The bit  view is empty.
         template <std::size_t Size = size(), typename = typename std::enable_if<Size == 0>::type>
-        bit_view() noexcept
-        {}
+        constexpr bit_view() noexcept {}
 
         /// \effects Creates a view from existing views.
         template <typename... TailArgs>
-        bit_view(head_view head, TailArgs... args) noexcept : head_(head), tail_(args...)
+        constexpr bit_view(head_view head, TailArgs... args) noexcept : head_(head), tail_(args...)
         {}
 
         /// \effects Creates a view for the given parts.
         template <typename... Tail>
-        explicit bit_view(Integer& h, Tail&... tail) noexcept : head_(h), tail_(tail...)
+        explicit constexpr bit_view(Integer& h, Tail&... tail) noexcept : head_(h), tail_(tail...)
         {}
 
         /// \effects Creates a view from the non-const version.
@@ -505,7 +622,7 @@ namespace tiny
                   typename = typename std::enable_if<
                       std::is_constructible<BitView, OtherBitView>::value
                       && std::is_same<const OtherInteger, Integer>::value>::type>
-        bit_view(
+        constexpr bit_view(
             bit_view<joined_bit_view_tag<OtherBitView, OtherInteger>, Begin, End> other) noexcept
         : head_(other.head_), tail_(other.tail_)
         {}
@@ -513,13 +630,14 @@ namespace tiny
     private:
         template <std::size_t SubBegin, std::size_t SubEnd,
                   typename = typename std::enable_if<SubEnd <= head_view::size()>::type>
-        bit_view<Integer, Begin + SubBegin, Begin + SubEnd> subview_impl(int) const noexcept
+        constexpr bit_view<Integer, Begin + SubBegin, Begin + SubEnd> subview_impl(int) const
+            noexcept
         {
             return head_.template subview<SubBegin, SubEnd>();
         }
         template <std::size_t SubBegin, std::size_t SubEnd,
                   typename = typename std::enable_if<(SubBegin >= head_view::size())>::type>
-        auto subview_impl(int) const noexcept -> decltype(
+        constexpr auto subview_impl(int) const noexcept -> decltype(
             std::declval<BitView>()
                 .template subview<SubBegin - head_view::size(), SubEnd - head_view::size()>())
         {
@@ -527,7 +645,7 @@ namespace tiny
                 .template subview<SubBegin - head_view::size(), SubEnd - head_view::size()>();
         }
         template <std::size_t SubBegin, std::size_t SubEnd>
-        auto subview_impl(short) const noexcept -> bit_view<
+        FOONATHAN_TINY_CONSTEXPR14 auto subview_impl(short) const noexcept -> bit_view<
             joined_bit_view_tag<
                 decltype(std::declval<BitView>().template subview<0, SubEnd - head_view::size()>()),
                 Integer>,
@@ -543,7 +661,7 @@ namespace tiny
         /// \returns A view to a subrange.
         /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit.
         template <std::size_t SubBegin, std::size_t SubEnd>
-        auto subview() const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 auto subview() const noexcept
             -> decltype(subview_impl < SubBegin == last_bit ? size() : SubBegin,
                         SubEnd == last_bit ? size() : SubEnd > (0))
         {
@@ -566,10 +684,13 @@ namespace tiny
         }
 
         /// \returns An integer containing the viewed bits in the `size()` lower bits.
-        std::uintmax_t extract() const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract() const noexcept
         {
             static_assert(size() <= bit_view_detail::max_extract_bits,
                           "too many bits to extract at once");
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_read<bit_view>();
+#endif
 
             auto head = head_.extract();
             auto tail = tail_.extract();
@@ -580,11 +701,14 @@ namespace tiny
         /// \param T
         /// \exclude
         template <typename T = Integer>
-        void put(std::uintmax_t bits) const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 void put(std::uintmax_t bits) const noexcept
         {
             static_assert(size() <= bit_view_detail::max_extract_bits,
                           "too many bits to put at once");
             static_assert(!std::is_const<T>::value, "cannot put in a view to const");
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+            detail::count_bit_view_write<bit_view>();
+#endif
             head_.put(bits);
             tail_.put(bits >> head_.size());
         }
@@ -640,20 +764,21 @@ namespace tiny
         struct overload
         {
             template <std::size_t I>
-            operator tag<I>() const noexcept
+            constexpr operator tag<I>() const noexcept
             {
                 return {};
             }
         };
 
         template <typename Head>
-        joined_bit_view<Head> join_bit_views_impl(overload, Head h) noexcept
+        constexpr joined_bit_view<Head> join_bit_views_impl(overload, Head h) noexcept
         {
             return h;
         }
 
         template <typename Head, typename... Tail>
-        auto join_bit_views_impl(tag<0>, Head h, Tail... tail) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto join_bit_views_impl(tag<0>, Head h,
+                                                            Tail... tail) noexcept ->
             typename std::enable_if<Head::size() != 0 && joined_bit_view<Tail...>::size() != 0,
                                     joined_bit_view<Head, Tail...>>::type
         {
@@ -661,21 +786,21 @@ namespace tiny
             return {h, tail_view};
         }
         template <typename Head, typename... Tail>
-        auto join_bit_views_impl(tag<1>, Head h, Tail...) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto join_bit_views_impl(tag<1>, Head h, Tail...) noexcept ->
             typename std::enable_if<Head::size() != 0 && joined_bit_view<Tail...>::size() == 0,
                                     joined_bit_view<Head, Tail...>>::type
         {
             return h;
         }
         template <typename Head, typename... Tail>
-        auto join_bit_views_impl(tag<2>, Head, Tail... tail) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto join_bit_views_impl(tag<2>, Head, Tail... tail) noexcept ->
             typename std::enable_if<Head::size() == 0 && joined_bit_view<Tail...>::size() != 0,
                                     joined_bit_view<Head, Tail...>>::type
         {
             return join_bit_views_impl(overload{}, tail...);
         }
         template <typename Head, typename... Tail>
-        auto join_bit_views_impl(tag<3>, Head h, Tail...) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto join_bit_views_impl(tag<3>, Head h, Tail...) noexcept ->
             typename std::enable_if<Head::size() == 0 && joined_bit_view<Tail...>::size() == 0,
                                     joined_bit_view<Head, Tail...>>::type
         {
@@ -685,7 +810,8 @@ namespace tiny
 
     /// \returns A joined bit view from the given views.
     template <class... BitViews>
-    joined_bit_view<BitViews...> join_bit_views(BitViews... views) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 joined_bit_view<BitViews...> join_bit_views(
+        BitViews... views) noexcept
     {
         return bit_view_detail::join_bit_views_impl(bit_view_detail::overload{}, views...);
     }
@@ -693,7 +819,7 @@ namespace tiny
     //=== bit_view convenience functions ===//
     /// \returns The specified bit view.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    bit_view<Integer, Begin, End> make_bit_view(Integer& i) noexcept
+    constexpr bit_view<Integer, Begin, End> make_bit_view(Integer& i) noexcept
     {
         return bit_view<Integer, Begin, End>(i);
     }
@@ -701,7 +827,7 @@ namespace tiny
     /// Extracts the specified range of bits from an integer.
     /// \returns `bit_view<Integer, Begin, End>(i).extract()`
     template <std::size_t Begin, std::size_t End, typename Integer>
-    std::uintmax_t extract_bits(Integer i) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t extract_bits(Integer i) noexcept
     {
         return bit_view<Integer, Begin, End>(i).extract();
     }
@@ -709,7 +835,7 @@ namespace tiny
     /// Puts bits into the specified range of bits.
     /// \returns Same as `bit_view<Integer, Begin, End>(i).put(bits)`.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    Integer put_bits(Integer i, std::uintmax_t bits) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 Integer put_bits(Integer i, std::uintmax_t bits) noexcept
     {
         bit_view<Integer, Begin, End>(i).put(bits);
         return i;
@@ -718,28 +844,28 @@ namespace tiny
     /// Checks that the range of bits is zero.
     /// \returns `extract_bits<Begin, End>(i) == 0`.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    bool are_cleared_bits(Integer i) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 bool are_cleared_bits(Integer i) noexcept
     {
         return extract_bits<Begin, End>(i) == 0;
     }
 
     /// Checks that the bits not in the range are zero.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    bool are_only_bits(Integer i) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 bool are_only_bits(Integer i) noexcept
     {
         return are_cleared_bits<0, Begin>(i) && are_cleared_bits<End, last_bit>(i);
     }
 
     /// Clears all bits in the specified range by setting them to zero.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    Integer clear_bits(Integer i) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 Integer clear_bits(Integer i) noexcept
     {
         return put_bits<Begin, End>(i, 0);
     }
 
     /// Clears all bits not in the specified range by setting them to zero.
     template <std::size_t Begin, std::size_t End, typename Integer>
-    Integer clear_other_bits(Integer i) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 Integer clear_other_bits(Integer i) noexcept
     {
         i = clear_bits<0, Begin>(i);
         return clear_bits<End, last_bit>(i);
@@ -749,12 +875,13 @@ namespace tiny
     namespace bit_view_detail
     {
         template <class BitView, class OtherBitView>
-        auto copy_bits_impl(tag<0>, BitView, OtherBitView) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto copy_bits_impl(tag<0>, BitView, OtherBitView) noexcept ->
             typename std::enable_if<BitView::size() == 0>::type
         {}
 
         template <class BitView, class OtherBitView>
-        auto copy_bits_impl(tag<1>, BitView dest, OtherBitView src) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto copy_bits_impl(tag<1>, BitView dest,
+                                                       OtherBitView src) noexcept ->
             typename std::enable_if<(BitView::size() > 0)
                                     && BitView::size() <= max_extract_bits>::type
         {
@@ -762,12 +889,13 @@ namespace tiny
         }
 
         template <class BitView, class OtherBitView>
-        auto copy_bits_impl(tag<2>, std::false_type, BitView dest, OtherBitView src) noexcept ->
+        FOONATHAN_TINY_CONSTEXPR14 auto copy_bits_impl(tag<2>, BitView dest,
+                                                       OtherBitView src) noexcept ->
             typename std::enable_if<(BitView::size() > max_extract_bits)>::type
         {
             dest.template subview<0, max_extract_bits>().put(
                 src.template subview<0, max_extract_bits>().extract());
-            copy_bits_impl(dest.template subview<max_extract_bits, last_bit>(),
+            copy_bits_impl(overload{}, dest.template subview<max_extract_bits, last_bit>(),
                            src.template subview<max_extract_bits, last_bit>());
         }
     } // namespace bit_view_detail
@@ -775,8 +903,9 @@ namespace tiny
     /// \effects Copies the bits from `src` to `dest`.
     template <typename Integer, std::size_t Begin, std::size_t End, typename OtherInteger,
               std::size_t OtherBegin, std::size_t OtherEnd>
-    void copy_bits(bit_view<Integer, Begin, End>                dest,
-                   bit_view<OtherInteger, OtherBegin, OtherEnd> src) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 void copy_bits(bit_view<Integer, Begin, End>                dest,
+                                              bit_view<OtherInteger, OtherBegin, OtherEnd> src)
+        noexcept
     {
         static_assert(decltype(dest)::size() == decltype(src)::size(),
                       "bit views must have the same sizes");
@@ -787,11 +916,12 @@ namespace tiny
     namespace bit_view_detail
     {
         template <class BitView>
-        auto clear_bits_impl(tag<0>, BitView) -> typename std::enable_if<BitView::size() == 0>::type
+        FOONATHAN_TINY_CONSTEXPR14 auto clear_bits_impl(tag<0>, BitView) ->
+            typename std::enable_if<BitView::size() == 0>::type
         {}
 
         template <class BitView>
-        auto clear_bits_impl(tag<1>, BitView view) ->
+        FOONATHAN_TINY_CONSTEXPR14 auto clear_bits_impl(tag<1>, BitView view) ->
             typename std::enable_if<(BitView::size() > 0)
                                     && BitView::size() <= max_extract_bits>::type
         {
@@ -799,16 +929,16 @@ namespace tiny
         }
 
         template <class BitView>
-        auto clear_bits_impl(tag<2>, BitView view) ->
+        FOONATHAN_TINY_CONSTEXPR14 auto clear_bits_impl(tag<2>, BitView view) ->
             typename std::enable_if<(BitView::size() > max_extract_bits)>::type
         {
             view.template subview<0, max_extract_bits>().put(0);
-            clear_bits_impl(view.template subview<max_extract_bits, last_bit>());
+            clear_bits_impl(overload{}, view.template subview<max_extract_bits, last_bit>());
         }
     } // namespace bit_view_detail
 
     template <typename Integer, std::size_t Begin, std::size_t End>
-    void clear_bits(bit_view<Integer, Begin, End> view) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 void clear_bits(bit_view<Integer, Begin, End> view) noexcept
     {
         bit_view_detail::clear_bits_impl(bit_view_detail::overload{}, view);
     }
@@ -0,0 +1,46 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_DETAIL_BIT_OPS_HPP_INCLUDED
+#define FOONATHAN_TINY_DETAIL_BIT_OPS_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace foonathan
+{
+namespace tiny
+{
+    namespace detail
+    {
+        // number of set bits
+        inline std::size_t popcount(std::uint64_t x) noexcept
+        {
+            // on x86 the builtin is a library call unless the instruction is available
+#if (defined(__GNUC__) || defined(__clang__))                                                      \
+    && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+            return static_cast<std::size_t>(__builtin_popcountll(x));
+#else
+            x = x - ((x >> 1) & 0x5555555555555555ull);
+            x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+            return static_cast<std::size_t>((x * 0x0101010101010101ull) >> 56);
+#endif
+        }
+
+        // index of the lowest set bit, undefined for 0
+        inline std::size_t count_trailing_zeros(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(x));
+#else
+            // isolate the lowest bit, then count the bits below it
+            return popcount((x & (~x + 1u)) - 1u);
+#endif
+        }
+    } // namespace detail
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_DETAIL_BIT_OPS_HPP_INCLUDED
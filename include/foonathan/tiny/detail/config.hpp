@@ -0,0 +1,51 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_DETAIL_CONFIG_HPP_INCLUDED
+#define FOONATHAN_TINY_DETAIL_CONFIG_HPP_INCLUDED
+
+// whether or not fold expressions can be used instead of recursive templates,
+// define it to 0 to force the C++11 implementation
+#ifndef FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS
+#    if defined(__cpp_fold_expressions) && __cpp_fold_expressions >= 201603L
+#        define FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS 1
+#    else
+#        define FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS 0
+#    endif
+#endif
+
+// whether or not the members of aggregates can be determined using structured bindings,
+// see padding_traits_reflect in <foonathan/tiny/padding_traits.hpp>
+#ifndef FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION
+#    if defined(__cpp_structured_bindings) && __cpp_structured_bindings >= 201606L
+#        define FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION 1
+#    else
+#        define FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION 0
+#    endif
+#endif
+
+// whether or not accesses to bit views and tiny types are counted,
+// see <foonathan/tiny/instrumentation.hpp>
+#ifndef FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+#    define FOONATHAN_TINY_ENABLE_INSTRUMENTATION 0
+#endif
+
+// whether or not functions with the relaxed C++14 rules can be constexpr,
+// counting accesses can't be done at compile-time
+#ifndef FOONATHAN_TINY_HAS_CONSTEXPR14
+#    if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L                                     \
+        && !FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+#        define FOONATHAN_TINY_HAS_CONSTEXPR14 1
+#    else
+#        define FOONATHAN_TINY_HAS_CONSTEXPR14 0
+#    endif
+#endif
+
+#if FOONATHAN_TINY_HAS_CONSTEXPR14
+#    define FOONATHAN_TINY_CONSTEXPR14 constexpr
+#else
+#    define FOONATHAN_TINY_CONSTEXPR14
+#endif
+
+#endif // FOONATHAN_TINY_DETAIL_CONFIG_HPP_INCLUDED
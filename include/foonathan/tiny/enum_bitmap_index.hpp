@@ -0,0 +1,323 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_ENUM_BITMAP_INDEX_HPP_INCLUDED
+#define FOONATHAN_TINY_ENUM_BITMAP_INDEX_HPP_INCLUDED
+
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/bit_ops.hpp>
+#include <foonathan/tiny/enum_traits.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        constexpr std::size_t bitmap_word_bits = 64u;
+
+        constexpr std::size_t bitmap_word_count(std::size_t rows) noexcept
+        {
+            return (rows + bitmap_word_bits - 1u) / bitmap_word_bits;
+        }
+
+        inline std::uint64_t bitmap_bit(std::size_t row) noexcept
+        {
+            return std::uint64_t(1) << (row % bitmap_word_bits);
+        }
+    } // namespace detail
+
+    /// A set of row indices, stored as a bitmap.
+    ///
+    /// It is the result of the queries of a [tiny::enum_bitmap_index]().
+    /// Results of queries on different columns can be combined word-wise.
+    class row_bitmap
+    {
+    public:
+        /// \effects Creates a bitmap for the given number of rows where no row is set.
+        explicit row_bitmap(std::size_t rows = 0u)
+        : words_(detail::bitmap_word_count(rows), 0u), rows_(rows)
+        {}
+
+        //=== accessors ===//
+        /// \returns The number of rows, set or not.
+        std::size_t size() const noexcept
+        {
+            return rows_;
+        }
+
+        /// \returns The number of rows that are set.
+        std::size_t count() const noexcept
+        {
+            std::size_t result = 0;
+            for (auto word : words_)
+                result += detail::popcount(word);
+            return result;
+        }
+
+        /// \returns Whether or not the row is set.
+        /// \requires `row < size()`.
+        bool is_set(std::size_t row) const noexcept
+        {
+            DEBUG_ASSERT(row < rows_, detail::precondition_handler{}, "row out of range");
+            return (words_[row / detail::bitmap_word_bits] & detail::bitmap_bit(row)) != 0u;
+        }
+
+        /// \effects Invokes `f(row)` for every row that is set, in increasing order.
+        template <typename Fn>
+        void for_each(Fn f) const
+        {
+            for (std::size_t i = 0; i != words_.size(); ++i)
+                for (auto word = words_[i]; word != 0u; word &= word - 1u)
+                    f(i * detail::bitmap_word_bits + detail::count_trailing_zeros(word));
+        }
+
+        //=== modifiers ===//
+        /// \effects Sets the row.
+        /// \requires `row < size()`.
+        void set(std::size_t row) noexcept
+        {
+            DEBUG_ASSERT(row < rows_, detail::precondition_handler{}, "row out of range");
+            words_[row / detail::bitmap_word_bits] |= detail::bitmap_bit(row);
+        }
+
+        /// \effects Resets the row.
+        /// \requires `row < size()`.
+        void reset(std::size_t row) noexcept
+        {
+            DEBUG_ASSERT(row < rows_, detail::precondition_handler{}, "row out of range");
+            words_[row / detail::bitmap_word_bits] &= ~detail::bitmap_bit(row);
+        }
+
+        /// \effects Sets all rows that are set in `other` (union).
+        /// \requires Both must have the same size.
+        row_bitmap& operator|=(const row_bitmap& other) noexcept
+        {
+            DEBUG_ASSERT(rows_ == other.rows_, detail::precondition_handler{}, "size mismatch");
+            for (std::size_t i = 0; i != words_.size(); ++i)
+                words_[i] |= other.words_[i];
+            return *this;
+        }
+
+        /// \effects Resets all rows that are not set in `other` (intersection).
+        /// \requires Both must have the same size.
+        row_bitmap& operator&=(const row_bitmap& other) noexcept
+        {
+            DEBUG_ASSERT(rows_ == other.rows_, detail::precondition_handler{}, "size mismatch");
+            for (std::size_t i = 0; i != words_.size(); ++i)
+                words_[i] &= other.words_[i];
+            return *this;
+        }
+
+        /// \effects Resets all rows that are set in `other` (difference).
+        /// \requires Both must have the same size.
+        row_bitmap& operator-=(const row_bitmap& other) noexcept
+        {
+            DEBUG_ASSERT(rows_ == other.rows_, detail::precondition_handler{}, "size mismatch");
+            for (std::size_t i = 0; i != words_.size(); ++i)
+                words_[i] &= ~other.words_[i];
+            return *this;
+        }
+
+        /// \returns The union, intersection or difference of the rows.
+        /// \requires Both must have the same size.
+        /// \group set_algebra
+        friend row_bitmap operator|(row_bitmap lhs, const row_bitmap& rhs) noexcept
+        {
+            return lhs |= rhs;
+        }
+        /// \group set_algebra
+        friend row_bitmap operator&(row_bitmap lhs, const row_bitmap& rhs) noexcept
+        {
+            return lhs &= rhs;
+        }
+        /// \group set_algebra
+        friend row_bitmap operator-(row_bitmap lhs, const row_bitmap& rhs) noexcept
+        {
+            return lhs -= rhs;
+        }
+
+        //=== comparison ===//
+        friend bool operator==(const row_bitmap& lhs, const row_bitmap& rhs) noexcept
+        {
+            return lhs.rows_ == rhs.rows_ && lhs.words_ == rhs.words_;
+        }
+        friend bool operator!=(const row_bitmap& lhs, const row_bitmap& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // invariant: bits after the last row are always zero
+        std::vector<std::uint64_t> words_;
+        std::size_t                rows_;
+
+        template <class EnumOrTraits>
+        friend class enum_bitmap_index;
+    };
+
+    /// A bitmap index over a column of enum values.
+    ///
+    /// It stores one bitmap per enum value, where the `i`th bit is set if the `i`th row has that
+    /// value. Queries like "how many rows have one of the values `A` or `C`" are then answered by
+    /// combining the bitmaps of the values one word at a time,
+    /// instead of looking at each row individually.
+    ///
+    /// The `EnumOrTraits` must be contiguous, like for [tiny::tiny_enum]().
+    /// The memory is one bit per row and enum value,
+    /// so it is meant for enums with only a couple of values.
+    template <class EnumOrTraits>
+    class enum_bitmap_index
+    {
+        using traits = traits_of_enum<EnumOrTraits>;
+        static_assert(traits::is_contiguous, "enum must be contiguous");
+
+    public:
+        using enum_type = typename traits::enum_type;
+
+        //=== constructors ===//
+        /// \effects Creates an index without rows.
+        enum_bitmap_index() noexcept : rows_(0u) {}
+
+        /// \effects Creates an index over the rows in the range `[begin, end)`.
+        /// Each row must be convertible to the `enum_type`,
+        /// so it can be a range of [tiny::tiny_enum]() proxies.
+        template <typename ForwardIt>
+        enum_bitmap_index(ForwardIt begin, ForwardIt end) : enum_bitmap_index()
+        {
+            for (auto cur = begin; cur != end; ++cur)
+                push_back(static_cast<enum_type>(*cur));
+        }
+
+        //=== accessors ===//
+        /// \returns The number of rows.
+        std::size_t size() const noexcept
+        {
+            return rows_;
+        }
+
+        /// \returns Whether or not there are no rows.
+        bool empty() const noexcept
+        {
+            return rows_ == 0u;
+        }
+
+        /// \returns The value of the given row.
+        /// \requires `row < size()`.
+        enum_type operator[](std::size_t row) const noexcept
+        {
+            DEBUG_ASSERT(row < rows_, detail::precondition_handler{}, "row out of range");
+            auto word = row / detail::bitmap_word_bits;
+            for (std::size_t i = 0; i != enum_size<traits>(); ++i)
+                if (bitmaps_[i][word] & detail::bitmap_bit(row))
+                    return value_of(i);
+            return DEBUG_UNREACHABLE(detail::assert_handler{});
+        }
+
+        //=== modifiers ===//
+        /// \effects Reserves memory for the given number of rows.
+        void reserve(std::size_t rows)
+        {
+            for (auto& bitmap : bitmaps_)
+                bitmap.reserve(detail::bitmap_word_count(rows));
+        }
+
+        /// \effects Adds a new row with the given value.
+        /// \requires The value must be a valid enum value.
+        void push_back(enum_type value)
+        {
+            if (rows_ % detail::bitmap_word_bits == 0u)
+                for (auto& bitmap : bitmaps_)
+                    bitmap.push_back(0u);
+
+            bitmap_of(value).back() |= detail::bitmap_bit(rows_);
+            ++rows_;
+        }
+
+        /// \effects Changes the value of an existing row,
+        /// i.e. updates the index after the value of the column has been changed.
+        /// \requires `row < size()` and the value must be a valid enum value.
+        void assign(std::size_t row, enum_type value) noexcept
+        {
+            DEBUG_ASSERT(row < rows_, detail::precondition_handler{}, "row out of range");
+            auto word = row / detail::bitmap_word_bits;
+            for (auto& bitmap : bitmaps_)
+                bitmap[word] &= ~detail::bitmap_bit(row);
+            bitmap_of(value)[word] |= detail::bitmap_bit(row);
+        }
+
+        /// \effects Removes all rows.
+        void clear() noexcept
+        {
+            for (auto& bitmap : bitmaps_)
+                bitmap.clear();
+            rows_ = 0u;
+        }
+
+        //=== queries ===//
+        /// \returns The number of rows whose value is one of the given values.
+        template <typename... Values>
+        std::size_t count(enum_type value, Values... values) const noexcept
+        {
+            const std::vector<std::uint64_t>* bitmaps[] = {&bitmap_of(value),
+                                                           &bitmap_of(values)...};
+
+            std::size_t result = 0;
+            for (std::size_t word = 0; word != detail::bitmap_word_count(rows_); ++word)
+                result += detail::popcount(combine(bitmaps, word));
+            return result;
+        }
+
+        /// \returns The set of rows whose value is one of the given values.
+        template <typename... Values>
+        row_bitmap select(enum_type value, Values... values) const
+        {
+            const std::vector<std::uint64_t>* bitmaps[] = {&bitmap_of(value),
+                                                           &bitmap_of(values)...};
+
+            row_bitmap result(rows_);
+            for (std::size_t word = 0; word != result.words_.size(); ++word)
+                result.words_[word] = combine(bitmaps, word);
+            return result;
+        }
+
+    private:
+        static enum_type value_of(std::size_t index) noexcept
+        {
+            return enum_type(index + std::size_t(traits::min()));
+        }
+
+        const std::vector<std::uint64_t>& bitmap_of(enum_type value) const noexcept
+        {
+            DEBUG_ASSERT(is_valid_enum_value<traits>(value), detail::precondition_handler{},
+                         "invalid enum value");
+            return bitmaps_[std::size_t(value) - std::size_t(traits::min())];
+        }
+        std::vector<std::uint64_t>& bitmap_of(enum_type value) noexcept
+        {
+            DEBUG_ASSERT(is_valid_enum_value<traits>(value), detail::precondition_handler{},
+                         "invalid enum value");
+            return bitmaps_[std::size_t(value) - std::size_t(traits::min())];
+        }
+
+        template <std::size_t N>
+        static std::uint64_t combine(const std::vector<std::uint64_t>* (&bitmaps)[N],
+                                     std::size_t word) noexcept
+        {
+            std::uint64_t result = 0;
+            for (auto bitmap : bitmaps)
+                result |= (*bitmap)[word];
+            return result;
+        }
+
+        std::vector<std::uint64_t> bitmaps_[enum_size<traits>()];
+        std::size_t                rows_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_ENUM_BITMAP_INDEX_HPP_INCLUDED
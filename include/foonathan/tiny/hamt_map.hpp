@@ -0,0 +1,492 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_HAMT_MAP_HPP_INCLUDED
+#define FOONATHAN_TINY_HAMT_MAP_HPP_INCLUDED
+
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include <foonathan/tiny/detail/bit_ops.hpp>
+#include <foonathan/tiny/packed_shared_ptr.hpp>
+#include <foonathan/tiny/pointer_variant_impl.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace hamt_detail
+    {
+        // every level uses 5 bits of the hash to select one of 32 children
+        constexpr std::size_t level_bits = 5u;
+        constexpr std::size_t hash_bits  = sizeof(std::size_t) * CHAR_BIT;
+
+        inline std::uint32_t index_bit(std::size_t hash, std::size_t shift) noexcept
+        {
+            return std::uint32_t(1) << ((hash >> shift) & ((1u << level_bits) - 1u));
+        }
+
+        // the index of the child in the array, i.e. the number of children before it
+        inline std::size_t child_index(std::uint32_t bitmap, std::uint32_t bit) noexcept
+        {
+            return detail::popcount(bitmap & (bit - 1u));
+        }
+
+        template <typename Key, typename Value>
+        struct leaf : packed_ref_counted
+        {
+            std::size_t hash;
+            Key         key;
+            Value       value;
+            // the other leaves with the same hash,
+            // owns a reference but can't be a packed_shared_ptr as the type is incomplete
+            leaf* next;
+
+            leaf(std::size_t hash, Key key, Value value)
+            : hash(hash), key(std::move(key)), value(std::move(value)), next(nullptr)
+            {}
+
+            leaf(const leaf&) = delete;
+            leaf& operator=(const leaf&) = delete;
+
+            ~leaf() noexcept
+            {
+                packed_shared_ptr<leaf>::adopt(next);
+            }
+        };
+
+        template <typename Key, typename Value>
+        class branch;
+
+        // an owning pointer to either a leaf or a branch
+        template <typename Key, typename Value>
+        class node_ptr
+        {
+            using leaf_type   = leaf<Key, Value>;
+            using branch_type = branch<Key, Value>;
+            using ptr_type    = pointer_variant_impl<leaf_type, branch_type>;
+
+        public:
+            node_ptr() noexcept : ptr_(nullptr) {}
+
+            node_ptr(packed_shared_ptr<leaf_type> ptr) noexcept : ptr_(ptr.detach()) {}
+
+            node_ptr(packed_shared_ptr<branch_type> ptr) noexcept : ptr_(ptr.detach()) {}
+
+            node_ptr(const node_ptr& other) : ptr_(nullptr)
+            {
+                if (other.is_leaf())
+                    ptr_.reset(packed_shared_ptr<leaf_type>::share(other.get_leaf()).detach());
+                else if (other)
+                    ptr_.reset(packed_shared_ptr<branch_type>::share(other.get_branch()).detach());
+            }
+
+            node_ptr(node_ptr&& other) noexcept : ptr_(other.ptr_)
+            {
+                other.ptr_.reset(nullptr);
+            }
+
+            ~node_ptr() noexcept
+            {
+                if (is_leaf())
+                    packed_shared_ptr<leaf_type>::adopt(get_leaf());
+                else if (*this)
+                    packed_shared_ptr<branch_type>::adopt(get_branch());
+            }
+
+            node_ptr& operator=(node_ptr other) noexcept
+            {
+                std::swap(ptr_, other.ptr_);
+                return *this;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return ptr_.has_value();
+            }
+
+            bool is_leaf() const noexcept
+            {
+                return ptr_.tag() == ptr_type::template tag_of<leaf_type>::value;
+            }
+
+            leaf_type* get_leaf() const noexcept
+            {
+                return ptr_.template pointer_to<leaf_type>();
+            }
+
+            branch_type* get_branch() const noexcept
+            {
+                return ptr_.template pointer_to<branch_type>();
+            }
+
+        private:
+            ptr_type ptr_;
+        };
+
+        // the children are stored directly after the object
+        template <typename Key, typename Value>
+        class branch : public packed_ref_counted
+        {
+        public:
+            using child = node_ptr<Key, Value>;
+
+            // all children are null
+            static packed_shared_ptr<branch> make(std::uint32_t bitmap)
+            {
+                static_assert(alignof(child) <= alignof(branch), "children would be misaligned");
+                auto node = new (child_count{detail::popcount(bitmap)}) branch(bitmap);
+                return packed_shared_ptr<branch>(node);
+            }
+
+            // all children are copied from other, except the one at the given index
+            static packed_shared_ptr<branch> make(const branch& other, std::size_t index,
+                                                  child replacement)
+            {
+                auto result = make(other.bitmap_);
+                for (std::size_t i = 0; i != other.size(); ++i)
+                    result->children()[i] = i == index ? std::move(replacement)
+                                                       : other.children()[i];
+                return result;
+            }
+
+            ~branch() noexcept
+            {
+                for (std::size_t i = 0; i != size(); ++i)
+                    children()[i].~child();
+            }
+
+            // a tag type, as operator delete(void*, std::size_t) is a usual deallocation function,
+            // no matching placement delete is needed, as the constructor is noexcept
+            struct child_count
+            {
+                std::size_t value;
+            };
+
+            static void* operator new(std::size_t size, child_count children)
+            {
+                return ::operator new(size + children.value * sizeof(child));
+            }
+            static void operator delete(void* memory) noexcept
+            {
+                ::operator delete(memory);
+            }
+
+            std::uint32_t bitmap() const noexcept
+            {
+                return bitmap_;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return detail::popcount(bitmap_);
+            }
+
+            child* children() noexcept
+            {
+                return reinterpret_cast<child*>(this + 1);
+            }
+            const child* children() const noexcept
+            {
+                return reinterpret_cast<const child*>(this + 1);
+            }
+
+        private:
+            explicit branch(std::uint32_t bitmap) noexcept : bitmap_(bitmap)
+            {
+                for (std::size_t i = 0; i != size(); ++i)
+                    ::new (static_cast<void*>(children() + i)) child();
+            }
+
+            std::uint32_t bitmap_;
+        };
+    } // namespace hamt_detail
+
+    /// A persistent hash map implemented as a hash array mapped trie (HAMT).
+    ///
+    /// The map is immutable: `set()` and `erase()` return a new map,
+    /// which shares all nodes except the ones on the path to the changed key.
+    /// So copying a map to create a snapshot is `O(1)` and never copies the keys or values.
+    ///
+    /// Every branch node has up to 32 children selected by 5 bits of the hash.
+    /// Only the children that exist are stored, in an array directly after the node,
+    /// and a 32 bit bitmap tells which ones;
+    /// the index of a child is the number of set bits before its bit.
+    /// A child is a [tiny::pointer_variant_impl]() that stores whether it is a leaf or a branch in
+    /// the alignment bits of the pointer, so it is just a single pointer.
+    /// The nodes are owned by a [tiny::packed_shared_ptr](),
+    /// which stores the reference count in the alignment bits of a pointer in the node.
+    /// Keys with the same hash are stored in a list of leaves.
+    ///
+    /// \notes Like [tiny::packed_shared_ptr](), the reference count is not thread-safe,
+    /// so maps sharing nodes must not be copied or destroyed concurrently.
+    template <typename Key, typename Value, class Hash = std::hash<Key>,
+              class KeyEqual = std::equal_to<Key>>
+    class hamt_map
+    {
+        using leaf_type   = hamt_detail::leaf<Key, Value>;
+        using branch_type = hamt_detail::branch<Key, Value>;
+        using child       = hamt_detail::node_ptr<Key, Value>;
+
+    public:
+        using key_type    = Key;
+        using mapped_type = Value;
+
+        //=== constructors ===//
+        /// \effects Creates an empty map.
+        explicit hamt_map(Hash hash = Hash(), KeyEqual equal = KeyEqual())
+        : size_(0), hash_(std::move(hash)), equal_(std::move(equal))
+        {}
+
+        //=== accessors ===//
+        /// \returns The number of keys.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no keys.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns A pointer to the value of the key, or `nullptr` if there is none.
+        const Value* find(const Key& key) const
+        {
+            if (!root_)
+                return nullptr;
+
+            auto hash = std::size_t(hash_(key));
+            auto node = root_.get();
+            for (auto shift = std::size_t(0);; shift += hamt_detail::level_bits)
+            {
+                auto bit = hamt_detail::index_bit(hash, shift);
+                if ((node->bitmap() & bit) == 0u)
+                    return nullptr;
+
+                auto& cur = node->children()[hamt_detail::child_index(node->bitmap(), bit)];
+                if (!cur.is_leaf())
+                    node = cur.get_branch();
+                else
+                {
+                    for (auto l = cur.get_leaf(); l; l = l->next)
+                        if (l->hash == hash && equal_(l->key, key))
+                            return &l->value;
+                    return nullptr;
+                }
+            }
+        }
+
+        /// \returns Whether or not the map contains the key.
+        bool contains(const Key& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        /// \effects Calls `f(key, value)` for every key in an unspecified order.
+        template <typename Fn>
+        void for_each(Fn f) const
+        {
+            if (root_)
+                for_each(*root_, f);
+        }
+
+        //=== modifiers ===//
+        /// \returns A map where the key has the given value, inserting it if necessary.
+        /// \notes `*this` is not modified.
+        hamt_map set(Key key, Value value) const
+        {
+            auto hash  = std::size_t(hash_(key));
+            auto added = true;
+
+            hamt_map result(*this);
+            if (!root_)
+            {
+                result.root_ = branch_type::make(hamt_detail::index_bit(hash, 0u));
+                result.root_->children()[0]
+                    = child(make_leaf(hash, std::move(key), std::move(value), nullptr));
+            }
+            else
+                result.root_ = set(*root_, 0u, hash, key, value, added);
+
+            if (added)
+                ++result.size_;
+            return result;
+        }
+
+        /// \returns A map without the key.
+        /// \notes `*this` is not modified.
+        hamt_map erase(const Key& key) const
+        {
+            auto removed = false;
+            auto hash    = std::size_t(hash_(key));
+            auto root    = root_ ? erase(*root_, 0u, hash, key, removed) : child();
+            if (!removed)
+                return *this;
+
+            hamt_map result(*this);
+            // the root is never collapsed into a leaf
+            result.root_ = root ? packed_shared_ptr<branch_type>::share(root.get_branch())
+                                : packed_shared_ptr<branch_type>();
+            --result.size_;
+            return result;
+        }
+
+    private:
+        static packed_shared_ptr<leaf_type> make_leaf(std::size_t hash, Key key, Value value,
+                                                      packed_shared_ptr<leaf_type> next)
+        {
+            auto result  = make_packed_shared<leaf_type>(hash, std::move(key), std::move(value));
+            result->next = next.detach();
+            return result;
+        }
+
+        template <typename Fn>
+        static void for_each(const branch_type& node, Fn& f)
+        {
+            for (std::size_t i = 0; i != node.size(); ++i)
+            {
+                auto& cur = node.children()[i];
+                if (!cur.is_leaf())
+                    for_each(*cur.get_branch(), f);
+                else
+                    for (auto l = cur.get_leaf(); l; l = l->next)
+                        f(static_cast<const Key&>(l->key), static_cast<const Value&>(l->value));
+            }
+        }
+
+        // the list of leaves without the key
+        packed_shared_ptr<leaf_type> without(leaf_type* list, const Key& key, bool& found) const
+        {
+            if (!list)
+                return nullptr;
+            else if (equal_(list->key, key))
+            {
+                found = true;
+                return packed_shared_ptr<leaf_type>::share(list->next);
+            }
+
+            auto rest = without(list->next, key, found);
+            if (!found)
+                // the list doesn't change, so it can be shared
+                return packed_shared_ptr<leaf_type>::share(list);
+            return make_leaf(list->hash, list->key, list->value, std::move(rest));
+        }
+
+        // a branch containing both leaves, which have different hashes
+        static child make_pair(std::size_t shift, child a, std::size_t hash_a, child b,
+                               std::size_t hash_b)
+        {
+            auto bit_a = hamt_detail::index_bit(hash_a, shift);
+            auto bit_b = hamt_detail::index_bit(hash_b, shift);
+            if (bit_a == bit_b)
+            {
+                auto result            = branch_type::make(bit_a);
+                result->children()[0] = make_pair(shift + hamt_detail::level_bits, std::move(a),
+                                                  hash_a, std::move(b), hash_b);
+                return child(std::move(result));
+            }
+
+            auto result                            = branch_type::make(bit_a | bit_b);
+            result->children()[bit_a < bit_b ? 0 : 1] = std::move(a);
+            result->children()[bit_a < bit_b ? 1 : 0] = std::move(b);
+            return child(std::move(result));
+        }
+
+        packed_shared_ptr<branch_type> set(const branch_type& node, std::size_t shift,
+                                           std::size_t hash, Key& key, Value& value,
+                                           bool& added) const
+        {
+            auto bit   = hamt_detail::index_bit(hash, shift);
+            auto index = hamt_detail::child_index(node.bitmap(), bit);
+            if ((node.bitmap() & bit) == 0u)
+            {
+                // insert a new child
+                auto result = branch_type::make(node.bitmap() | bit);
+                for (std::size_t i = 0; i != node.size(); ++i)
+                    result->children()[i < index ? i : i + 1u] = node.children()[i];
+                result->children()[index]
+                    = child(make_leaf(hash, std::move(key), std::move(value), nullptr));
+                return result;
+            }
+
+            auto& cur = node.children()[index];
+            if (!cur.is_leaf())
+                return branch_type::make(node, index,
+                                         child(set(*cur.get_branch(),
+                                                   shift + hamt_detail::level_bits, hash, key,
+                                                   value, added)));
+            else if (cur.get_leaf()->hash == hash)
+            {
+                // replace the leaf with the same key, if there is one
+                auto found = false;
+                auto rest  = without(cur.get_leaf(), key, found);
+                added      = !found;
+                return branch_type::make(node, index,
+                                         child(make_leaf(hash, std::move(key), std::move(value),
+                                                         std::move(rest))));
+            }
+            else
+            {
+                auto leaf = child(make_leaf(hash, std::move(key), std::move(value), nullptr));
+                return branch_type::make(node, index,
+                                         make_pair(shift + hamt_detail::level_bits, cur,
+                                                   cur.get_leaf()->hash, std::move(leaf), hash));
+            }
+        }
+
+        // returns the replacement of the node, which might be a leaf or null
+        child erase(const branch_type& node, std::size_t shift, std::size_t hash,
+                    const Key& key, bool& removed) const
+        {
+            auto bit = hamt_detail::index_bit(hash, shift);
+            if ((node.bitmap() & bit) == 0u)
+                return child();
+            auto index = hamt_detail::child_index(node.bitmap(), bit);
+
+            auto& cur = node.children()[index];
+            child replacement;
+            if (!cur.is_leaf())
+                replacement = erase(*cur.get_branch(), shift + hamt_detail::level_bits, hash, key,
+                                    removed);
+            else if (cur.get_leaf()->hash == hash)
+                replacement = child(without(cur.get_leaf(), key, removed));
+            if (!removed)
+                return child();
+
+            if (replacement)
+            {
+                if (shift != 0u && node.size() == 1u && replacement.is_leaf())
+                    // a branch with a single leaf isn't needed
+                    return replacement;
+                return child(branch_type::make(node, index, std::move(replacement)));
+            }
+
+            auto bitmap = node.bitmap() & ~bit;
+            if (bitmap == 0u)
+                return child();
+            else if (shift != 0u && node.size() == 2u && node.children()[1u - index].is_leaf())
+                return node.children()[1u - index];
+
+            auto result = branch_type::make(bitmap);
+            for (std::size_t i = 0; i != node.size(); ++i)
+                if (i != index)
+                    result->children()[i < index ? i : i - 1u] = node.children()[i];
+            return child(std::move(result));
+        }
+
+        packed_shared_ptr<branch_type> root_;
+        std::size_t                    size_;
+        Hash                           hash_;
+        KeyEqual                       equal_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_HAMT_MAP_HPP_INCLUDED
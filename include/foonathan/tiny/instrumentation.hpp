@@ -0,0 +1,365 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_INSTRUMENTATION_HPP_INCLUDED
+#define FOONATHAN_TINY_INSTRUMENTATION_HPP_INCLUDED
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/config.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <typename Integer, std::size_t Begin, std::size_t End>
+    class bit_view;
+
+    template <class BitView, typename Integer>
+    struct joined_bit_view_tag;
+
+    /// The number of accesses counted by the instrumentation.
+    ///
+    /// They are only counted if `FOONATHAN_TINY_ENABLE_INSTRUMENTATION` is `1`,
+    /// otherwise they are always zero.
+    struct access_count
+    {
+        /// The number of times the bits were extracted.
+        std::uint64_t reads;
+        /// The number of times the bits were put.
+        std::uint64_t writes;
+        /// The number of reads and writes that had to access more than one word.
+        std::uint64_t straddling;
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        //=== straddles_words ===//
+        // whether or not an access through the view touches more than one word
+        template <class BitView>
+        struct straddles_words;
+
+        template <typename Integer, std::size_t Begin, std::size_t End>
+        struct straddles_words<bit_view<Integer, Begin, End>> : std::false_type
+        {};
+
+        template <typename Integer, std::size_t N, std::size_t Begin, std::size_t End>
+        struct straddles_words<bit_view<Integer[N], Begin, End>>
+        : std::integral_constant<bool,
+                                 bit_view<Integer[N], Begin, End>::size() != 0u
+                                     && bit_view<Integer[N], Begin, End>::begin()
+                                                / (sizeof(Integer) * CHAR_BIT)
+                                            != (bit_view<Integer[N], Begin, End>::end() - 1u)
+                                                   / (sizeof(Integer) * CHAR_BIT)>
+        {};
+
+        template <class Tail, typename Integer, std::size_t Begin, std::size_t End>
+        struct straddles_words<bit_view<joined_bit_view_tag<Tail, Integer>, Begin, End>>
+        : std::true_type
+        {};
+
+        //=== mutable_bit_view ===//
+        // the view to non-const, so reads and writes are counted together
+        template <class BitView>
+        struct mutable_bit_view;
+
+        template <typename Integer, std::size_t Begin, std::size_t End>
+        struct mutable_bit_view<bit_view<Integer, Begin, End>>
+        {
+            using type = bit_view<typename std::remove_const<Integer>::type, Begin, End>;
+        };
+
+        template <typename Integer, std::size_t N, std::size_t Begin, std::size_t End>
+        struct mutable_bit_view<bit_view<Integer[N], Begin, End>>
+        {
+            using type = bit_view<typename std::remove_const<Integer>::type[N], Begin, End>;
+        };
+
+        template <class Tail, typename Integer, std::size_t Begin, std::size_t End>
+        struct mutable_bit_view<bit_view<joined_bit_view_tag<Tail, Integer>, Begin, End>>
+        {
+            using type = bit_view<joined_bit_view_tag<typename mutable_bit_view<Tail>::type,
+                                                      typename std::remove_const<Integer>::type>,
+                                  Begin, End>;
+        };
+
+        //=== access_counter ===//
+        template <typename T>
+        const char* type_name() noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+            return __FUNCSIG__;
+#else
+            return "<unknown type>";
+#endif
+        }
+
+        class access_counter
+        {
+        public:
+            // view_name is only given for tiny types
+            access_counter(const char* name, const char* view_name) noexcept
+            : name_(name),
+              view_name_(view_name),
+              reads_(0),
+              writes_(0),
+              straddling_(0),
+              next_(nullptr)
+            {
+                // prepend to the list of all counters
+                auto& h = head();
+                next_   = h.load(std::memory_order_relaxed);
+                while (!h.compare_exchange_weak(next_, this, std::memory_order_release,
+                                                std::memory_order_relaxed))
+                {}
+            }
+
+            access_counter(const access_counter&) = delete;
+            access_counter& operator=(const access_counter&) = delete;
+
+            void count_read(bool straddling) noexcept
+            {
+                reads_.fetch_add(1u, std::memory_order_relaxed);
+                if (straddling)
+                    straddling_.fetch_add(1u, std::memory_order_relaxed);
+            }
+
+            void count_write(bool straddling) noexcept
+            {
+                writes_.fetch_add(1u, std::memory_order_relaxed);
+                if (straddling)
+                    straddling_.fetch_add(1u, std::memory_order_relaxed);
+            }
+
+            void reset() noexcept
+            {
+                reads_.store(0u, std::memory_order_relaxed);
+                writes_.store(0u, std::memory_order_relaxed);
+                straddling_.store(0u, std::memory_order_relaxed);
+            }
+
+            access_count count() const noexcept
+            {
+                return {reads_.load(std::memory_order_relaxed),
+                        writes_.load(std::memory_order_relaxed),
+                        straddling_.load(std::memory_order_relaxed)};
+            }
+
+            const char* name() const noexcept
+            {
+                return name_;
+            }
+
+            const char* view_name() const noexcept
+            {
+                return view_name_;
+            }
+
+            access_counter* next() const noexcept
+            {
+                return next_;
+            }
+
+            static std::atomic<access_counter*>& head() noexcept
+            {
+                static std::atomic<access_counter*> head(nullptr);
+                return head;
+            }
+
+        private:
+            const char*                name_;
+            const char*                view_name_;
+            std::atomic<std::uint64_t> reads_, writes_, straddling_;
+            access_counter*            next_;
+        };
+
+        // the counter of all accesses through the given view type
+        template <class BitView>
+        access_counter& bit_view_access_counter() noexcept
+        {
+            static access_counter counter(type_name<BitView>(), nullptr);
+            return counter;
+        }
+
+        // the counter of all accesses to a tiny type in a storage,
+        // it is identified by the (mutable) view of its bits and all tiny types of the storage
+        template <class FieldView, class TinyTypes>
+        access_counter& field_access_counter() noexcept
+        {
+            static access_counter counter(type_name<TinyTypes>(), type_name<FieldView>());
+            return counter;
+        }
+
+        template <class BitView>
+        void count_read(access_counter& counter) noexcept
+        {
+            counter.count_read(straddles_words<BitView>::value);
+        }
+
+        template <class BitView>
+        void count_write(access_counter& counter) noexcept
+        {
+            counter.count_write(straddles_words<BitView>::value);
+        }
+
+        template <class BitView>
+        void count_bit_view_read() noexcept
+        {
+            using view = typename mutable_bit_view<BitView>::type;
+            count_read<view>(bit_view_access_counter<view>());
+        }
+
+        template <class BitView>
+        void count_bit_view_write() noexcept
+        {
+            using view = typename mutable_bit_view<BitView>::type;
+            count_write<view>(bit_view_access_counter<view>());
+        }
+
+        //=== instrumented_bit_view ===//
+        // forwards to the bit view but also counts the accesses to the tiny type
+        template <class BitView, class FieldView, class TinyTypes>
+        class instrumented_bit_view
+        {
+        public:
+            static constexpr std::size_t begin() noexcept
+            {
+                return BitView::begin();
+            }
+            static constexpr std::size_t end() noexcept
+            {
+                return BitView::end();
+            }
+            static constexpr std::size_t size() noexcept
+            {
+                return BitView::size();
+            }
+
+            explicit constexpr instrumented_bit_view(BitView view) noexcept : view_(view) {}
+
+            template <std::size_t SubBegin, std::size_t SubEnd>
+            auto subview() const noexcept -> instrumented_bit_view<
+                decltype(std::declval<BitView>().template subview<SubBegin, SubEnd>()), FieldView,
+                TinyTypes>
+            {
+                using result = instrumented_bit_view<
+                    decltype(std::declval<BitView>().template subview<SubBegin, SubEnd>()),
+                    FieldView, TinyTypes>;
+                return result(view_.template subview<SubBegin, SubEnd>());
+            }
+
+            auto operator[](std::size_t i) const noexcept -> decltype(std::declval<BitView>()[i])
+            {
+                count_read<BitView>(counter());
+                return view_[i];
+            }
+
+            std::uintmax_t extract() const noexcept
+            {
+                count_read<BitView>(counter());
+                return view_.extract();
+            }
+
+            void put(std::uintmax_t bits) const noexcept
+            {
+                count_write<BitView>(counter());
+                view_.put(bits);
+            }
+
+        private:
+            static access_counter& counter() noexcept
+            {
+                return field_access_counter<FieldView, TinyTypes>();
+            }
+
+            BitView view_;
+        };
+
+        template <class TinyTypes, class BitView>
+        constexpr instrumented_bit_view<BitView, typename mutable_bit_view<BitView>::type,
+                                        TinyTypes>
+            instrument(BitView view) noexcept
+        {
+            return instrumented_bit_view<BitView, typename mutable_bit_view<BitView>::type,
+                                         TinyTypes>(view);
+        }
+
+        // removes the function signature around the type
+        template <class Stream>
+        void print_type_name(Stream& out, const char* name)
+        {
+            auto begin = std::strstr(name, "T = ");
+            if (!begin)
+            {
+                out << name;
+                return;
+            }
+            begin += 4;
+
+            auto end = begin + std::strlen(begin);
+            if (end != begin && end[-1] == ']')
+                --end;
+            for (auto cur = begin; cur != end; ++cur)
+                out << *cur;
+        }
+    } // namespace detail
+
+    /// \returns The accesses counted through all [tiny::bit_view]() objects of the given type.
+    /// \notes Views to const and non-const are counted together.
+    template <class BitView>
+    access_count bit_view_access_count() noexcept
+    {
+        return detail::bit_view_access_counter<
+                   typename detail::mutable_bit_view<BitView>::type>()
+            .count();
+    }
+
+    /// \effects Resets all access counters to zero.
+    inline void reset_access_counts() noexcept
+    {
+        for (auto cur = detail::access_counter::head().load(std::memory_order_acquire); cur;
+             cur      = cur->next())
+            cur->reset();
+    }
+
+    /// \effects Writes all access counters that have been used to the stream,
+    /// one line for each [tiny::bit_view]() type and each tiny type in a storage.
+    ///
+    /// `out` can be anything that provides `operator<<` for strings, characters and integers,
+    /// like a `std::ostream`.
+    template <class Stream>
+    void dump_access_counts(Stream& out)
+    {
+        for (auto cur = detail::access_counter::head().load(std::memory_order_acquire); cur;
+             cur      = cur->next())
+        {
+            auto count = cur->count();
+            if (cur->view_name())
+            {
+                out << "tiny type of ";
+                detail::print_type_name(out, cur->name());
+                out << " in ";
+                detail::print_type_name(out, cur->view_name());
+            }
+            else
+            {
+                out << "bit_view ";
+                detail::print_type_name(out, cur->name());
+            }
+            out << ": " << count.reads << " reads, " << count.writes << " writes, "
+                << count.straddling << " straddling\n";
+        }
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_INSTRUMENTATION_HPP_INCLUDED
@@ -0,0 +1,248 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_LAYOUT_REPORT_HPP_INCLUDED
+#define FOONATHAN_TINY_LAYOUT_REPORT_HPP_INCLUDED
+
+#include <climits>
+
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// The layout of a single tiny type in a storage.
+    ///
+    /// A word is one element of the memory the storage uses,
+    /// i.e. a byte for [tiny::tiny_storage]() and an integer for [tiny::word_tiny_storage]().
+    struct field_layout
+    {
+        /// The offset in bits from the beginning of the storage.
+        std::size_t offset;
+        /// The number of bits of the tiny type.
+        std::size_t bit_size;
+        /// The number of words that need to be accessed to read or write it.
+        std::size_t words;
+        /// Whether or not the bits cross a byte boundary.
+        bool straddles_byte;
+        /// Whether or not the bits cross a word boundary, so are not accessed by a single load.
+        bool straddles_word;
+        /// Whether or not writing needs to preserve other bits in the words,
+        /// so they have to be loaded first.
+        bool read_modify_write;
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        constexpr bool straddles(std::size_t begin, std::size_t end, std::size_t unit) noexcept
+        {
+            return begin != end && begin / unit != (end - 1u) / unit;
+        }
+
+        template <class BitView>
+        struct view_layout;
+
+        // one integer
+        template <typename Integer, std::size_t Begin, std::size_t End>
+        struct view_layout<bit_view<Integer, Begin, End>>
+        {
+            using view = bit_view<Integer, Begin, End>;
+
+            static constexpr std::size_t word_bits      = sizeof(Integer) * CHAR_BIT;
+            static constexpr std::size_t words          = view::size() == 0u ? 0u : 1u;
+            static constexpr bool        straddles_byte = straddles(view::begin(), view::end(),
+                                                             CHAR_BIT);
+            static constexpr bool        straddles_word = false;
+            static constexpr bool read_modify_write = words != 0u && view::size() != word_bits;
+        };
+
+        // array of integers
+        template <typename Integer, std::size_t N, std::size_t Begin, std::size_t End>
+        struct view_layout<bit_view<Integer[N], Begin, End>>
+        {
+            using view = bit_view<Integer[N], Begin, End>;
+
+            static constexpr std::size_t word_bits = sizeof(Integer) * CHAR_BIT;
+            static constexpr std::size_t words
+                = view::size() == 0u ? 0u
+                                     : (view::end() - 1u) / word_bits - view::begin() / word_bits
+                                           + 1u;
+            static constexpr bool straddles_byte
+                = straddles(view::begin(), view::end(), CHAR_BIT);
+            static constexpr bool straddles_word = words > 1u;
+            static constexpr bool read_modify_write
+                = words != 0u && (view::begin() % word_bits != 0u || view::end() % word_bits != 0u);
+        };
+
+        // one integer followed by the tail view
+        template <class Tail, typename Integer, std::size_t Begin, std::size_t End>
+        struct view_layout<bit_view<joined_bit_view_tag<Tail, Integer>, Begin, End>>
+        {
+            using head = view_layout<bit_view<Integer, Begin, End>>;
+            using tail = view_layout<Tail>;
+
+            static constexpr std::size_t words = head::words + tail::words;
+            // the parts are separate memory locations
+            static constexpr bool straddles_byte    = true;
+            static constexpr bool straddles_word    = true;
+            static constexpr bool read_modify_write = head::read_modify_write
+                                                      || tail::read_modify_write;
+        };
+
+        template <std::size_t Words>
+        struct field_words_are
+        {
+            template <std::size_t Max>
+            struct but_expected_at_most
+            {
+                static_assert(Words <= Max, "field touches more words than expected");
+                static constexpr bool value = true;
+            };
+        };
+
+        template <class Storage, class TinyTypes, class Indices>
+        struct layout_report_impl;
+
+        template <class Storage, class... TinyTypes, std::size_t... Indices>
+        struct layout_report_impl<Storage, tiny_types<TinyTypes...>, index_sequence<Indices...>>
+        {
+            template <std::size_t I>
+            using view_of = decltype(std::declval<const Storage&>().template bits_of<I>());
+
+            template <std::size_t I>
+            static constexpr field_layout make_field() noexcept
+            {
+                return {tiny_storage_detail::offset_of<std::integral_constant<std::size_t, I>,
+                                                       TinyTypes...>(),
+                        view_of<I>::size(),
+                        view_layout<view_of<I>>::words,
+                        view_layout<view_of<I>>::straddles_byte,
+                        view_layout<view_of<I>>::straddles_word,
+                        view_layout<view_of<I>>::read_modify_write};
+            }
+
+            // one more, so the array isn't empty
+            static constexpr field_layout fields[] = {make_field<Indices>()...,
+                                                      field_layout{0u, 0u, 0u, false, false, false}};
+        };
+
+        template <class Storage, class... TinyTypes, std::size_t... Indices>
+        constexpr field_layout layout_report_impl<Storage, tiny_types<TinyTypes...>,
+                                                  index_sequence<Indices...>>::fields[];
+    } // namespace detail
+
+    /// The layout of the tiny types in a storage.
+    ///
+    /// It describes where each tiny type is stored and how many memory accesses are needed,
+    /// so layouts can be compared and checked using `static_assert()`,
+    /// e.g. `static_assert(layout_report<S>::field(2).words == 1, "hot field too expensive")`.
+    /// \requires `Storage` must be a [tiny::basic_tiny_storage](),
+    /// like [tiny::tiny_storage](), [tiny::word_tiny_storage]() or [tiny::padding_tiny_storage]().
+    template <class Storage>
+    class layout_report
+    {
+        using tiny_types = decltype(tiny_storage_detail::tiny_types_of(std::declval<const Storage&>()));
+
+        template <class TinyTypes>
+        struct field_count_of;
+        template <class... TinyTypes>
+        struct field_count_of<tiny::tiny_types<TinyTypes...>>
+        : std::integral_constant<std::size_t, sizeof...(TinyTypes)>
+        {};
+
+        template <class TinyTypes>
+        struct used_bits_of;
+        template <class... TinyTypes>
+        struct used_bits_of<tiny::tiny_types<TinyTypes...>>
+        : std::integral_constant<std::size_t, total_bit_size<TinyTypes...>()>
+        {};
+
+        using impl = detail::layout_report_impl<
+            Storage, tiny_types, detail::make_index_sequence<field_count_of<tiny_types>::value>>;
+
+    public:
+        /// \returns The number of tiny types.
+        static constexpr std::size_t field_count() noexcept
+        {
+            return field_count_of<tiny_types>::value;
+        }
+
+        /// \returns The layout of the tiny type at the given index.
+        /// \requires `i < field_count()`.
+        static constexpr field_layout field(std::size_t i) noexcept
+        {
+            return impl::fields[i];
+        }
+
+        /// \returns The number of bits used by the tiny types.
+        static constexpr std::size_t used_bits() noexcept
+        {
+            return used_bits_of<tiny_types>::value;
+        }
+
+        /// \returns The number of bits in the storage that are not used by any tiny type.
+        static constexpr std::size_t wasted_bits() noexcept
+        {
+            return decltype(std::declval<const Storage&>().spare_bits())::size();
+        }
+
+        /// \returns The maximal number of words that need to be accessed for a single tiny type.
+        static constexpr std::size_t max_words() noexcept
+        {
+            return max_words(0u, 0u);
+        }
+
+    private:
+        static constexpr std::size_t max_words(std::size_t i, std::size_t result) noexcept
+        {
+            return i == field_count() ? result
+                                      : max_words(i + 1u, impl::fields[i].words > result
+                                                              ? impl::fields[i].words
+                                                              : result);
+        }
+    };
+
+    /// Checks that the tiny type at the given `Index` of `Storage` touches at most `MaxWords` words.
+    ///
+    /// The function will always return `true`, but if the tiny type needs more words,
+    /// it will trigger a `static_assert()` where the instantiation will contain the actual number,
+    /// just like [tiny::check_size]().
+    template <class Storage, std::size_t Index, std::size_t MaxWords>
+    constexpr bool check_field_words() noexcept
+    {
+        static_assert(Index < layout_report<Storage>::field_count(), "index out of range");
+        return detail::field_words_are<layout_report<Storage>::field(Index).words>::
+            template but_expected_at_most<MaxWords>::value;
+    }
+
+    /// Writes a human readable version of the [tiny::layout_report]() to the stream.
+    ///
+    /// `out` can be anything that provides `operator<<` for strings and integers,
+    /// like a `std::ostream`.
+    template <class Storage, class Stream>
+    void print_layout_report(Stream& out)
+    {
+        using report = layout_report<Storage>;
+        for (std::size_t i = 0; i != report::field_count(); ++i)
+        {
+            auto field = report::field(i);
+            out << "field " << i << ": bits [" << field.offset << ", "
+                << field.offset + field.bit_size << "), " << field.words << " word(s)";
+            if (field.straddles_word)
+                out << ", straddles word";
+            else if (field.straddles_byte)
+                out << ", straddles byte";
+            if (field.read_modify_write)
+                out << ", read-modify-write";
+            out << "\n";
+        }
+        out << "used bits: " << report::used_bits() << ", wasted bits: " << report::wasted_bits()
+            << "\n";
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_LAYOUT_REPORT_HPP_INCLUDED
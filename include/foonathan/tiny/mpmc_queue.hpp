@@ -0,0 +1,269 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_MPMC_QUEUE_HPP_INCLUDED
+#define FOONATHAN_TINY_MPMC_QUEUE_HPP_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace mpmc_detail
+    {
+        enum class slot_state
+        {
+            empty,
+            writing,
+            full,
+            reading,
+
+            _unsigned_count,
+        };
+
+        constexpr std::size_t   sequence_bits = 62u;
+        constexpr std::uint64_t sequence_mask = (std::uint64_t(1) << sequence_bits) - 1u;
+
+        // the sequence and the state of a slot, updated with a single compare and swap
+        using slot_metadata
+            = word_tiny_storage<tiny_unsigned<sequence_bits, std::uint64_t>, tiny_enum<slot_state>>;
+
+        inline slot_metadata make_metadata(std::uint64_t position, slot_state state) noexcept
+        {
+            return slot_metadata(position & sequence_mask, state);
+        }
+
+        // the sequence only has 62 bits, so it is compared modulo 2^62
+        inline std::int64_t distance(std::uint64_t sequence, std::uint64_t position) noexcept
+        {
+            constexpr auto size = std::int64_t(sequence_mask) + 1;
+            auto           diff = std::int64_t((sequence - position) & sequence_mask);
+            return diff < size / 2 ? diff : diff - size;
+        }
+
+        // assumes 64 byte cache lines
+        constexpr std::size_t cache_line = 64u;
+    } // namespace mpmc_detail
+
+    /// A bounded, lock-free queue for multiple producers and multiple consumers.
+    ///
+    /// The objects are stored in a ring buffer of slots.
+    /// Every slot has a metadata word, a [tiny::word_tiny_storage]() of a 62 bit sequence number,
+    /// the position in the queue the slot is used for next, and a [tiny::tiny_enum]() state
+    /// telling whether it is empty, being written, full or being read.
+    /// As they're in a single word stored in a `std::atomic`,
+    /// a producer or consumer claims a slot with a single compare and swap that checks both.
+    /// Afterwards the shared position is advanced,
+    /// which other threads help with if they find the slot claimed,
+    /// so no thread ever waits for another one.
+    ///
+    /// \requires `T` must be nothrow move constructible and nothrow move assignable.
+    /// \notes The queue is only lock-free if `std::atomic` of the metadata word is,
+    /// this can be checked with `is_lock_free()`.
+    template <typename T>
+    class mpmc_queue
+    {
+        static_assert(std::is_nothrow_move_constructible<T>::value
+                          && std::is_nothrow_move_assignable<T>::value,
+                      "T must be nothrow movable");
+
+        using slot_state = mpmc_detail::slot_state;
+        using metadata   = mpmc_detail::slot_metadata;
+        static_assert(sizeof(metadata) == sizeof(std::uint64_t), "metadata must be a single word");
+
+        struct slot
+        {
+            std::atomic<metadata>                                      state;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+            T& object() noexcept
+            {
+                return *static_cast<T*>(static_cast<void*>(&storage));
+            }
+        };
+
+    public:
+        using value_type = T;
+
+        //=== constructors ===//
+        /// \effects Creates an empty queue with at least the given capacity,
+        /// rounded up to a power of two.
+        /// \requires `capacity > 0`.
+        explicit mpmc_queue(std::size_t capacity)
+        : mask_(round_capacity(capacity) - 1u), slots_(new slot[mask_ + 1u])
+        {
+            for (std::size_t i = 0; i != mask_ + 1u; ++i)
+                slots_[i].state.store(mpmc_detail::make_metadata(i, slot_state::empty),
+                                      std::memory_order_relaxed);
+            push_position_.store(0u, std::memory_order_relaxed);
+            pop_position_.store(0u, std::memory_order_relaxed);
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        /// \effects Destroys all objects still in the queue.
+        /// \requires No other thread accesses the queue.
+        ~mpmc_queue() noexcept
+        {
+            for (std::size_t i = 0; i != mask_ + 1u; ++i)
+            {
+                auto state = slots_[i].state.load(std::memory_order_acquire);
+                if (state.template at<1>() == slot_state::full)
+                    slots_[i].object().~T();
+            }
+        }
+
+        //=== accessors ===//
+        /// \returns The number of objects that can be stored.
+        std::size_t capacity() const noexcept
+        {
+            return mask_ + 1u;
+        }
+
+        /// \returns The number of objects in the queue.
+        /// \notes If other threads modify the queue concurrently,
+        /// it might already be outdated.
+        std::size_t size_approx() const noexcept
+        {
+            auto pop  = pop_position_.load(std::memory_order_relaxed);
+            auto push = push_position_.load(std::memory_order_relaxed);
+            return push > pop ? std::size_t(push - pop) : 0u;
+        }
+
+        /// \returns Whether or not the atomic operations of the queue are lock-free.
+        bool is_lock_free() const noexcept
+        {
+            return slots_[0].state.is_lock_free() && push_position_.is_lock_free()
+                   && pop_position_.is_lock_free();
+        }
+
+        //=== modifiers ===//
+        /// \effects Appends the object to the queue, unless it is full.
+        /// \returns Whether or not the object has been added.
+        /// \notes The rvalue overload only moves from the object if it has been added.
+        /// \group push
+        bool try_push(const T& obj)
+        {
+            T copy(obj);
+            return try_push(std::move(copy));
+        }
+        /// \group push
+        bool try_push(T&& obj) noexcept
+        {
+            auto position = push_position_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& cur      = slots_[position & mask_];
+                auto  state    = cur.state.load(std::memory_order_acquire);
+                auto  distance = mpmc_detail::distance(state.template at<0>(), position);
+                if (distance < 0)
+                    // the slot still has an object from the previous round
+                    return false;
+                else if (distance == 0 && state.template at<1>() == slot_state::empty)
+                {
+                    auto writing = mpmc_detail::make_metadata(position, slot_state::writing);
+                    if (cur.state.compare_exchange_weak(state, writing, std::memory_order_acquire,
+                                                        std::memory_order_relaxed))
+                    {
+                        advance(push_position_, position);
+                        ::new (static_cast<void*>(&cur.storage)) T(std::move(obj));
+                        cur.state.store(mpmc_detail::make_metadata(position, slot_state::full),
+                                        std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (distance == 0)
+                    // another producer has claimed the slot but not yet advanced the position
+                    advance(push_position_, position);
+
+                position = push_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        /// \effects Removes the first object of the queue and assigns it to `result`,
+        /// unless the queue is empty.
+        /// \returns Whether or not an object has been removed.
+        /// \notes It also returns `false` if the first object is still being pushed,
+        /// or if its slot is still being read by a consumer of the previous round.
+        bool try_pop(T& result) noexcept
+        {
+            auto position = pop_position_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& cur      = slots_[position & mask_];
+                auto  state    = cur.state.load(std::memory_order_acquire);
+                auto  distance = mpmc_detail::distance(state.template at<0>(), position);
+                if (distance < 0)
+                    // the slot is still being read in the previous round,
+                    // the position can't advance until that consumer is done
+                    return false;
+                else if (distance == 0 && state.template at<1>() == slot_state::full)
+                {
+                    auto reading = mpmc_detail::make_metadata(position, slot_state::reading);
+                    if (cur.state.compare_exchange_weak(state, reading, std::memory_order_acquire,
+                                                        std::memory_order_relaxed))
+                    {
+                        advance(pop_position_, position);
+                        result = std::move(cur.object());
+                        cur.object().~T();
+                        // ready for the push in the next round
+                        cur.state.store(mpmc_detail::make_metadata(position + capacity(),
+                                                                   slot_state::empty),
+                                        std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (distance == 0 && state.template at<1>() == slot_state::reading)
+                    // another consumer has claimed the slot but not yet advanced the position
+                    advance(pop_position_, position);
+                else if (distance == 0)
+                    // no object has been pushed to the slot yet
+                    return false;
+
+                position = pop_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static std::size_t round_capacity(std::size_t capacity) noexcept
+        {
+            DEBUG_ASSERT(capacity > 0u, detail::precondition_handler{}, "capacity must not be 0");
+            auto result = std::size_t(1);
+            while (result < capacity)
+                result *= 2u;
+            return result;
+        }
+
+        // does nothing if another thread has already advanced it
+        static void advance(std::atomic<std::uint64_t>& position, std::uint64_t expected) noexcept
+        {
+            position.compare_exchange_strong(expected, expected + 1u, std::memory_order_relaxed);
+        }
+
+        std::size_t              mask_;
+        std::unique_ptr<slot[]> slots_;
+
+        // on separate cache lines, so producers and consumers don't interfere,
+        // padding instead of alignas, as new doesn't respect over-alignment before C++17
+        std::atomic<std::uint64_t> push_position_;
+        char                       padding_[mpmc_detail::cache_line];
+        std::atomic<std::uint64_t> pop_position_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_MPMC_QUEUE_HPP_INCLUDED
@@ -5,8 +5,11 @@
 #ifndef FOONATHAN_TINY_OPTIONAL_IMPL_HPP_INCLUDED
 #define FOONATHAN_TINY_OPTIONAL_IMPL_HPP_INCLUDED
 
+#include <cstring>
+#include <new>
 #include <type_traits>
 
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_bool.hpp>
 #include <foonathan/tiny/tombstone.hpp>
 
@@ -159,6 +162,10 @@ namespace tiny
 
             static constexpr std::size_t tombstone_count = tombstone_traits<T>::tombstone_count - 1;
 
+            // the storage only consists of the storage of T
+            static constexpr bool constant_tombstone_pattern
+                = has_constant_tombstone_pattern<T>::value;
+
             static void create_tombstone(storage_type& storage,
                                          std::size_t   tombstone_index) noexcept
             {
@@ -234,12 +241,118 @@ namespace tiny
         };
     } // namespace opt_detail
 
+    /// \exclude
+    namespace opt_detail
+    {
+        // an empty optional is a constant byte pattern, so it can be copied into the range
+        template <typename T>
+        void fill_empty(std::true_type, optional_impl<T>* begin, optional_impl<T>* end) noexcept
+        {
+            if (begin == end)
+                return;
+
+            ::new (static_cast<void*>(begin)) optional_impl<T>();
+            auto pattern = reinterpret_cast<const unsigned char*>(begin);
+
+            auto all_same = true;
+            for (auto i = 1u; i != sizeof(optional_impl<T>); ++i)
+                if (pattern[i] != pattern[0])
+                {
+                    all_same = false;
+                    break;
+                }
+
+            auto size = std::size_t(end - begin);
+            if (all_same)
+                std::memset(static_cast<void*>(begin + 1), pattern[0],
+                            (size - 1u) * sizeof(optional_impl<T>));
+            else
+            {
+                // replicate the pattern into a block of about a page that stays in cache,
+                // then copy the block, so the range is only written and not read again
+                constexpr auto block_size = 4096u / sizeof(optional_impl<T>) + 1u;
+
+                auto done = std::size_t(1u);
+                for (; done < size && done < block_size; ++done)
+                    std::memcpy(static_cast<void*>(begin + done), static_cast<const void*>(begin),
+                                sizeof(optional_impl<T>));
+                for (; done < size; done += block_size)
+                {
+                    auto count = block_size < size - done ? block_size : size - done;
+                    std::memcpy(static_cast<void*>(begin + done), static_cast<const void*>(begin),
+                                count * sizeof(optional_impl<T>));
+                }
+            }
+        }
+
+        template <typename T>
+        void fill_empty(std::false_type, optional_impl<T>* begin, optional_impl<T>* end) noexcept
+        {
+            for (auto cur = begin; cur != end; ++cur)
+                ::new (static_cast<void*>(cur)) optional_impl<T>();
+        }
+
+        template <typename T>
+        void destroy_all(std::true_type, optional_impl<T>* begin, optional_impl<T>* end) noexcept
+        {
+            // nothing to destroy, so just overwrite it
+            fill_empty(begin, end);
+        }
+
+        template <typename T>
+        void destroy_all(std::false_type, optional_impl<T>* begin, optional_impl<T>* end) noexcept
+        {
+            for (auto cur = begin; cur != end; ++cur)
+                if (cur->has_value())
+                    cur->destroy_value();
+        }
+    } // namespace opt_detail
+
+    /// \effects Makes all optionals in the range `[begin, end)` empty,
+    /// as if each one was default constructed again.
+    ///
+    /// If the empty state is a constant byte pattern,
+    /// i.e. it is compressed and `T` has a [tiny::has_constant_tombstone_pattern](),
+    /// it is created once and then copied into the entire range with `std::memset()` or
+    /// `std::memcpy()`, instead of creating the tombstone for each element.
+    /// \requires The range must be an array of optionals or of properly aligned memory for them.
+    /// \notes This will leak the values that are currently stored, use [tiny::destroy_all]()
+    /// instead.
+    template <typename T>
+    void fill_empty(optional_impl<T>* begin, optional_impl<T>* end) noexcept
+    {
+        using is_constant
+            = std::integral_constant<bool, optional_impl<T>::is_compressed::value
+                                               && has_constant_tombstone_pattern<T>::value>;
+        opt_detail::fill_empty(is_constant{}, begin, end);
+    }
+
+    /// \effects Destroys all values that are stored in the optionals in the range `[begin, end)`,
+    /// so all of them are empty afterwards.
+    ///
+    /// If the value type is trivially destructible, the values don't need to be visited,
+    /// and it is the same as [tiny::fill_empty]().
+    template <typename T>
+    void destroy_all(optional_impl<T>* begin, optional_impl<T>* end) noexcept
+    {
+        using value_type = typename optional_impl<T>::value_type;
+        opt_detail::destroy_all(std::is_trivially_destructible<value_type>{}, begin, end);
+    }
+
     /// Specialization of the tombstone traits for [tiny::optional_impl]().
     template <typename T>
     struct tombstone_traits<optional_impl<T>>
     : std::conditional<(tombstone_traits<T>::tombstone_count > 0), opt_detail::compressed_traits<T>,
                        opt_detail::uncompressed_traits<T>>::type
     {};
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::optional_impl]().
+    ///
+    /// It is trivially relocatable if the value type is, even though it is not movable.
+    template <typename T>
+    struct is_trivially_relocatable<optional_impl<T>>
+    : is_trivially_relocatable<typename optional_impl<T>::value_type>
+    {};
 } // namespace tiny
 } // namespace foonathan
 
@@ -0,0 +1,438 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_PACKED_COLUMN_HPP_INCLUDED
+#define FOONATHAN_TINY_PACKED_COLUMN_HPP_INCLUDED
+
+#include <vector>
+
+#include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/bit_ops.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_type.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    //=== ordered_tiny_traits ===//
+    /// Traits that specify whether the bits of a tiny type are ordered like its objects.
+    ///
+    /// If `is_ordered` is `true`, the stored bits of an object `obj` are the unsigned integer
+    /// `obj - min_value()` and `max_value()` is the maximal object.
+    /// The kernels of [tiny::packed_column]() can then evaluate range predicates directly on the
+    /// stored bits.
+    /// It is specialized for [tiny::tiny_unsigned]() and [tiny::tiny_int_range]().
+    template <class TinyType>
+    struct ordered_tiny_traits
+    {
+        static constexpr bool is_ordered = false;
+    };
+
+    template <std::size_t Bits, typename Integer>
+    struct ordered_tiny_traits<tiny_unsigned<Bits, Integer>>
+    {
+        static constexpr bool is_ordered = true;
+
+        static constexpr std::intmax_t min_value() noexcept
+        {
+            return 0;
+        }
+        static constexpr std::intmax_t max_value() noexcept
+        {
+            return std::intmax_t((1ull << Bits) - 1u);
+        }
+    };
+
+    template <std::intmax_t Min, std::intmax_t Max, typename Integer>
+    struct ordered_tiny_traits<tiny_int_range<Min, Max, Integer>>
+    {
+        static constexpr bool is_ordered = true;
+
+        static constexpr std::intmax_t min_value() noexcept
+        {
+            return Min;
+        }
+        static constexpr std::intmax_t max_value() noexcept
+        {
+            return Max;
+        }
+    };
+
+    /// A half-open range of values `[lower, upper)`, used as predicate for the kernels of
+    /// [tiny::packed_column]().
+    struct value_range
+    {
+        std::intmax_t lower, upper;
+    };
+
+    /// \returns The range `[lower, upper)`.
+    constexpr value_range in_range(std::intmax_t lower, std::intmax_t upper) noexcept
+    {
+        return {lower, upper};
+    }
+
+    /// \returns The range that only contains `value`.
+    constexpr value_range equal_to(std::intmax_t value) noexcept
+    {
+        return {value, value + 1};
+    }
+
+    /// \exclude
+    namespace detail
+    {
+        constexpr std::uint64_t repeat_lane(std::uint64_t value, std::size_t bits,
+                                            std::size_t count) noexcept
+        {
+            return count == 0u ? 0u : (repeat_lane(value, bits, count - 1u) << bits) | value;
+        }
+
+        // a word consisting of lanes of `Bits` bits each,
+        // the remaining high bits of the word are always zero
+        template <std::size_t Bits>
+        struct packed_lanes
+        {
+            static_assert(0u < Bits && Bits < 64u, "invalid lane size");
+
+            static constexpr std::size_t   count     = 64u / Bits;
+            static constexpr std::uint64_t lane_mask = (std::uint64_t(1) << Bits) - 1u;
+            // the lowest/highest bit of each lane set
+            static constexpr std::uint64_t low_bits  = repeat_lane(1u, Bits, count);
+            static constexpr std::uint64_t high_bits = low_bits << (Bits - 1u);
+
+            static std::uint64_t broadcast(std::uint64_t value) noexcept
+            {
+                return value * low_bits;
+            }
+
+            // the high bit of each lane is set if the lane of x is greater or equal to the lane
+            // of y
+            static std::uint64_t greater_equal(std::uint64_t x, std::uint64_t y) noexcept
+            {
+                // compute the difference of the lower bits in each lane,
+                // setting the high bit ensures it doesn't borrow from the next lane
+                auto diff = (x | high_bits) - (y & ~high_bits);
+                // if the high bits differ, x is greater iff it has the high bit set,
+                // otherwise, it is greater iff the difference of the lower bits didn't borrow
+                return ((x & ~y) | (~(x ^ y) & diff)) & high_bits;
+            }
+
+            // turns the high bit of each lane into a mask of the entire lane
+            static std::uint64_t expand(std::uint64_t high) noexcept
+            {
+                return (high - (high >> (Bits - 1u))) | high;
+            }
+
+            // the high bits of the first n lanes
+            static std::uint64_t first_high_bits(std::size_t n) noexcept
+            {
+                return n == count ? high_bits : high_bits & ((std::uint64_t(1) << (n * Bits)) - 1u);
+            }
+        };
+    } // namespace detail
+
+    template <class TinyType>
+    class packed_column;
+
+    /// \exclude
+    namespace detail
+    {
+        template <class TinyType>
+        struct packed_column_kernels;
+    } // namespace detail
+
+    /// A column of tiny types, packed into 64 bit words.
+    ///
+    /// Each word stores `64 / TinyType::bit_size()` objects in lanes,
+    /// an object never spans multiple words.
+    /// This allows the kernels like [tiny::count_if]() to process all lanes of a word at once,
+    /// without decoding individual objects.
+    template <class TinyType>
+    class packed_column
+    {
+        static_assert(is_tiny_type<TinyType>::value, "must be a tiny type");
+
+        using lanes = detail::packed_lanes<TinyType::bit_size()>;
+
+    public:
+        using tiny_type   = TinyType;
+        using object_type = typename TinyType::object_type;
+
+        /// The number of objects that are stored in a single word.
+        static constexpr std::size_t objects_per_word = lanes::count;
+
+        //=== constructors ===//
+        /// \effects Creates an empty column.
+        packed_column() noexcept : size_(0u) {}
+
+        //=== accessors ===//
+        /// \returns The number of objects.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no objects.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The object at the given index.
+        /// \requires `i < size()`.
+        object_type operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            return decode(lane(i));
+        }
+
+        //=== modifiers ===//
+        /// \effects Reserves memory for the given number of objects.
+        void reserve(std::size_t size)
+        {
+            words_.reserve((size + lanes::count - 1u) / lanes::count);
+        }
+
+        /// \effects Appends the object.
+        void push_back(const object_type& obj)
+        {
+            if (size_ % lanes::count == 0u)
+                words_.push_back(0u);
+            ++size_;
+            set(size_ - 1u, obj);
+        }
+
+        /// \effects Changes the object at the given index.
+        /// \requires `i < size()`.
+        void set(std::size_t i, const object_type& obj) noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            auto& word  = words_[i / lanes::count];
+            auto  shift = (i % lanes::count) * TinyType::bit_size();
+            word        = (word & ~(lanes::lane_mask << shift)) | (encode(obj) << shift);
+        }
+
+        /// \effects Removes all objects.
+        void clear() noexcept
+        {
+            words_.clear();
+            size_ = 0u;
+        }
+
+    private:
+        static std::uint64_t encode(const object_type& obj) noexcept
+        {
+            std::uint64_t bits = 0;
+            make_tiny_proxy<TinyType>(make_bit_view<0, TinyType::bit_size()>(bits)) = obj;
+            return bits;
+        }
+
+        static object_type decode(std::uint64_t bits) noexcept
+        {
+            const auto& cbits = bits;
+            return make_tiny_proxy<TinyType>(make_bit_view<0, TinyType::bit_size()>(cbits));
+        }
+
+        std::uint64_t lane(std::size_t i) const noexcept
+        {
+            auto shift = (i % lanes::count) * TinyType::bit_size();
+            return (words_[i / lanes::count] >> shift) & lanes::lane_mask;
+        }
+
+        // invariant: unused lanes and bits are zero
+        std::vector<std::uint64_t> words_;
+        std::size_t                size_;
+
+        friend detail::packed_column_kernels<TinyType>;
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        template <class TinyType>
+        struct packed_column_kernels
+        {
+            using column = packed_column<TinyType>;
+            using lanes  = packed_lanes<TinyType::bit_size()>;
+            using traits = ordered_tiny_traits<TinyType>;
+            static_assert(traits::is_ordered,
+                          "kernels require a tiny type whose bits are ordered like the objects");
+
+            static constexpr std::uint64_t value_count() noexcept
+            {
+                return std::uint64_t(traits::max_value() - traits::min_value()) + 1u;
+            }
+
+            // the stored bits of the smallest object not less than value,
+            // or value_count() if there is none
+            static std::uint64_t lower_bound(std::intmax_t value) noexcept
+            {
+                if (value <= traits::min_value())
+                    return 0u;
+                else if (value > traits::max_value())
+                    return value_count();
+                else
+                    return std::uint64_t(value - traits::min_value());
+            }
+
+            // invokes f(word_index, matches) where matches has the high bit of each matching lane
+            // set
+            template <typename Fn>
+            static void match(const column& c, value_range range, Fn f)
+            {
+                auto lower = lower_bound(range.lower);
+                auto upper = lower_bound(range.upper);
+                if (lower >= upper)
+                    return;
+                else if (lower == 0u && upper == value_count())
+                    match(c, f, [](std::uint64_t) { return lanes::high_bits; });
+                else if (lower == 0u)
+                    match(c, f, [&](std::uint64_t word) {
+                        return ~lanes::greater_equal(word, lanes::broadcast(upper));
+                    });
+                else if (upper == value_count())
+                    match(c, f, [&](std::uint64_t word) {
+                        return lanes::greater_equal(word, lanes::broadcast(lower));
+                    });
+                else
+                    match(c, f, [&](std::uint64_t word) {
+                        return lanes::greater_equal(word, lanes::broadcast(lower))
+                               & ~lanes::greater_equal(word, lanes::broadcast(upper));
+                    });
+            }
+
+            template <typename Fn, typename Predicate>
+            static void match(const column& c, Fn f, Predicate pred)
+            {
+                auto full = c.size_ / lanes::count;
+                for (std::size_t i = 0; i != full; ++i)
+                    f(i, pred(c.words_[i]) & lanes::high_bits);
+
+                if (auto rest = c.size_ % lanes::count)
+                    f(full, pred(c.words_[full]) & lanes::first_high_bits(rest));
+            }
+
+            static std::size_t count_if(const column& c, value_range range) noexcept
+            {
+                std::size_t result = 0;
+                match(c, range, [&](std::size_t, std::uint64_t matches) {
+                    result += popcount(matches);
+                });
+                return result;
+            }
+
+            static std::vector<std::size_t> select_indices(const column& c, value_range range)
+            {
+                std::vector<std::size_t> result;
+                match(c, range, [&](std::size_t word, std::uint64_t matches) {
+                    for (; matches != 0u; matches &= matches - 1u)
+                        result.push_back(word * lanes::count
+                                         + count_trailing_zeros(matches) / TinyType::bit_size());
+                });
+                return result;
+            }
+
+            template <bool Min>
+            static std::uint64_t extremum(const column& c) noexcept
+            {
+                DEBUG_ASSERT(!c.empty(), precondition_handler{}, "column must not be empty");
+
+                // lane-wise extremum of all words that are full
+                auto full = c.size_ / lanes::count;
+                auto acc  = full == 0u ? 0u : c.words_[0];
+                for (std::size_t i = 1u; i < full; ++i)
+                {
+                    auto word = c.words_[i];
+                    // mask of the lanes where the word is a better extremum
+                    auto better = Min ? lanes::greater_equal(acc, word)
+                                      : lanes::greater_equal(word, acc);
+                    auto mask   = lanes::expand(better);
+                    acc         = (word & mask) | (acc & ~mask);
+                }
+
+                // reduce the lanes and include the remaining objects
+                auto result = full == 0u ? c.lane(0) : acc & lanes::lane_mask;
+                auto update = [&](std::uint64_t value) {
+                    if (Min ? value < result : value > result)
+                        result = value;
+                };
+                for (std::size_t i = 1u; full != 0u && i != lanes::count; ++i)
+                    update((acc >> (i * TinyType::bit_size())) & lanes::lane_mask);
+                for (auto i = full * lanes::count; i != c.size_; ++i)
+                    update(c.lane(i));
+                return result;
+            }
+
+            static std::intmax_t sum(const column& c) noexcept
+            {
+                std::uint64_t result = 0;
+                for (auto word : c.words_)
+                    for (std::size_t i = 0; i != lanes::count; ++i)
+                        result += (word >> (i * TinyType::bit_size())) & lanes::lane_mask;
+                // each object was stored with an offset of min_value()
+                return std::intmax_t(result)
+                       + std::intmax_t(c.size_) * std::intmax_t(traits::min_value());
+            }
+
+            static typename column::object_type decode(std::uint64_t bits) noexcept
+            {
+                return column::decode(bits);
+            }
+        };
+    } // namespace detail
+
+    //=== kernels ===//
+    /// \returns The number of objects in the column that are in the range.
+    /// \notes The predicate is evaluated on all objects of a word at once.
+    /// \requires The [tiny::ordered_tiny_traits]() must be specialized for the tiny type.
+    template <class TinyType>
+    std::size_t count_if(const packed_column<TinyType>& column, value_range range) noexcept
+    {
+        return detail::packed_column_kernels<TinyType>::count_if(column, range);
+    }
+
+    /// \returns The indices of the objects in the column that are in the range,
+    /// in increasing order.
+    /// \notes The predicate is evaluated on all objects of a word at once.
+    /// \requires The [tiny::ordered_tiny_traits]() must be specialized for the tiny type.
+    template <class TinyType>
+    std::vector<std::size_t> select_indices(const packed_column<TinyType>& column,
+                                            value_range                    range)
+    {
+        return detail::packed_column_kernels<TinyType>::select_indices(column, range);
+    }
+
+    /// \returns The minimal object of the column.
+    /// \requires The column must not be empty,
+    /// and the [tiny::ordered_tiny_traits]() must be specialized for the tiny type.
+    template <class TinyType>
+    typename TinyType::object_type column_min(const packed_column<TinyType>& column) noexcept
+    {
+        using kernels = detail::packed_column_kernels<TinyType>;
+        return kernels::decode(kernels::template extremum<true>(column));
+    }
+
+    /// \returns The maximal object of the column.
+    /// \requires The column must not be empty,
+    /// and the [tiny::ordered_tiny_traits]() must be specialized for the tiny type.
+    template <class TinyType>
+    typename TinyType::object_type column_max(const packed_column<TinyType>& column) noexcept
+    {
+        using kernels = detail::packed_column_kernels<TinyType>;
+        return kernels::decode(kernels::template extremum<false>(column));
+    }
+
+    /// \returns The sum of all objects of the column.
+    /// \requires The sum must not overflow,
+    /// and the [tiny::ordered_tiny_traits]() must be specialized for the tiny type.
+    template <class TinyType>
+    std::intmax_t sum(const packed_column<TinyType>& column) noexcept
+    {
+        return detail::packed_column_kernels<TinyType>::sum(column);
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_PACKED_COLUMN_HPP_INCLUDED
@@ -0,0 +1,289 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_PACKED_SEQUENCE_HPP_INCLUDED
+#define FOONATHAN_TINY_PACKED_SEQUENCE_HPP_INCLUDED
+
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/detail/index_sequence.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        constexpr std::size_t packed_block_size = 128u;
+
+        // bits needed to store all values in [0, max]
+        constexpr std::size_t bit_width(std::uint64_t max) noexcept
+        {
+            return max == 0u ? 0u : ilog2(max) + 1u;
+        }
+
+        // the difference stored at the given index of a block with the given width
+        inline std::uint64_t get_packed(const std::uint64_t* words, std::size_t index,
+                                        std::size_t width) noexcept
+        {
+            auto bit   = index * width;
+            auto shift = bit % 64u;
+
+            auto result = words[bit / 64u] >> shift;
+            if (shift + width > 64u)
+                // value continues in the next word
+                result |= words[bit / 64u + 1u] << (64u - shift);
+            return width == 64u ? result : result & ((std::uint64_t(1) << width) - 1u);
+        }
+
+        template <std::size_t Width>
+        struct packed_block
+        {
+            // 64 integers of the given width need exactly Width words,
+            // unroll them, so all shifts and branches are resolved at compile-time
+            template <typename UInt, std::size_t... I>
+            static void decode64(const std::uint64_t* words, UInt base, UInt* out,
+                                 index_sequence<I...>) noexcept
+            {
+                bool for_each[]
+                    = {(out[I] = static_cast<UInt>(base + get_packed(words, I, Width)), true)...};
+                (void)for_each;
+            }
+
+            template <typename UInt>
+            static void decode(const std::uint64_t* words, UInt base, UInt* out) noexcept
+            {
+                for (std::size_t i = 0; i != packed_block_size / 64u; ++i)
+                    decode64(words + i * Width, base, out + i * 64u, make_index_sequence<64>{});
+            }
+        };
+
+        template <>
+        struct packed_block<0u>
+        {
+            template <typename UInt>
+            static void decode(const std::uint64_t*, UInt base, UInt* out) noexcept
+            {
+                for (std::size_t i = 0; i != packed_block_size; ++i)
+                    out[i] = base;
+            }
+        };
+
+        template <typename UInt>
+        using packed_block_decoder = void (*)(const std::uint64_t*, UInt, UInt*);
+
+        template <typename UInt, std::size_t... Widths>
+        packed_block_decoder<UInt> get_block_decoder(std::size_t width,
+                                                     index_sequence<Widths...>) noexcept
+        {
+            static const packed_block_decoder<UInt> decoders[]
+                = {&packed_block<Widths>::template decode<UInt>...};
+            return decoders[width];
+        }
+    } // namespace detail
+
+    /// An immutable sequence of integers compressed using frame of reference encoding.
+    ///
+    /// The integers are split into blocks of 128.
+    /// Each block stores its minimal integer as base and all integers as the difference to that
+    /// base, using the minimal number of bits required for the block.
+    /// If neighboring integers are close together, like sorted timestamps or IDs,
+    /// this uses only a couple of bits per integer.
+    ///
+    /// As every block has a fixed size, accessing an integer or seeking to a block is `O(1)`.
+    /// A block is decoded by a loop specialized for its bit width, which has no branches.
+    template <typename Integer>
+    class packed_sequence
+    {
+        static_assert(std::is_integral<Integer>::value, "must be an integer type");
+        static_assert(sizeof(Integer) <= sizeof(std::uint64_t), "integer too big");
+
+        using uint_type = typename std::make_unsigned<Integer>::type;
+
+    public:
+        using value_type = Integer;
+
+        /// The number of integers in a block.
+        static constexpr std::size_t block_size = detail::packed_block_size;
+
+        //=== constructors ===//
+        /// \effects Creates an empty sequence.
+        packed_sequence() noexcept : size_(0u) {}
+
+        /// \effects Creates a sequence containing the integers in the range `[begin, end)`.
+        template <typename InputIt>
+        packed_sequence(InputIt begin, InputIt end) : packed_sequence()
+        {
+            uint_type   block[block_size];
+            std::size_t count = 0;
+            for (auto cur = begin; cur != end; ++cur)
+            {
+                block[count++] = static_cast<uint_type>(static_cast<Integer>(*cur));
+                if (count == block_size)
+                {
+                    append_block(block, count);
+                    count = 0;
+                }
+            }
+            if (count != 0u)
+                append_block(block, count);
+        }
+
+        //=== accessors ===//
+        /// \returns The number of integers.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no integers.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The integer at the given index.
+        /// \requires `i < size()`.
+        value_type operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            auto&       header = blocks_[i / block_size];
+            auto        words  = words_.data() + header.location.template at<0>();
+            std::size_t width  = header.location.template at<1>();
+
+            std::uint64_t difference = 0u;
+            if (width != 0u)
+                difference = detail::get_packed(words, i % block_size, width);
+            return static_cast<value_type>(static_cast<uint_type>(header.base + difference));
+        }
+
+        /// \returns The index of the first integer that is not less than `value`,
+        /// or `size()` if there is none.
+        /// \requires The sequence must be sorted.
+        std::size_t lower_bound(value_type value) const noexcept
+        {
+            // the base of a sorted block is its first integer,
+            // so find the first block whose base is not less
+            std::size_t first = 0, last = blocks_.size();
+            while (first != last)
+            {
+                auto middle = first + (last - first) / 2u;
+                if (static_cast<value_type>(blocks_[middle].base) < value)
+                    first = middle + 1u;
+                else
+                    last = middle;
+            }
+            if (first == 0u)
+                return 0u;
+
+            // the result is in the previous block or the first integer of this block
+            auto begin = (first - 1u) * block_size;
+            auto end   = first * block_size < size_ ? first * block_size : size_;
+            while (begin != end)
+            {
+                auto middle = begin + (end - begin) / 2u;
+                if ((*this)[middle] < value)
+                    begin = middle + 1u;
+                else
+                    end = middle;
+            }
+            return begin;
+        }
+
+        //=== blocks ===//
+        /// \returns The number of blocks.
+        std::size_t block_count() const noexcept
+        {
+            return blocks_.size();
+        }
+
+        /// \returns The number of bits used for every integer of the given block.
+        /// \requires `block < block_count()`.
+        std::size_t block_bit_width(std::size_t block) const noexcept
+        {
+            DEBUG_ASSERT(block < blocks_.size(), detail::precondition_handler{},
+                         "block out of range");
+            return blocks_[block].location.template at<1>();
+        }
+
+        /// \effects Decodes all integers of the given block and writes them to `out`.
+        /// \returns The number of integers in the block,
+        /// which is `block_size`, unless it is the last block.
+        /// \requires `block < block_count()` and `out` must have room for `block_size` integers,
+        /// even if the block has fewer.
+        std::size_t decode_block(std::size_t block, value_type* out) const noexcept
+        {
+            DEBUG_ASSERT(block < blocks_.size(), detail::precondition_handler{},
+                         "block out of range");
+            auto& header = blocks_[block];
+            auto  words  = words_.data() + header.location.template at<0>();
+            auto  decoder
+                = detail::get_block_decoder<uint_type>(header.location.template at<1>(),
+                                                       detail::make_index_sequence<65>{});
+            decoder(words, static_cast<uint_type>(header.base), reinterpret_cast<uint_type*>(out));
+
+            auto begin = block * block_size;
+            return size_ - begin < block_size ? size_ - begin : block_size;
+        }
+
+        /// \returns The number of bytes used to store the integers and block headers.
+        std::size_t memory_usage() const noexcept
+        {
+            return words_.size() * sizeof(std::uint64_t) + blocks_.size() * sizeof(block_header);
+        }
+
+    private:
+        void append_block(uint_type* block, std::size_t count)
+        {
+            auto min = static_cast<Integer>(block[0]), max = static_cast<Integer>(block[0]);
+            for (std::size_t i = 1; i != count; ++i)
+            {
+                if (static_cast<Integer>(block[i]) < min)
+                    min = static_cast<Integer>(block[i]);
+                if (static_cast<Integer>(block[i]) > max)
+                    max = static_cast<Integer>(block[i]);
+            }
+            auto base  = static_cast<uint_type>(min);
+            auto width = detail::bit_width(static_cast<uint_type>(uint_type(max) - base));
+
+            // a block of 128 integers with the given width needs exactly 2 * width words
+            auto offset = words_.size();
+            words_.resize(offset + 2u * width, 0u);
+            for (std::size_t i = 0; width != 0u && i != count; ++i)
+            {
+                auto difference = std::uint64_t(static_cast<uint_type>(block[i] - base));
+                auto bit        = i * width;
+                auto shift      = bit % 64u;
+
+                words_[offset + bit / 64u] |= difference << shift;
+                if (shift + width > 64u)
+                    words_[offset + bit / 64u + 1u] |= difference >> (64u - shift);
+            }
+
+            blocks_.push_back(block_header{base, location_type(offset, width)});
+            size_ += count;
+        }
+
+        using location_type
+            = word_tiny_storage<tiny_unsigned<57, std::uint64_t>, tiny_unsigned<7, std::uint64_t>>;
+
+        struct block_header
+        {
+            uint_type     base;
+            location_type location; // word offset and bit width
+        };
+
+        std::vector<std::uint64_t> words_;
+        std::vector<block_header>  blocks_;
+        std::size_t                size_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_PACKED_SEQUENCE_HPP_INCLUDED
@@ -0,0 +1,364 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_PACKED_SHARED_PTR_HPP_INCLUDED
+#define FOONATHAN_TINY_PACKED_SHARED_PTR_HPP_INCLUDED
+
+#include <type_traits>
+
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        // the reference count once the inline count has overflowed
+        struct packed_ref_overflow
+        {
+            std::size_t count;
+        };
+
+        constexpr std::size_t packed_ref_inline_bits = ilog2(alignof(packed_ref_overflow));
+
+        // the object is deleted through a T*, so that must be the actual type
+        // or have a virtual destructor
+        template <typename U, typename T>
+        using enable_packed_shared_conversion = typename std::enable_if<
+            std::is_convertible<U*, T*>::value
+            && (std::is_same<U, T>::value || std::has_virtual_destructor<T>::value)>::type;
+    } // namespace detail
+
+    template <typename T>
+    class packed_shared_ptr;
+
+    /// The base class of all objects managed by a [tiny::packed_shared_ptr]().
+    ///
+    /// It stores a small, saturating reference count in the alignment bits of a pointer.
+    /// If the inline count overflows, the pointer is set to an out-of-line count,
+    /// which is then used for the rest of the object's lifetime.
+    /// This means that as long as only a few references exist, the object is just one pointer
+    /// bigger and no additional allocation is required.
+    ///
+    /// \notes The reference count is not thread-safe.
+    class packed_ref_counted
+    {
+    public:
+        /// The maximal reference count that is stored without allocating an out-of-line count.
+        static constexpr std::size_t inline_count_max = (1u << detail::packed_ref_inline_bits) - 1;
+
+        /// \returns The number of [tiny::packed_shared_ptr]() that share ownership of the object.
+        std::size_t use_count() const noexcept
+        {
+            if (auto overflow = storage_.pointer())
+                return overflow->count;
+            else
+                return storage_.tiny();
+        }
+
+    protected:
+        /// \effects Creates it with a reference count of zero.
+        packed_ref_counted() noexcept = default;
+
+        /// \effects Same as the default constructor.
+        /// The reference count of `other` is not copied.
+        packed_ref_counted(const packed_ref_counted&) noexcept : packed_ref_counted() {}
+
+        /// \effects Does nothing, the reference count is not copied.
+        packed_ref_counted& operator=(const packed_ref_counted&) noexcept
+        {
+            return *this;
+        }
+
+        ~packed_ref_counted() noexcept
+        {
+            delete static_cast<detail::packed_ref_overflow*>(storage_.pointer());
+        }
+
+    private:
+        // may allocate the out-of-line count
+        void add_ref()
+        {
+            if (detail::packed_ref_overflow* overflow = storage_.pointer())
+                ++overflow->count;
+            else if (storage_.tiny() < inline_count_max)
+                ++storage_.tiny();
+            else
+                storage_.pointer() = new detail::packed_ref_overflow{inline_count_max + 1u};
+        }
+
+        // returns true if it was the last reference
+        bool release() noexcept
+        {
+            DEBUG_ASSERT(use_count() > 0u, detail::precondition_handler{},
+                         "object not owned by a packed_shared_ptr");
+            if (detail::packed_ref_overflow* overflow = storage_.pointer())
+                return --overflow->count == 0u;
+            else
+                return --storage_.tiny() == 0u;
+        }
+
+        using count = tiny_unsigned<detail::packed_ref_inline_bits, std::size_t>;
+        pointer_tiny_storage<detail::packed_ref_overflow, count> storage_;
+
+        template <typename T>
+        friend class packed_shared_ptr;
+    };
+
+    /// A reference counted pointer to an object inheriting from [tiny::packed_ref_counted]().
+    ///
+    /// The reference count is stored inside the object itself,
+    /// so it does not require an additional control block and is just the size of a pointer.
+    /// Unlike `std::shared_ptr`, copying it only touches the object itself.
+    ///
+    /// \notes The reference count is not thread-safe.
+    template <typename T>
+    class packed_shared_ptr
+    {
+        static_assert(std::is_base_of<packed_ref_counted, T>::value,
+                      "T must inherit from packed_ref_counted");
+
+    public:
+        using element_type = T;
+
+        //=== constructors ===//
+        /// \effects Creates a null pointer.
+        /// \group null
+        packed_shared_ptr() noexcept : ptr_(nullptr) {}
+        /// \group null
+        packed_shared_ptr(std::nullptr_t) noexcept : packed_shared_ptr() {}
+
+        /// \effects Takes ownership of the object.
+        /// \requires `ptr` must be `nullptr` or an object created by `new` that is not already
+        /// owned by another [tiny::packed_shared_ptr]().
+        explicit packed_shared_ptr(T* ptr) : ptr_(ptr)
+        {
+            DEBUG_ASSERT(!ptr_ || as_counted(ptr_).use_count() == 0u,
+                         detail::precondition_handler{}, "object already owned");
+            add_ref();
+        }
+
+        /// \returns A pointer that shares ownership of `ptr` with the pointers that already own it.
+        /// \requires `ptr` must be `nullptr` or an object that is already owned,
+        /// for example a pointer returned by `detach()`.
+        /// \notes It might allocate memory if the inline reference count overflows.
+        static packed_shared_ptr share(T* ptr)
+        {
+            packed_shared_ptr result;
+            if (ptr)
+                as_counted(ptr).add_ref();
+            result.ptr_ = ptr;
+            return result;
+        }
+
+        /// \returns A pointer that takes over the reference previously given up by `detach()`.
+        /// \requires `ptr` must be `nullptr` or a pointer returned by `detach()`,
+        /// and every such pointer must be adopted exactly once.
+        static packed_shared_ptr adopt(T* ptr) noexcept
+        {
+            packed_shared_ptr result;
+            result.ptr_ = ptr;
+            return result;
+        }
+
+        /// \effects Shares ownership with `other`.
+        /// \notes It might allocate memory if the inline reference count overflows.
+        /// \notes The converting overload only participates in overload resolution
+        /// if `T` has a virtual destructor, as the object is deleted through a `T*`.
+        /// \group copy
+        packed_shared_ptr(const packed_shared_ptr& other) : ptr_(other.ptr_)
+        {
+            add_ref();
+        }
+        /// \group copy
+        template <typename U, typename = detail::enable_packed_shared_conversion<U, T>>
+        packed_shared_ptr(const packed_shared_ptr<U>& other) : ptr_(other.get())
+        {
+            add_ref();
+        }
+
+        /// \effects Takes over the ownership of `other`, leaving it null.
+        /// \group move
+        packed_shared_ptr(packed_shared_ptr&& other) noexcept : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+        /// \group move
+        template <typename U, typename = detail::enable_packed_shared_conversion<U, T>>
+        packed_shared_ptr(packed_shared_ptr<U>&& other) noexcept : ptr_(other.release_ownership())
+        {}
+
+        /// \effects Releases ownership and destroys the object if it was the last owner.
+        ~packed_shared_ptr() noexcept
+        {
+            release();
+        }
+
+        /// \effects Shares ownership with `other`.
+        packed_shared_ptr& operator=(const packed_shared_ptr& other)
+        {
+            packed_shared_ptr tmp(other);
+            swap(*this, tmp);
+            return *this;
+        }
+
+        /// \effects Takes over the ownership of `other`, leaving it null.
+        packed_shared_ptr& operator=(packed_shared_ptr&& other) noexcept
+        {
+            packed_shared_ptr tmp(static_cast<packed_shared_ptr&&>(other));
+            swap(*this, tmp);
+            return *this;
+        }
+
+        friend void swap(packed_shared_ptr& lhs, packed_shared_ptr& rhs) noexcept
+        {
+            auto tmp = lhs.ptr_;
+            lhs.ptr_ = rhs.ptr_;
+            rhs.ptr_ = tmp;
+        }
+
+        //=== modifiers ===//
+        /// \effects Releases ownership, leaving it null.
+        void reset() noexcept
+        {
+            release();
+            ptr_ = nullptr;
+        }
+
+        /// \effects Gives up ownership without decrementing the reference count, leaving it null.
+        /// \returns The pointer to the object.
+        /// \notes Unless it is null, it must be passed to `adopt()` later on,
+        /// otherwise the object is leaked.
+        /// This allows storing the pointer somewhere else, like a [tiny::pointer_variant_impl]().
+        T* detach() noexcept
+        {
+            return release_ownership();
+        }
+
+        /// \effects Releases ownership and takes ownership of `ptr` instead.
+        /// \requires Same as the constructor taking a `T*`.
+        void reset(T* ptr)
+        {
+            packed_shared_ptr tmp(ptr);
+            swap(*this, tmp);
+        }
+
+        //=== accessors ===//
+        /// \returns Whether or not it points to an object.
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        /// \returns The pointer to the object.
+        T* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        /// \returns A reference to the object.
+        /// \requires It must not be null.
+        T& operator*() const noexcept
+        {
+            DEBUG_ASSERT(ptr_, detail::precondition_handler{}, "dereferencing null pointer");
+            return *ptr_;
+        }
+
+        /// \returns The pointer to the object.
+        /// \requires It must not be null.
+        T* operator->() const noexcept
+        {
+            DEBUG_ASSERT(ptr_, detail::precondition_handler{}, "dereferencing null pointer");
+            return ptr_;
+        }
+
+        /// \returns The number of pointers sharing ownership, or `0` if it is null.
+        std::size_t use_count() const noexcept
+        {
+            return ptr_ ? as_counted(ptr_).use_count() : 0u;
+        }
+
+    private:
+        static packed_ref_counted& as_counted(T* ptr) noexcept
+        {
+            return *ptr;
+        }
+
+        void add_ref()
+        {
+            if (ptr_)
+                as_counted(ptr_).add_ref();
+        }
+
+        void release() noexcept
+        {
+            if (ptr_ && as_counted(ptr_).release())
+                delete ptr_;
+        }
+
+        T* release_ownership() noexcept
+        {
+            auto ptr = ptr_;
+            ptr_     = nullptr;
+            return ptr;
+        }
+
+        T* ptr_;
+
+        template <typename U>
+        friend class packed_shared_ptr;
+    };
+
+    /// \returns Whether or not both point to the same object.
+    /// \group compare
+    template <typename T, typename U>
+    bool operator==(const packed_shared_ptr<T>& lhs, const packed_shared_ptr<U>& rhs) noexcept
+    {
+        return lhs.get() == rhs.get();
+    }
+    /// \group compare
+    template <typename T, typename U>
+    bool operator!=(const packed_shared_ptr<T>& lhs, const packed_shared_ptr<U>& rhs) noexcept
+    {
+        return lhs.get() != rhs.get();
+    }
+    /// \group compare
+    template <typename T>
+    bool operator==(const packed_shared_ptr<T>& lhs, std::nullptr_t) noexcept
+    {
+        return !lhs;
+    }
+    /// \group compare
+    template <typename T>
+    bool operator==(std::nullptr_t, const packed_shared_ptr<T>& rhs) noexcept
+    {
+        return !rhs;
+    }
+    /// \group compare
+    template <typename T>
+    bool operator!=(const packed_shared_ptr<T>& lhs, std::nullptr_t) noexcept
+    {
+        return static_cast<bool>(lhs);
+    }
+    /// \group compare
+    template <typename T>
+    bool operator!=(std::nullptr_t, const packed_shared_ptr<T>& rhs) noexcept
+    {
+        return static_cast<bool>(rhs);
+    }
+
+    /// \returns A [tiny::packed_shared_ptr]() owning a new object created by forwarding the
+    /// arguments.
+    template <typename T, typename... Args>
+    packed_shared_ptr<T> make_packed_shared(Args&&... args)
+    {
+        return packed_shared_ptr<T>(new T(static_cast<Args&&>(args)...));
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_PACKED_SHARED_PTR_HPP_INCLUDED
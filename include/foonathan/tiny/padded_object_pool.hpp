@@ -0,0 +1,330 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_PADDED_OBJECT_POOL_HPP_INCLUDED
+#define FOONATHAN_TINY_PADDED_OBJECT_POOL_HPP_INCLUDED
+
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/padding_aware.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        // the memory of a pool slot, the bookkeeping is stored in the padding of the object,
+        // and the remaining bits, if any, after it
+        template <typename T, std::size_t BookkeepingBits,
+                  std::size_t RemainingBits = (BookkeepingBits > padding_bit_size<T>()
+                                                   ? BookkeepingBits - padding_bit_size<T>()
+                                                   : 0u)>
+        struct pool_slot
+        {
+            using is_compressed = std::false_type;
+
+            using spill_view  = bit_view<tiny_storage_type<RemainingBits>, 0, last_bit>;
+            using spill_cview = bit_view<const tiny_storage_type<RemainingBits>, 0, last_bit>;
+
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type object;
+            tiny_storage_type<RemainingBits>                           spill;
+
+            joined_bit_view<padding_view_t<T>, spill_view> view() noexcept
+            {
+                auto memory = reinterpret_cast<unsigned char*>(&object);
+                return join_bit_views(padding_traits<T>::padding_view(memory), spill_view(spill));
+            }
+            joined_bit_view<padding_view_t<const T>, spill_cview> view() const noexcept
+            {
+                auto memory = reinterpret_cast<const unsigned char*>(&object);
+                return join_bit_views(padding_traits<T>::padding_view(memory), spill_cview(spill));
+            }
+        };
+
+        template <typename T, std::size_t BookkeepingBits>
+        struct pool_slot<T, BookkeepingBits, 0u>
+        {
+            using is_compressed = std::true_type;
+
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type object;
+
+            padding_view_t<T> view() noexcept
+            {
+                return padding_traits<T>::padding_view(reinterpret_cast<unsigned char*>(&object));
+            }
+            padding_view_t<const T> view() const noexcept
+            {
+                return padding_traits<T>::padding_view(
+                    reinterpret_cast<const unsigned char*>(&object));
+            }
+        };
+    } // namespace detail
+
+    /// A handle to an object in a [tiny::padded_object_pool]().
+    ///
+    /// It consists of the index of the slot and its generation,
+    /// so it does not refer to a different object if the slot is reused.
+    class pool_handle
+    {
+    public:
+        /// \effects Creates an invalid handle.
+        pool_handle() noexcept : index_(0u), generation_(0u) {}
+
+        /// \returns The index of the slot.
+        std::uint32_t index() const noexcept
+        {
+            return index_;
+        }
+
+        /// \returns The generation of the slot when the handle was created.
+        std::uint32_t generation() const noexcept
+        {
+            return generation_;
+        }
+
+        friend bool operator==(pool_handle lhs, pool_handle rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_ && lhs.generation_ == rhs.generation_;
+        }
+        friend bool operator!=(pool_handle lhs, pool_handle rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        pool_handle(std::uint32_t index, std::uint32_t generation) noexcept
+        : index_(index), generation_(generation)
+        {}
+
+        std::uint32_t index_, generation_;
+
+        template <typename, std::size_t, std::size_t>
+        friend class padded_object_pool;
+    };
+
+    /// A pool of objects that stores its bookkeeping in the padding bits of the objects.
+    ///
+    /// Every slot has a generation and the index of the next free slot,
+    /// taking `GenerationBits` and `IndexBits` respectively.
+    /// They are stored in the padding of the slot using the [tiny::padding_traits](),
+    /// so if `T` has enough padding, the pool needs no memory besides the objects themselves.
+    /// Otherwise, only the remaining bits are stored after each object.
+    ///
+    /// A slot is alive if its generation is odd,
+    /// and the free slots form a linked list through their index.
+    ///
+    /// \requires `T` must be trivially copyable and have specialized padding traits.
+    /// \notes Assigning to the entire object would overwrite the padding,
+    /// so the objects can only be changed using `assign()` or `modify()`.
+    template <typename T, std::size_t IndexBits = 24, std::size_t GenerationBits = 8>
+    class padded_object_pool
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "type must be trivially copyable");
+        static_assert(padding_traits<T>::is_specialized,
+                      "type must have specialized padding traits");
+        static_assert(0u < IndexBits && IndexBits <= 32u, "invalid number of index bits");
+        static_assert(0u < GenerationBits && GenerationBits <= 32u,
+                      "invalid number of generation bits");
+
+        using index_type      = tiny_unsigned<IndexBits, std::uint32_t>;
+        using generation_type = tiny_unsigned<GenerationBits, std::uint32_t>;
+        using slot = detail::pool_slot<T, total_bit_size<index_type, generation_type>()>;
+
+        // the index of the next free slot if there is none
+        static constexpr std::uint32_t no_index
+            = std::uint32_t((std::uint64_t(1) << IndexBits) - 1u);
+
+    public:
+        using value_type = T;
+        using handle     = pool_handle;
+
+        /// Whether or not the bookkeeping is stored entirely in the padding of `T`.
+        static constexpr bool is_compressed = slot::is_compressed::value;
+
+        //=== constructors ===//
+        /// \effects Creates an empty pool.
+        padded_object_pool() noexcept : free_head_(no_index), size_(0u) {}
+
+        //=== accessors ===//
+        /// \returns The number of objects in the pool.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no objects in the pool.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The number of slots, alive or not.
+        std::size_t slot_count() const noexcept
+        {
+            return slots_.size();
+        }
+
+        /// \returns The number of bytes used by the slots.
+        std::size_t memory_usage() const noexcept
+        {
+            return slots_.size() * sizeof(slot);
+        }
+
+        /// \returns Whether or not the handle refers to an object in the pool.
+        bool contains(handle h) const noexcept
+        {
+            return h.index_ < slots_.size()
+                   && h.generation_ == bookkeeping(slots_[h.index_]).template at<1>()
+                   && h.generation_ % 2u == 1u;
+        }
+
+        /// \returns The object the handle refers to.
+        /// \requires `contains(h)`.
+        const T& operator[](handle h) const noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            return object(slots_[h.index_]);
+        }
+
+        /// \effects Invokes `f(handle, object)` for every object in the pool, in order of slots.
+        template <typename Fn>
+        void for_each(Fn f) const
+        {
+            for (std::size_t i = 0; i != slots_.size(); ++i)
+            {
+                std::uint32_t generation = bookkeeping(slots_[i]).template at<1>();
+                if (generation % 2u == 1u)
+                    f(handle(std::uint32_t(i), generation), object(slots_[i]));
+            }
+        }
+
+        //=== modifiers ===//
+        /// \effects Reserves memory for the given number of slots.
+        void reserve(std::size_t slots)
+        {
+            slots_.reserve(slots);
+        }
+
+        /// \effects Adds a copy of the object to the pool, reusing a free slot if there is one.
+        /// \returns A handle to the new object.
+        /// \requires The pool must not have more than `2^IndexBits - 1` slots.
+        handle insert(const T& obj)
+        {
+            std::uint32_t index;
+            if (free_head_ == no_index)
+            {
+                DEBUG_ASSERT(slots_.size() < no_index, detail::precondition_handler{},
+                             "too many slots for the index bits");
+                index = std::uint32_t(slots_.size());
+                slots_.emplace_back();
+                clear_bits(slots_.back().view());
+            }
+            else
+            {
+                index      = free_head_;
+                free_head_ = bookkeeping(slots_[index]).template at<0>();
+            }
+
+            auto& s = slots_[index];
+            copy_value_bytes(obj, object(s));
+
+            // the generation of a free slot is even, so it becomes odd
+            std::uint32_t generation = bookkeeping(s).template at<1>();
+            generation               = (generation + 1u) & generation_mask();
+            bookkeeping(s).template at<1>() = generation;
+
+            ++size_;
+            return handle(index, generation);
+        }
+
+        /// \effects Creates an object from the arguments and adds it to the pool.
+        /// \returns A handle to the new object.
+        template <typename... Args>
+        handle emplace(Args&&... args)
+        {
+            return insert(T(static_cast<Args&&>(args)...));
+        }
+
+        /// \effects Removes the object from the pool,
+        /// all handles referring to it become invalid.
+        /// \requires `contains(h)`.
+        void erase(handle h) noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            auto storage = bookkeeping(slots_[h.index_]);
+            storage.template at<0>() = free_head_;
+            storage.template at<1>() = (h.generation_ + 1u) & generation_mask();
+
+            free_head_ = h.index_;
+            --size_;
+        }
+
+        /// \effects Sets the object the handle refers to to a copy of `obj`.
+        /// \requires `contains(h)`.
+        void assign(handle h, const T& obj) noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            copy_value_bytes(obj, object(slots_[h.index_]));
+        }
+
+        /// \effects Invokes `f(obj)` with a mutable copy of the object the handle refers to,
+        /// then writes the copy back.
+        /// \requires `contains(h)`.
+        template <typename Fn>
+        void modify(handle h, Fn f)
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            auto& obj  = object(slots_[h.index_]);
+            T     copy = obj;
+            f(copy);
+            copy_value_bytes(copy, obj);
+        }
+
+        /// \effects Removes all objects and slots.
+        void clear() noexcept
+        {
+            slots_.clear();
+            free_head_ = no_index;
+            size_      = 0u;
+        }
+
+    private:
+        static constexpr std::uint32_t generation_mask() noexcept
+        {
+            return std::uint32_t((std::uint64_t(1) << GenerationBits) - 1u);
+        }
+
+        static T& object(slot& s) noexcept
+        {
+            return *static_cast<T*>(static_cast<void*>(&s.object));
+        }
+        static const T& object(const slot& s) noexcept
+        {
+            return *static_cast<const T*>(static_cast<const void*>(&s.object));
+        }
+
+        static auto bookkeeping(slot& s) noexcept
+            -> basic_tiny_storage_view<decltype(s.view()), index_type, generation_type>
+        {
+            return {s.view()};
+        }
+        static auto bookkeeping(const slot& s) noexcept
+            -> basic_tiny_storage_view<decltype(s.view()), index_type, generation_type>
+        {
+            return {s.view()};
+        }
+
+        std::vector<slot> slots_;
+        std::uint32_t     free_head_;
+        std::size_t       size_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_PADDED_OBJECT_POOL_HPP_INCLUDED
@@ -0,0 +1,230 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_PADDING_AWARE_HPP_INCLUDED
+#define FOONATHAN_TINY_PADDING_AWARE_HPP_INCLUDED
+
+#include <cstring>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/index_sequence.hpp>
+#include <foonathan/tiny/padding_traits.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        // bits [begin, end) of a byte, in the same numbering as bit_view<unsigned char[N]>
+        constexpr unsigned range_byte_mask(std::size_t begin, std::size_t end, std::size_t byte)
+        {
+            return end <= byte * CHAR_BIT || begin >= (byte + 1u) * CHAR_BIT
+                       ? 0u
+                       : ((0xFFu << (begin <= byte * CHAR_BIT ? 0u : begin - byte * CHAR_BIT))
+                          & (0xFFu >> (end >= (byte + 1u) * CHAR_BIT
+                                           ? 0u
+                                           : (byte + 1u) * CHAR_BIT - end)))
+                             & 0xFFu;
+        }
+
+        // the padding bits of a byte, computed from the type of the padding view
+        template <class PaddingView>
+        struct padding_byte_mask
+        {
+            static_assert(PaddingView::size() == 0u, "padding view must be on the bytes");
+
+            static constexpr unsigned get(std::size_t) noexcept
+            {
+                return 0u;
+            }
+        };
+        template <typename Byte, std::size_t N, std::size_t Begin, std::size_t End>
+        struct padding_byte_mask<bit_view<Byte[N], Begin, End>>
+        {
+            static constexpr unsigned get(std::size_t byte) noexcept
+            {
+                return range_byte_mask(bit_view<Byte[N], Begin, End>::begin(),
+                                       bit_view<Byte[N], Begin, End>::end(), byte);
+            }
+        };
+        template <class Tail, typename Byte, std::size_t N, std::size_t Begin, std::size_t End>
+        struct padding_byte_mask<bit_view<joined_bit_view_tag<Tail, Byte[N]>, Begin, End>>
+        {
+            static constexpr unsigned get(std::size_t byte) noexcept
+            {
+                return padding_byte_mask<bit_view<Byte[N], Begin, End>>::get(byte)
+                       | padding_byte_mask<Tail>::get(byte);
+            }
+        };
+
+        constexpr std::size_t word_count_of(std::size_t size) noexcept
+        {
+            return (size + sizeof(std::uint64_t) - 1u) / sizeof(std::uint64_t);
+        }
+
+        // the position of the byte with the given index inside a word loaded from memory
+        constexpr std::size_t byte_shift(std::size_t index) noexcept
+        {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return (sizeof(std::uint64_t) - 1u - index) * CHAR_BIT;
+#else
+            return index * CHAR_BIT;
+#endif
+        }
+
+        // a bit is set in the mask if it belongs to the value, i.e. isn't padding
+        template <typename T>
+        constexpr std::uint64_t value_mask_word(std::size_t word, std::size_t index = 0u) noexcept
+        {
+            return index == sizeof(std::uint64_t)
+                       ? 0u
+                       : (word * sizeof(std::uint64_t) + index >= sizeof(T)
+                              ? 0u
+                              : std::uint64_t(~padding_byte_mask<padding_view_t<T>>::get(
+                                                  word * sizeof(std::uint64_t) + index)
+                                              & 0xFFu)
+                                    << byte_shift(index))
+                             | value_mask_word<T>(word, index + 1u);
+        }
+
+        template <typename T, std::size_t Word>
+        using value_mask = std::integral_constant<std::uint64_t, value_mask_word<T>(Word)>;
+
+        template <typename T>
+        struct value_words
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "type must be trivially copyable");
+            static_assert(padding_traits<T>::is_specialized,
+                          "type must have specialized padding traits");
+
+            using indices = make_index_sequence<word_count_of(sizeof(T))>;
+        };
+
+        // the given word of the object, bytes after the object are zero
+        template <typename T>
+        std::uint64_t load_object_word(const T& obj, std::size_t word) noexcept
+        {
+            auto offset = word * sizeof(std::uint64_t);
+            auto bytes  = reinterpret_cast<const unsigned char*>(&obj) + offset;
+
+            std::uint64_t result = 0;
+            if (sizeof(T) - offset >= sizeof(std::uint64_t))
+                std::memcpy(&result, bytes, sizeof(std::uint64_t));
+            else
+                std::memcpy(&result, bytes, sizeof(T) - offset);
+            return result;
+        }
+
+        template <typename T>
+        void store_object_word(T& obj, std::size_t word, std::uint64_t value) noexcept
+        {
+            auto offset = word * sizeof(std::uint64_t);
+            auto bytes  = reinterpret_cast<unsigned char*>(&obj) + offset;
+
+            if (sizeof(T) - offset >= sizeof(std::uint64_t))
+                std::memcpy(bytes, &value, sizeof(std::uint64_t));
+            else
+                std::memcpy(bytes, &value, sizeof(T) - offset);
+        }
+
+        inline std::uint64_t mix_hash_word(std::uint64_t hash, std::uint64_t word) noexcept
+        {
+            hash ^= word;
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+        }
+
+        template <typename T, std::size_t... Words>
+        std::uint64_t hash_value_words(const T& obj, index_sequence<Words...>) noexcept
+        {
+            std::uint64_t hash = sizeof(T);
+            bool          for_each[]
+                = {(hash = mix_hash_word(hash, load_object_word(obj, Words)
+                                                   & value_mask<T, Words>::value),
+                    true)...};
+            (void)for_each;
+            return mix_hash_word(hash, hash >> 29);
+        }
+
+        template <typename T, std::size_t... Words>
+        bool equal_value_words(const T& lhs, const T& rhs, index_sequence<Words...>) noexcept
+        {
+            std::uint64_t difference = 0;
+            bool          for_each[]
+                = {(difference |= (load_object_word(lhs, Words) ^ load_object_word(rhs, Words))
+                                  & value_mask<T, Words>::value,
+                    true)...};
+            (void)for_each;
+            return difference == 0u;
+        }
+
+        template <typename T, std::size_t... Words>
+        void copy_value_words(const T& src, T& dest, index_sequence<Words...>) noexcept
+        {
+            bool for_each[]
+                = {(store_object_word(dest, Words,
+                                      (load_object_word(src, Words) & value_mask<T, Words>::value)
+                                          | (load_object_word(dest, Words)
+                                             & ~value_mask<T, Words>::value)),
+                    true)...};
+            (void)for_each;
+        }
+    } // namespace detail
+
+    /// Hashes the object representation of a type, ignoring the padding bits.
+    ///
+    /// The object is processed as a couple of 64 bit words,
+    /// where the padding bits are masked out using the [tiny::padding_traits]().
+    /// The masks are computed from the type of the padding view,
+    /// so they are compile-time constants.
+    /// This is as fast as hashing the bytes directly,
+    /// but the result does not depend on the (unspecified) value of the padding,
+    /// or any tiny types stored there using [tiny::padding_tiny_storage]().
+    ///
+    /// \requires `T` must be trivially copyable and have specialized padding traits.
+    /// It must not have members like floating points where equal values can have different object
+    /// representations.
+    template <typename T>
+    struct padding_aware_hash
+    {
+        std::size_t operator()(const T& obj) const noexcept
+        {
+            using words = detail::value_words<T>;
+            return static_cast<std::size_t>(
+                detail::hash_value_words(obj, typename words::indices{}));
+        }
+    };
+
+    /// Compares the object representation of a type, ignoring the padding bits.
+    ///
+    /// Like [tiny::padding_aware_hash](),
+    /// it compares the object as words where the padding bits are masked out.
+    /// \requires `T` must be trivially copyable and have specialized padding traits.
+    template <typename T>
+    struct padding_aware_equal
+    {
+        bool operator()(const T& lhs, const T& rhs) const noexcept
+        {
+            using words = detail::value_words<T>;
+            return detail::equal_value_words(lhs, rhs, typename words::indices{});
+        }
+    };
+
+    /// \effects Copies all bits of `src` that aren't padding into `dest`,
+    /// leaving the padding of `dest` unchanged.
+    /// This is like a copy assignment, except it preserves anything stored in the padding,
+    /// e.g. using [tiny::padding_tiny_storage]().
+    /// \requires `T` must be trivially copyable and have specialized padding traits.
+    template <typename T>
+    void copy_value_bytes(const T& src, T& dest) noexcept
+    {
+        using words = detail::value_words<T>;
+        detail::copy_value_words(src, dest, typename words::indices{});
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_PADDING_AWARE_HPP_INCLUDED
@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include <foonathan/tiny/padding_traits.hpp>
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
 
 namespace foonathan
@@ -301,6 +302,15 @@ namespace tiny
             (void)for_each;
         }
     };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::padding_tiny_storage]().
+    ///
+    /// The tiny types are stored in the padding bytes, which are relocated together with the
+    /// object, so it is trivially relocatable if the padded type is.
+    template <class Padded, class... TinyTypes>
+    struct is_trivially_relocatable<padding_tiny_storage<Padded, TinyTypes...>>
+    : is_trivially_relocatable<Padded>
+    {};
 } // namespace tiny
 } // namespace foonathan
 
@@ -7,6 +7,9 @@
 
 #include <cstddef>
 #include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/config.hpp>
+#include <foonathan/tiny/detail/index_sequence.hpp>
 
 namespace foonathan
 {
@@ -85,6 +88,42 @@ namespace tiny
         return padding_view_t<T>::size();
     }
 
+    /// \exclude
+    namespace detail
+    {
+        template <std::size_t Bits>
+        struct padding_bits_are
+        {
+            template <std::size_t Expected>
+            struct but_expected
+            {
+                static_assert(Bits == Expected, "padding bits weren't as expected");
+                static constexpr bool value = true;
+            };
+        };
+    } // namespace detail
+
+    /// Checks that `T` has the given amount of padding bits.
+    ///
+    /// Like [tiny::check_size](), it will trigger a `static_assert()` where the instantiation
+    /// contains the actual value of `padding_bit_size<T>()` if it isn't `Bits`.
+    /// This way the padding is reported at compile-time and can't go unnoticed when members
+    /// change.
+    template <typename T, std::size_t Bits>
+    constexpr bool check_padding() noexcept
+    {
+        return detail::padding_bits_are<padding_bit_size<T>()>::template but_expected<Bits>::value;
+    }
+
+    /// Expands to something equivalent to `static_assert(check_padding<T, Bits>())`, i.e. checks
+    /// that `T` has `Bits` padding bits.
+#define FOONATHAN_TINY_CHECK_PADDING(T, Bits)                                                      \
+    static_assert(foonathan::tiny::detail::padding_bits_are<                                       \
+                          foonathan::tiny::padding_bit_size<T>()>::template but_expected<         \
+                          Bits>::value                                                             \
+                      || true,                                                                     \
+                  "")
+
     //=== padding_traits_aggregate ===//
     /// Traits type containing information about a member of an aggregate type.
     template <class T, typename Member, Member(T::*Ptr), std::size_t Offset>
@@ -249,6 +288,220 @@ namespace tiny
         static_assert(padding_traits<LayoutCompatible>::is_specialized,
                       "LayoutCompatible doesn't have the padding traits either");
     };
+
+#if FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION
+    //=== padding_traits_reflect ===//
+    /// \exclude
+    namespace reflect_detail
+    {
+        // convertible to everything, used to count the members of an aggregate
+        struct any_initializer
+        {
+            template <typename T>
+            operator T() const noexcept;
+        };
+
+        template <std::size_t>
+        using any_initializer_for = any_initializer;
+
+        template <typename T, typename... Args>
+        auto test_brace_constructible(int)
+            -> decltype(T{std::declval<Args>()...}, std::true_type{});
+        template <typename T, typename... Args>
+        std::false_type test_brace_constructible(short);
+
+        template <typename T, class Indices>
+        struct is_brace_constructible_with;
+        template <typename T, std::size_t... I>
+        struct is_brace_constructible_with<T, detail::index_sequence<I...>>
+        : decltype(test_brace_constructible<T, any_initializer_for<I>...>(0))
+        {};
+
+        // the number of members is the maximal number of initializers
+        template <typename T, std::size_t N = 0u,
+                  bool = is_brace_constructible_with<T, detail::make_index_sequence<N + 1u>>::value>
+        struct member_count : member_count<T, N + 1u>
+        {};
+        template <typename T, std::size_t N>
+        struct member_count<T, N, false> : std::integral_constant<std::size_t, N>
+        {};
+
+        template <typename... Ts>
+        struct type_list
+        {};
+
+        // defined, as it is called in the body of member_types
+        template <typename... Ts>
+        type_list<Ts...> type_list_of(Ts&...) noexcept
+        {
+            return {};
+        }
+
+        template <typename T>
+        const volatile char* address_of(const T& obj) noexcept
+        {
+            // ignores an overloaded operator&
+            return &reinterpret_cast<const volatile char&>(obj);
+        }
+
+        // whether the members are at the offsets computed for them
+        template <typename T, class... Members, typename... Ts>
+        bool has_offsets(const T& obj, type_list<Members...>, const Ts&... members) noexcept
+        {
+            bool matches[] = {address_of(members) - address_of(obj)
+                              == std::ptrdiff_t(Members::offset())...};
+            for (auto match : matches)
+                if (!match)
+                    return false;
+            return true;
+        }
+
+        template <typename T>
+        void member_types(T&, std::integral_constant<std::size_t, 0>) noexcept;
+
+#define FOONATHAN_TINY_DETAIL_REFLECT(N, ...)                                                      \
+    template <typename T>                                                                          \
+    auto member_types(T& obj, std::integral_constant<std::size_t, N>) noexcept                     \
+    {                                                                                              \
+        auto& [__VA_ARGS__] = obj;                                                                 \
+        return type_list_of(__VA_ARGS__);                                                          \
+    }                                                                                              \
+    template <typename T, class Members>                                                           \
+    bool has_member_offsets(const T& obj, std::integral_constant<std::size_t, N>,                  \
+                            Members members) noexcept                                              \
+    {                                                                                              \
+        auto& [__VA_ARGS__] = obj;                                                                 \
+        return has_offsets(obj, members, __VA_ARGS__);                                             \
+    }
+
+        FOONATHAN_TINY_DETAIL_REFLECT(1, m0)
+        FOONATHAN_TINY_DETAIL_REFLECT(2, m0, m1)
+        FOONATHAN_TINY_DETAIL_REFLECT(3, m0, m1, m2)
+        FOONATHAN_TINY_DETAIL_REFLECT(4, m0, m1, m2, m3)
+        FOONATHAN_TINY_DETAIL_REFLECT(5, m0, m1, m2, m3, m4)
+        FOONATHAN_TINY_DETAIL_REFLECT(6, m0, m1, m2, m3, m4, m5)
+        FOONATHAN_TINY_DETAIL_REFLECT(7, m0, m1, m2, m3, m4, m5, m6)
+        FOONATHAN_TINY_DETAIL_REFLECT(8, m0, m1, m2, m3, m4, m5, m6, m7)
+        FOONATHAN_TINY_DETAIL_REFLECT(9, m0, m1, m2, m3, m4, m5, m6, m7, m8)
+        FOONATHAN_TINY_DETAIL_REFLECT(10, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9)
+        FOONATHAN_TINY_DETAIL_REFLECT(11, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10)
+        FOONATHAN_TINY_DETAIL_REFLECT(12, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11)
+        FOONATHAN_TINY_DETAIL_REFLECT(13, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12)
+        FOONATHAN_TINY_DETAIL_REFLECT(14, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12,
+                                      m13)
+        FOONATHAN_TINY_DETAIL_REFLECT(15, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12,
+                                      m13, m14)
+        FOONATHAN_TINY_DETAIL_REFLECT(16, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12,
+                                      m13, m14, m15)
+
+#undef FOONATHAN_TINY_DETAIL_REFLECT
+
+        constexpr std::size_t max_member_count = 16u;
+
+        template <typename T>
+        using member_type_list = decltype(
+            member_types(std::declval<T&>(), std::integral_constant<std::size_t,
+                                                                    member_count<T>::value>{}));
+
+        template <class T, typename Member, std::size_t Offset>
+        struct reflected_member
+        {
+            using object_type = T;
+            using member_type = Member;
+
+            static constexpr std::size_t offset() noexcept
+            {
+                return Offset;
+            }
+        };
+
+        constexpr std::size_t align_offset(std::size_t offset, std::size_t alignment) noexcept
+        {
+            return (offset + alignment - 1u) / alignment * alignment;
+        }
+
+        // computes the offsets of the members like the compiler does:
+        // each member is placed at the next offset that satisfies its alignment
+        template <class T, std::size_t Offset, class Result, class Members>
+        struct layout_members;
+
+        template <class T, std::size_t Offset, class... Result>
+        struct layout_members<T, Offset, type_list<Result...>, type_list<>>
+        {
+            using traits  = padding_traits_aggregate<Result...>;
+            using members = type_list<Result...>;
+
+            static constexpr std::size_t end = Offset;
+        };
+
+        template <class T, std::size_t Offset, class... Result, typename Head, typename... Tail>
+        struct layout_members<T, Offset, type_list<Result...>, type_list<Head, Tail...>>
+        : layout_members<T, align_offset(Offset, alignof(Head)) + sizeof(Head),
+                         type_list<Result...,
+                                   reflected_member<T, Head, align_offset(Offset, alignof(Head))>>,
+                         type_list<Tail...>>
+        {};
+
+        template <typename T>
+        struct reflected_layout
+        {
+            static_assert(std::is_aggregate<T>::value && std::is_standard_layout<T>::value,
+                          "type must be a standard layout aggregate");
+            static_assert(member_count<T>::value > 0u, "type must not be empty");
+            static_assert(member_count<T>::value <= max_member_count, "too many members");
+
+            using type = layout_members<T, 0, type_list<>, member_type_list<T>>;
+            static_assert(align_offset(type::end, alignof(T)) == sizeof(T),
+                          "unable to compute layout, type must not contain arrays or bit-fields");
+        };
+
+        // the offsets can't be checked at compile-time,
+        // an over-aligned member can be at a different one without changing the size
+        template <typename T>
+        bool has_reflected_offsets(const T& obj) noexcept
+        {
+            return has_member_offsets(obj, std::integral_constant<std::size_t,
+                                                                  member_count<T>::value>{},
+                                      typename reflected_layout<T>::type::members{});
+        }
+    } // namespace reflect_detail
+
+    /// Implements the [tiny::padding_traits]() for an aggregate type automatically.
+    ///
+    /// Simply specialize the traits for your type and inherit from it.
+    /// Unlike [tiny::padding_traits_aggregate](), the members don't need to be listed.
+    /// They are discovered using structured bindings and the offsets are computed from their size
+    /// and alignment.
+    ///
+    /// \requires `T` must be a standard layout aggregate with at most 16 members,
+    /// without base classes, array members, bit-fields, references or over-aligned (`alignas`)
+    /// members.
+    /// Over-aligned members are only detected by a debug assertion when accessing the padding.
+    /// \notes This is only available in C++17,
+    /// when `FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION` is `1`.
+    template <typename T>
+    class padding_traits_reflect : public reflect_detail::reflected_layout<T>::type::traits
+    {
+        using base = typename reflect_detail::reflected_layout<T>::type::traits;
+
+    public:
+        static auto padding_view(unsigned char* memory) noexcept
+            -> decltype(base::padding_view(memory))
+        {
+            DEBUG_ASSERT(reflect_detail::has_reflected_offsets(*reinterpret_cast<const T*>(memory)),
+                         detail::precondition_handler{}, "type must not have over-aligned members");
+            return base::padding_view(memory);
+        }
+
+        static auto padding_view(const unsigned char* memory) noexcept
+            -> decltype(base::padding_view(memory))
+        {
+            DEBUG_ASSERT(reflect_detail::has_reflected_offsets(*reinterpret_cast<const T*>(memory)),
+                         detail::precondition_handler{}, "type must not have over-aligned members");
+            return base::padding_view(memory);
+        }
+    };
+#endif
 } // namespace tiny
 } // namespace foonathan
 
@@ -6,6 +6,7 @@
 #define FOONATHAN_TINY_TINY_POINTER_STORAGE_HPP_INCLUDED
 
 #include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
 
 namespace foonathan
@@ -245,6 +246,13 @@ namespace tiny
             return this->storage_policy().template get_pointer<T>();
         }
     };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::pointer_tiny_storage]().
+    ///
+    /// It only stores a pointer and possibly some bits, so it is always trivially relocatable.
+    template <typename T, typename... TinyTypes>
+    struct is_trivially_relocatable<pointer_tiny_storage<T, TinyTypes...>> : std::true_type
+    {};
 } // namespace tiny
 } // namespace foonathan
 
@@ -6,7 +6,9 @@
 #define FOONATHAN_TINY_POINTER_VARIANT_IMPL_HPP_INCLUDED
 
 #include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tombstone.hpp>
 
 namespace foonathan
 {
@@ -176,6 +178,68 @@ namespace tiny
     private:
         storage_type storage_;
     };
+
+    /// \exclude
+    namespace detail
+    {
+        template <typename... Ts>
+        struct pointer_variant_tombstones
+        {
+            using storage_type = pointer_variant_storage<Ts...>;
+
+            static constexpr std::size_t tag_bits = pointer_variant_tag<Ts...>::bit_size();
+            static constexpr std::size_t spare_bits
+                = decltype(std::declval<const storage_type&>().spare_bits())::size();
+
+            static constexpr std::size_t max_bits = sizeof(std::size_t) * CHAR_BIT - 1u;
+            static constexpr std::size_t total_bits
+                = tag_bits + spare_bits < max_bits ? tag_bits + spare_bits : max_bits;
+
+            // the tag and spare bits are treated as one integer,
+            // which is always less than the number of types for valid objects
+            static constexpr std::size_t count
+                = (std::size_t(1) << total_bits) - sizeof...(Ts);
+        };
+    } // namespace detail
+
+    /// Specialization of the tombstone traits for [tiny::pointer_variant_impl]().
+    ///
+    /// It uses the tag values that do not correspond to a type,
+    /// as well as all other spare bits of the pointer.
+    template <typename... Ts>
+    struct tombstone_traits<pointer_variant_impl<Ts...>>
+    : tombstone_traits_simple<pointer_variant_impl<Ts...>, detail::pointer_variant_storage<Ts...>>
+    {
+    private:
+        using info = detail::pointer_variant_tombstones<Ts...>;
+
+    public:
+        static constexpr std::size_t tombstone_count = info::count;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            auto storage = ::new (memory) typename info::storage_type();
+
+            auto value          = sizeof...(Ts) + index;
+            storage->tiny()     = clear_other_bits<0, info::tag_bits>(value);
+            storage->spare_bits().put(value >> info::tag_bits);
+        }
+
+        static std::size_t get_tombstone_impl(const typename info::storage_type& storage) noexcept
+        {
+            auto value = std::size_t(storage.tiny())
+                         | static_cast<std::size_t>(storage.spare_bits().extract() << info::tag_bits);
+            // unconditionally subtract, valid objects will overflow
+            return value - sizeof...(Ts);
+        }
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::pointer_variant_impl]().
+    ///
+    /// It only stores a pointer, so it is always trivially relocatable.
+    template <typename... Ts>
+    struct is_trivially_relocatable<pointer_variant_impl<Ts...>> : std::true_type
+    {};
 } // namespace tiny
 } // namespace foonathan
 
@@ -0,0 +1,189 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_RADIX_SORT_HPP_INCLUDED
+#define FOONATHAN_TINY_RADIX_SORT_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace detail
+    {
+        constexpr std::size_t radix_digit_bits   = 8u;
+        constexpr std::size_t radix_bucket_count = std::size_t(1) << radix_digit_bits;
+
+        constexpr std::size_t radix_pass_count(std::size_t key_bits) noexcept
+        {
+            return (key_bits + radix_digit_bits - 1u) / radix_digit_bits;
+        }
+
+        template <class Storage, std::size_t... Indices>
+        struct radix_key;
+
+        template <class Storage>
+        struct radix_key<Storage>
+        {
+            static constexpr std::size_t bit_size() noexcept
+            {
+                return 0u;
+            }
+
+            static std::uint64_t get(const Storage&) noexcept
+            {
+                return 0u;
+            }
+        };
+
+        // the first tiny type is the most significant part of the key
+        template <class Storage, std::size_t Head, std::size_t... Tail>
+        struct radix_key<Storage, Head, Tail...>
+        {
+            using bits = decltype(std::declval<const Storage&>().template bits_of<Head>());
+            using tail = radix_key<Storage, Tail...>;
+
+            static constexpr std::size_t bit_size() noexcept
+            {
+                return bits::size() + tail::bit_size();
+            }
+
+            static std::uint64_t get(const Storage& storage) noexcept
+            {
+                std::uint64_t head = storage.template bits_of<Head>().extract();
+                return (head << tail::bit_size()) | tail::get(storage);
+            }
+
+            std::uint64_t operator()(const Storage& storage) const noexcept
+            {
+                return get(storage);
+            }
+        };
+
+        // moves the elements into the bucket of the digit at the given shift
+        template <typename SrcIt, typename DestIt, typename KeyFn>
+        void radix_scatter(SrcIt src, std::size_t size, DestIt dest,
+                           std::size_t (&offsets)[radix_bucket_count], std::size_t shift,
+                           KeyFn& key)
+        {
+            using value_type      = typename std::iterator_traits<SrcIt>::value_type;
+            using difference_type = typename std::iterator_traits<DestIt>::difference_type;
+            for (auto cur = src; size != 0u; ++cur, --size)
+            {
+                auto digit = (std::uint64_t(key(*cur)) >> shift) % radix_bucket_count;
+                dest[static_cast<difference_type>(offsets[digit]++)]
+                    = static_cast<value_type&&>(*cur);
+            }
+        }
+
+        template <std::size_t KeyBits, typename RandomIt, typename KeyFn>
+        void radix_sort_impl(RandomIt begin, RandomIt end, KeyFn key)
+        {
+            using value_type          = typename std::iterator_traits<RandomIt>::value_type;
+            constexpr auto pass_count = radix_pass_count(KeyBits);
+
+            auto size = std::size_t(end - begin);
+            if (size <= 1u)
+                return;
+
+            // the histograms don't depend on the order, so compute all of them at once
+            std::size_t offsets[pass_count][radix_bucket_count] = {};
+            for (auto cur = begin; cur != end; ++cur)
+            {
+                auto k = std::uint64_t(key(*cur));
+                for (std::size_t pass = 0; pass != pass_count; ++pass)
+                    ++offsets[pass][(k >> (pass * radix_digit_bits)) % radix_bucket_count];
+            }
+
+            std::vector<value_type> buffer;
+            auto                    in_buffer = false;
+            for (std::size_t pass = 0; pass != pass_count; ++pass)
+            {
+                auto& pass_offsets = offsets[pass];
+
+                auto first = std::uint64_t(key(in_buffer ? buffer[0] : begin[0]));
+                if (pass_offsets[(first >> (pass * radix_digit_bits)) % radix_bucket_count]
+                    == size)
+                    // all keys have the same digit, nothing to do
+                    continue;
+
+                std::size_t sum = 0;
+                for (auto& offset : pass_offsets)
+                {
+                    auto count = offset;
+                    offset     = sum;
+                    sum += count;
+                }
+
+                if (in_buffer)
+                    radix_scatter(buffer.begin(), size, begin, pass_offsets,
+                                  pass * radix_digit_bits, key);
+                else if (buffer.empty())
+                {
+                    // the buffer needs to be filled with valid objects first
+                    buffer.assign(std::make_move_iterator(begin), std::make_move_iterator(end));
+                    radix_scatter(buffer.begin(), size, begin, pass_offsets,
+                                  pass * radix_digit_bits, key);
+                    continue;
+                }
+                else
+                    radix_scatter(begin, size, buffer.begin(), pass_offsets,
+                                  pass * radix_digit_bits, key);
+                in_buffer = !in_buffer;
+            }
+
+            if (in_buffer)
+                std::move(buffer.begin(), buffer.end(), begin);
+        }
+    } // namespace detail
+
+    /// Sorts a range of tiny storages by the specified tiny types using a LSD radix sort.
+    ///
+    /// The range is sorted lexicographically by the tiny types at the given `Indices`,
+    /// where the first index is the most significant one.
+    /// The tiny types are compared by their encoded bits,
+    /// so the order is the order of the bits, not necessarily of their values.
+    /// This is the same for unsigned integers and enums with non-negative values.
+    ///
+    /// The bits of each storage are read only once to build the composite key.
+    /// As its size is known at compile-time, the sort uses exactly `ceil(key_bits / 8)` passes,
+    /// and skips passes where all keys have the same digit.
+    /// The sort is stable.
+    ///
+    /// \requires The value type of the range must be a [tiny::basic_tiny_storage](),
+    /// like [tiny::tiny_storage]() or [tiny::word_tiny_storage](),
+    /// and the tiny types at the indices must have at most 64 bits together.
+    template <std::size_t... Indices, typename RandomIt>
+    void radix_sort(RandomIt begin, RandomIt end)
+    {
+        static_assert(sizeof...(Indices) > 0, "need to sort by at least one tiny type");
+
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        using key        = detail::radix_key<value_type, Indices...>;
+        static_assert(key::bit_size() <= 64u, "key too big");
+
+        detail::radix_sort_impl<key::bit_size()>(begin, end, key{});
+    }
+
+    /// Sorts a range using a LSD radix sort with the given key.
+    ///
+    /// Like the other overload, except that the composite key is given by `key(element)`,
+    /// which must return an integer where only the lower `KeyBits` bits are set.
+    template <std::size_t KeyBits, typename RandomIt, typename KeyFn>
+    void radix_sort(RandomIt begin, RandomIt end, KeyFn key)
+    {
+        static_assert(0u < KeyBits && KeyBits <= 64u, "invalid key size");
+        detail::radix_sort_impl<KeyBits>(begin, end, key);
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_RADIX_SORT_HPP_INCLUDED
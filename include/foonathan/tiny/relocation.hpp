@@ -0,0 +1,117 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_RELOCATION_HPP_INCLUDED
+#define FOONATHAN_TINY_RELOCATION_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// Whether or not objects of type `T` are trivially relocatable.
+    ///
+    /// An object is trivially relocatable if moving it to a new location and destroying the old
+    /// one is equivalent to copying its bytes and forgetting about the old one.
+    /// This is true for all objects that don't store pointers to themselves,
+    /// even if they are not copyable or movable.
+    ///
+    /// The default implementation is [std::true_type]() if `T` is trivially copyable,
+    /// [std::false_type]() otherwise.
+    /// Specialize it for your own types, the second parameter can be used for SFINAE.
+    template <typename T, typename = void>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {};
+
+    /// \exclude
+    namespace relocation_detail
+    {
+        template <bool... Bs>
+        struct bool_list
+        {};
+
+        template <typename... Ts>
+        using all_trivially_relocatable
+            = std::is_same<bool_list<true, is_trivially_relocatable<Ts>::value...>,
+                           bool_list<is_trivially_relocatable<Ts>::value..., true>>;
+
+        template <typename T>
+        void relocate(std::true_type, T* src, std::size_t n, T* dest) noexcept
+        {
+            if (n != 0u)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+        }
+
+        // moving cannot throw
+        template <typename T>
+        void relocate_objects(std::true_type, T* src, std::size_t n, T* dest) noexcept
+        {
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                ::new (static_cast<void*>(dest + i)) T(static_cast<T&&>(src[i]));
+                src[i].~T();
+            }
+        }
+
+        // destroys the objects in [begin, begin + count) unless count is reset,
+        // a guard instead of try/catch, so it works without exceptions
+        template <typename T>
+        struct destroy_guard
+        {
+            T*          begin;
+            std::size_t count;
+
+            ~destroy_guard() noexcept
+            {
+                while (count != 0u)
+                    begin[--count].~T();
+            }
+        };
+
+        // copying can throw
+        template <typename T>
+        void relocate_objects(std::false_type, T* src, std::size_t n, T* dest)
+        {
+            // if a copy throws, the originals are unchanged, so destroy the copies
+            destroy_guard<T> copies{dest, 0u};
+            for (; copies.count != n; ++copies.count)
+                ::new (static_cast<void*>(dest + copies.count))
+                    T(const_cast<const T&>(src[copies.count]));
+            copies.count = 0u;
+
+            for (std::size_t i = 0; i != n; ++i)
+                src[i].~T();
+        }
+
+        template <typename T>
+        void relocate(std::false_type, T* src, std::size_t n,
+                      T* dest) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            relocate_objects(std::is_nothrow_move_constructible<T>{}, src, n, dest);
+        }
+    } // namespace relocation_detail
+
+    /// \effects Relocates the `n` objects starting at `src` into the uninitialized memory starting
+    /// at `dest`, i.e. creates them in the new location and destroys the old ones.
+    ///
+    /// If `T` is trivially relocatable, this is a single `std::memcpy()`.
+    /// Otherwise, the objects are moved if that cannot throw, and copied if it can;
+    /// if a copy throws, the objects at `src` are unchanged and the exception is rethrown.
+    /// \requires The two ranges must not overlap.
+    template <typename T>
+    void relocate(T* src, std::size_t n, T* dest) noexcept(
+        is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+    {
+        relocation_detail::relocate(std::integral_constant<bool,
+                                                           is_trivially_relocatable<T>::value>{},
+                                    src, n, dest);
+    }
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_RELOCATION_HPP_INCLUDED
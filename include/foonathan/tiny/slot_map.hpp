@@ -0,0 +1,304 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
+#define FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
+
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// A container that stores objects densely and refers to them using generational handles.
+    ///
+    /// A handle consists of the index of a slot, the generation of the slot and a valid flag,
+    /// all packed into a single [tiny::word_tiny_storage]().
+    /// The slot stores the index of the object in the dense storage,
+    /// so insert, erase and lookup are `O(1)`,
+    /// and iterating over all objects is as fast as iterating over a `std::vector<T>`.
+    /// Erasing an object moves the last object into its place.
+    ///
+    /// When an object is erased, the generation of its slot is incremented,
+    /// so old handles no longer refer to the slot, even if it is reused later on.
+    /// As the generation has only `GenerationBits` bits, it will eventually wrap around.
+    ///
+    /// \requires `IndexBits` and `GenerationBits` must be at most 32 and together at most 63.
+    template <typename T, std::size_t IndexBits = 32, std::size_t GenerationBits = 31>
+    class slot_map
+    {
+        static_assert(0u < IndexBits && IndexBits <= 32u, "invalid number of index bits");
+        static_assert(0u < GenerationBits && GenerationBits <= 32u,
+                      "invalid number of generation bits");
+        static_assert(IndexBits + GenerationBits < 64u, "handle doesn't fit into a word");
+
+        // the same layout is used for handles and slots,
+        // where the index is the index of the slot or the index of the object respectively
+        using storage = word_tiny_storage<tiny_unsigned<IndexBits, std::uint32_t>,
+                                          tiny_unsigned<GenerationBits, std::uint32_t>, tiny_bool>;
+
+        // the index of the next free slot if there is none
+        static constexpr std::uint32_t no_index
+            = std::uint32_t((std::uint64_t(1) << IndexBits) - 1u);
+
+    public:
+        using value_type     = T;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        /// A handle to an object in the slot map.
+        class handle
+        {
+        public:
+            /// \effects Creates an invalid handle.
+            handle() noexcept = default;
+
+            /// \returns Whether or not the handle has been returned by the slot map.
+            /// \notes It is still valid after the object has been erased,
+            /// use `contains()` to check whether it refers to an object.
+            explicit operator bool() const noexcept
+            {
+                return storage_.template at<2>();
+            }
+
+            /// \returns The index of the slot.
+            std::uint32_t index() const noexcept
+            {
+                return storage_.template at<0>();
+            }
+
+            /// \returns The generation of the slot when the handle was created.
+            std::uint32_t generation() const noexcept
+            {
+                return storage_.template at<1>();
+            }
+
+            friend bool operator==(const handle& lhs, const handle& rhs) noexcept
+            {
+                return lhs.index() == rhs.index() && lhs.generation() == rhs.generation()
+                       && bool(lhs) == bool(rhs);
+            }
+            friend bool operator!=(const handle& lhs, const handle& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            handle(std::uint32_t index, std::uint32_t generation) noexcept
+            : storage_(index, generation, true)
+            {}
+
+            storage storage_;
+
+            friend slot_map;
+        };
+
+        //=== constructors ===//
+        /// \effects Creates an empty slot map.
+        slot_map() noexcept : free_head_(no_index) {}
+
+        //=== accessors ===//
+        /// \returns The number of objects.
+        std::size_t size() const noexcept
+        {
+            return values_.size();
+        }
+
+        /// \returns Whether or not there are no objects.
+        bool empty() const noexcept
+        {
+            return values_.empty();
+        }
+
+        /// \returns Whether or not the handle refers to an object.
+        bool contains(handle h) const noexcept
+        {
+            if (!h || h.index() >= slots_.size())
+                return false;
+
+            auto& slot = slots_[h.index()];
+            return slot.template at<2>() && slot.template at<1>() == h.generation();
+        }
+
+        /// \returns A pointer to the object the handle refers to,
+        /// or `nullptr` if it does not refer to an object.
+        /// \group find
+        T* find(handle h) noexcept
+        {
+            return contains(h) ? &values_[slots_[h.index()].template at<0>()] : nullptr;
+        }
+        /// \group find
+        const T* find(handle h) const noexcept
+        {
+            return contains(h) ? &values_[slots_[h.index()].template at<0>()] : nullptr;
+        }
+
+        /// \returns A reference to the object the handle refers to.
+        /// \requires `contains(h)`.
+        /// \group subscript
+        T& operator[](handle h) noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            return values_[slots_[h.index()].template at<0>()];
+        }
+        /// \group subscript
+        const T& operator[](handle h) const noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            return values_[slots_[h.index()].template at<0>()];
+        }
+
+        /// \returns The handle to the object at the given position in the dense storage.
+        /// \requires `i < size()`.
+        handle handle_at(std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < values_.size(), detail::precondition_handler{}, "index out of range");
+            auto slot = dense_to_slot_[i];
+            return handle(slot, slots_[slot].template at<1>());
+        }
+
+        //=== iterators ===//
+        /// \returns An iterator to the first object in the dense storage.
+        /// \group begin
+        iterator begin() noexcept
+        {
+            return values_.data();
+        }
+        /// \group begin
+        const_iterator begin() const noexcept
+        {
+            return values_.data();
+        }
+
+        /// \returns An iterator one past the last object in the dense storage.
+        /// \group end
+        iterator end() noexcept
+        {
+            return values_.data() + values_.size();
+        }
+        /// \group end
+        const_iterator end() const noexcept
+        {
+            return values_.data() + values_.size();
+        }
+
+        //=== modifiers ===//
+        /// \effects Reserves memory for the given number of objects.
+        void reserve(std::size_t size)
+        {
+            slots_.reserve(size);
+            values_.reserve(size);
+            dense_to_slot_.reserve(size);
+        }
+
+        /// \effects Inserts a copy of the object.
+        /// \returns A handle to the new object.
+        /// \group insert
+        handle insert(const T& obj)
+        {
+            return emplace(obj);
+        }
+        /// \group insert
+        handle insert(T&& obj)
+        {
+            return emplace(static_cast<T&&>(obj));
+        }
+
+        /// \effects Creates an object from the arguments and inserts it.
+        /// \returns A handle to the new object.
+        /// \requires There must not be more than `2^IndexBits - 1` slots.
+        template <typename... Args>
+        handle emplace(Args&&... args)
+        {
+            // reserve first, so nothing can throw after the object has been inserted
+            if (free_head_ == no_index)
+                reserve_one_more(slots_);
+            reserve_one_more(dense_to_slot_);
+
+            auto dense_index = std::uint32_t(values_.size());
+            values_.emplace_back(static_cast<Args&&>(args)...);
+
+            std::uint32_t index;
+            if (free_head_ == no_index)
+            {
+                DEBUG_ASSERT(slots_.size() < no_index, detail::precondition_handler{},
+                             "too many slots for the index bits");
+                index = std::uint32_t(slots_.size());
+                slots_.emplace_back(dense_index, 0u, true);
+            }
+            else
+            {
+                index      = free_head_;
+                free_head_ = slots_[index].template at<0>();
+
+                slots_[index].template at<0>() = dense_index;
+                slots_[index].template at<2>() = true;
+            }
+            dense_to_slot_.push_back(index);
+
+            return handle(index, slots_[index].template at<1>());
+        }
+
+        /// \effects Erases the object the handle refers to,
+        /// the last object in the dense storage is moved into its place.
+        /// \requires `contains(h)`.
+        void erase(handle h) noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            auto& slot        = slots_[h.index()];
+            auto  dense_index = std::uint32_t(slot.template at<0>());
+
+            auto last = std::uint32_t(values_.size() - 1u);
+            if (dense_index != last)
+            {
+                values_[dense_index]        = static_cast<T&&>(values_[last]);
+                dense_to_slot_[dense_index] = dense_to_slot_[last];
+                slots_[dense_to_slot_[last]].template at<0>() = dense_index;
+            }
+            values_.pop_back();
+            dense_to_slot_.pop_back();
+
+            slot.template at<0>() = free_head_;
+            slot.template at<1>() = (h.generation() + 1u) & generation_mask();
+            slot.template at<2>() = false;
+            free_head_            = h.index();
+        }
+
+        /// \effects Erases all objects and slots.
+        void clear() noexcept
+        {
+            slots_.clear();
+            values_.clear();
+            dense_to_slot_.clear();
+            free_head_ = no_index;
+        }
+
+    private:
+        // grows geometrically like push_back() would
+        template <typename U>
+        static void reserve_one_more(std::vector<U>& vec)
+        {
+            if (vec.size() == vec.capacity())
+                vec.reserve(vec.empty() ? 1u : 2u * vec.size());
+        }
+
+        static constexpr std::uint32_t generation_mask() noexcept
+        {
+            return std::uint32_t((std::uint64_t(1) << GenerationBits) - 1u);
+        }
+
+        std::vector<storage>       slots_;
+        std::vector<T>             values_;
+        std::vector<std::uint32_t> dense_to_slot_;
+        std::uint32_t              free_head_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
@@ -0,0 +1,413 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_SMALL_VECTOR_HPP_INCLUDED
+#define FOONATHAN_TINY_SMALL_VECTOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/relocation.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace small_vector_detail
+    {
+        template <typename T>
+        void erase(std::true_type, T* first, T* last, T* end) noexcept
+        {
+            for (auto cur = first; cur != last; ++cur)
+                cur->~T();
+            std::memmove(static_cast<void*>(first), static_cast<const void*>(last),
+                         std::size_t(end - last) * sizeof(T));
+        }
+
+        template <typename T>
+        void erase(std::false_type, T* first, T* last,
+                   T* end) noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+            for (; last != end; ++first, ++last)
+                *first = static_cast<T&&>(*last);
+            for (; first != end; ++first)
+                first->~T();
+        }
+
+        // frees the memory unless it has been released
+        class memory_guard
+        {
+        public:
+            explicit memory_guard(void* memory) noexcept : memory_(memory) {}
+
+            memory_guard(const memory_guard&) = delete;
+            memory_guard& operator=(const memory_guard&) = delete;
+
+            ~memory_guard() noexcept
+            {
+                ::operator delete(memory_);
+            }
+
+            void release() noexcept
+            {
+                memory_ = nullptr;
+            }
+
+        private:
+            void* memory_;
+        };
+    } // namespace small_vector_detail
+
+    /// A vector that stores up to `N` objects inline and uses the heap for more.
+    ///
+    /// Whenever the objects need to be moved to new memory,
+    /// they are moved using [tiny::relocate]().
+    /// So if `T` is [tiny::is_trivially_relocatable](),
+    /// growing is just a `std::memcpy()` and erasing a `std::memmove()`,
+    /// and `T` does not even need to be movable.
+    /// This allows vectors of [tiny::optional_impl]() or [tiny::tagged_union_impl]().
+    ///
+    /// \requires `T` must not be over-aligned.
+    template <typename T, std::size_t N = 0>
+    class small_vector
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types not supported");
+
+        using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+        using relocation_noexcept
+            = std::integral_constant<bool, is_trivially_relocatable<T>::value
+                                               || std::is_nothrow_move_constructible<T>::value>;
+        using erase_noexcept
+            = std::integral_constant<bool, is_trivially_relocatable<T>::value
+                                               || std::is_nothrow_move_assignable<T>::value>;
+
+    public:
+        using value_type     = T;
+        using size_type      = std::size_t;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        //=== constructors ===//
+        /// \effects Creates an empty vector that uses the inline storage.
+        small_vector() noexcept : begin_(inline_begin()), size_(0), capacity_(N) {}
+
+        /// \effects Creates a copy of all objects in `other`.
+        small_vector(const small_vector& other) : small_vector()
+        {
+            reserve(other.size_);
+            for (auto& obj : other)
+                emplace_back(obj);
+        }
+
+        /// \effects Takes the heap memory of `other` or relocates its inline objects,
+        /// `other` is empty afterwards.
+        small_vector(small_vector&& other) noexcept(relocation_noexcept::value) : small_vector()
+        {
+            take(other);
+        }
+
+        /// \effects Destroys all objects and frees the heap memory.
+        ~small_vector() noexcept
+        {
+            clear();
+            deallocate();
+        }
+
+        /// \effects Replaces the objects by copies of the objects in `other`.
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.size_);
+                for (auto& obj : other)
+                    emplace_back(obj);
+            }
+            return *this;
+        }
+
+        /// \effects Replaces the objects by the objects of `other`,
+        /// `other` is empty afterwards.
+        small_vector& operator=(small_vector&& other) noexcept(relocation_noexcept::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                deallocate();
+                take(other);
+            }
+            return *this;
+        }
+
+        //=== accessors ===//
+        /// \returns The number of objects.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns The number of objects that fit into the memory without growing.
+        size_type capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /// \returns Whether or not there are no objects.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns Whether or not the objects are stored inline.
+        bool is_inline() const noexcept
+        {
+            return begin_ == inline_begin();
+        }
+
+        /// \returns A pointer to the first object.
+        /// \group data
+        T* data() noexcept
+        {
+            return begin_;
+        }
+        /// \group data
+        const T* data() const noexcept
+        {
+            return begin_;
+        }
+
+        /// \returns A reference to the object at the given index.
+        /// \requires `i < size()`.
+        /// \group subscript
+        T& operator[](size_type i) noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            return begin_[i];
+        }
+        /// \group subscript
+        const T& operator[](size_type i) const noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            return begin_[i];
+        }
+
+        /// \returns A reference to the first object.
+        /// \requires `!empty()`.
+        /// \group front
+        T& front() noexcept
+        {
+            return (*this)[0u];
+        }
+        /// \group front
+        const T& front() const noexcept
+        {
+            return (*this)[0u];
+        }
+
+        /// \returns A reference to the last object.
+        /// \requires `!empty()`.
+        /// \group back
+        T& back() noexcept
+        {
+            return (*this)[size_ - 1u];
+        }
+        /// \group back
+        const T& back() const noexcept
+        {
+            return (*this)[size_ - 1u];
+        }
+
+        //=== iterators ===//
+        /// \returns An iterator to the first object.
+        /// \group begin
+        iterator begin() noexcept
+        {
+            return begin_;
+        }
+        /// \group begin
+        const_iterator begin() const noexcept
+        {
+            return begin_;
+        }
+
+        /// \returns An iterator one past the last object.
+        /// \group end
+        iterator end() noexcept
+        {
+            return begin_ + size_;
+        }
+        /// \group end
+        const_iterator end() const noexcept
+        {
+            return begin_ + size_;
+        }
+
+        //=== modifiers ===//
+        /// \effects Grows the memory so that it can store at least `new_capacity` objects.
+        /// \notes If it needs to grow, the objects are relocated and all iterators are invalidated.
+        void reserve(size_type new_capacity)
+        {
+            if (new_capacity <= capacity_)
+                return;
+
+            auto                              memory = allocate(new_capacity);
+            small_vector_detail::memory_guard guard(memory);
+            relocate(begin_, size_, memory);
+            guard.release();
+            replace_memory(memory, new_capacity);
+        }
+
+        /// \effects Creates a new object at the end by forwarding the arguments.
+        /// \returns A reference to the new object.
+        /// \notes If it needs to grow, the objects are relocated and all iterators are invalidated.
+        /// The arguments may refer to objects in the vector.
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ == capacity_)
+            {
+                auto new_capacity = capacity_ == 0u ? 1u : 2u * capacity_;
+                auto memory       = allocate(new_capacity);
+                small_vector_detail::memory_guard memory_guard(memory);
+
+                // create the new object first, the arguments might refer to the old ones
+                ::new (static_cast<void*>(memory + size_)) T(static_cast<Args&&>(args)...);
+                relocation_detail::destroy_guard<T> object_guard{memory + size_, 1u};
+
+                relocate(begin_, size_, memory);
+                object_guard.count = 0u;
+                memory_guard.release();
+                replace_memory(memory, new_capacity);
+            }
+            else
+                ::new (static_cast<void*>(begin_ + size_)) T(static_cast<Args&&>(args)...);
+
+            return begin_[size_++];
+        }
+
+        /// \effects Creates a new object at the end by copying or moving `obj`.
+        /// \group push_back
+        void push_back(const T& obj)
+        {
+            emplace_back(obj);
+        }
+        /// \group push_back
+        void push_back(T&& obj)
+        {
+            emplace_back(static_cast<T&&>(obj));
+        }
+
+        /// \effects Destroys the last object.
+        /// \requires `!empty()`.
+        void pop_back() noexcept
+        {
+            DEBUG_ASSERT(size_ > 0u, detail::precondition_handler{}, "vector is empty");
+            begin_[--size_].~T();
+        }
+
+        /// \effects Destroys the objects at the end or adds value initialized objects,
+        /// until there are `new_size` objects.
+        void resize(size_type new_size)
+        {
+            while (size_ > new_size)
+                pop_back();
+            reserve(new_size);
+            while (size_ < new_size)
+                emplace_back();
+        }
+
+        /// \effects Destroys the objects in the range `[first, last)` and moves the following
+        /// objects forward.
+        /// \returns An iterator to the object after the erased ones.
+        /// \notes If `T` is trivially relocatable, the objects are moved using `std::memmove()`,
+        /// otherwise using move assignment.
+        /// \group erase
+        iterator erase(const_iterator first, const_iterator last) noexcept(erase_noexcept::value)
+        {
+            DEBUG_ASSERT(begin_ <= first && first <= last && last <= end(),
+                         detail::precondition_handler{}, "invalid range");
+            auto result = begin_ + (first - begin_);
+            small_vector_detail::erase(std::integral_constant<bool,
+                                                              is_trivially_relocatable<T>::value>{},
+                                       result, begin_ + (last - begin_), end());
+            size_ -= size_type(last - first);
+            return result;
+        }
+        /// \group erase
+        iterator erase(const_iterator pos) noexcept(erase_noexcept::value)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        /// \effects Destroys all objects, but keeps the memory.
+        void clear() noexcept
+        {
+            while (size_ > 0u)
+                pop_back();
+        }
+
+    private:
+        T* inline_begin() noexcept
+        {
+            return reinterpret_cast<T*>(inline_);
+        }
+        const T* inline_begin() const noexcept
+        {
+            return reinterpret_cast<const T*>(inline_);
+        }
+
+        static T* allocate(size_type capacity)
+        {
+            return static_cast<T*>(::operator new(capacity * sizeof(T)));
+        }
+
+        void deallocate() noexcept
+        {
+            if (!is_inline())
+                ::operator delete(begin_);
+            begin_    = inline_begin();
+            capacity_ = N;
+        }
+
+        // the objects have already been relocated into the memory
+        void replace_memory(T* memory, size_type capacity) noexcept
+        {
+            deallocate();
+            begin_    = memory;
+            capacity_ = capacity;
+        }
+
+        // requires that this is empty and uses the inline storage
+        void take(small_vector& other) noexcept(relocation_noexcept::value)
+        {
+            if (other.is_inline())
+            {
+                relocate(other.begin_, other.size_, begin_);
+                size_ = other.size_;
+            }
+            else
+            {
+                begin_    = other.begin_;
+                size_     = other.size_;
+                capacity_ = other.capacity_;
+
+                other.begin_    = other.inline_begin();
+                other.capacity_ = N;
+            }
+            other.size_ = 0u;
+        }
+
+        T*           begin_;
+        size_type    size_;
+        size_type    capacity_;
+        storage_type inline_[N == 0u ? 1u : N];
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_SMALL_VECTOR_HPP_INCLUDED
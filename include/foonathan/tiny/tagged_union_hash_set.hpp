@@ -0,0 +1,416 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TAGGED_UNION_HASH_SET_HPP_INCLUDED
+#define FOONATHAN_TINY_TAGGED_UNION_HASH_SET_HPP_INCLUDED
+
+#include <climits>
+#include <memory>
+#include <utility>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/tagged_union_impl.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace hash_set_detail
+    {
+        template <typename... T>
+        struct type_list
+        {};
+
+        template <class UnionTypes>
+        struct type_list_of;
+        template <typename... T>
+        struct type_list_of<union_types<T...>>
+        {
+            using type = type_list<T...>;
+        };
+
+        // calls f(value) with the value of the type of the tag
+        template <std::size_t I, class Union, typename Fn>
+        void visit(Union&, Fn&, type_list<>) noexcept
+        {
+            DEBUG_UNREACHABLE(detail::assert_handler{});
+        }
+        template <std::size_t I, class Union, typename Fn, typename Head, typename... Tail>
+        void visit(Union& u, Fn& f, type_list<Head, Tail...>)
+        {
+            if (u.tag() == I)
+                f(u.template value<Head>());
+            else
+                visit<I + 1>(u, f, type_list<Tail...>{});
+        }
+
+        template <class Union>
+        struct destroy_value
+        {
+            Union* u;
+
+            template <typename T>
+            void operator()(T&) const noexcept
+            {
+                u->template destroy_value<T>();
+            }
+        };
+
+        struct equal
+        {
+            template <typename T>
+            bool operator()(const T& lhs, const T& rhs) const
+            {
+                return lhs == rhs;
+            }
+        };
+    } // namespace hash_set_detail
+
+    /// A hash set of objects of the types of a [tiny::tagged_union_impl]().
+    ///
+    /// The objects are stored in a single array of [tiny::tagged_union_impl]() slots using open
+    /// addressing with linear probing.
+    /// Like the control bytes of a Swiss table, every slot stores some bits of the hash value,
+    /// the fingerprint, which tells whether the slot is empty, was erased or likely matches.
+    /// But instead of a separate array, the fingerprint is stored as [tiny::tiny_unsigned]() in
+    /// the spare bits of the [tiny::tagged_union_tag]().
+    /// So probing can reject non-matching slots by reading only the tag,
+    /// the objects are only compared if the fingerprint and the type match.
+    ///
+    /// `Hash` must be callable with every type of the union and return a `std::size_t`,
+    /// `KeyEqual` must be callable with two objects of the same type;
+    /// the default uses `operator==`.
+    /// Objects of different types are never equal.
+    ///
+    /// If a hash, a copy or an allocation throws while the set grows, the set is unchanged;
+    /// the objects are only moved instead of copied if that can't throw.
+    ///
+    /// \requires `FingerprintBits` must be at least two and at most the number of spare bits of
+    /// the tag, and the types must not use the spare bits themselves.
+    template <class UnionTypes, class Hash, class KeyEqual = hash_set_detail::equal,
+              std::size_t FingerprintBits = (tagged_union_tag<UnionTypes>::spare_bits < 8u
+                                                 ? tagged_union_tag<UnionTypes>::spare_bits
+                                                 : 8u)>
+    class tagged_union_hash_set
+    {
+        static_assert(FingerprintBits >= 2u, "not enough spare bits in the tag for a fingerprint");
+        static_assert(FingerprintBits <= tagged_union_tag<UnionTypes>::spare_bits,
+                      "fingerprint does not fit into the spare bits of the tag");
+
+        using slot        = tagged_union_impl<UnionTypes>;
+        using fingerprint = tiny_types<tiny_unsigned<FingerprintBits>>;
+        using types       = typename hash_set_detail::type_list_of<UnionTypes>::type;
+
+        // the fingerprints of slots without an object,
+        // all other values are the fingerprints of objects
+        static constexpr unsigned empty_slot  = 0u;
+        static constexpr unsigned erased_slot = 1u;
+
+    public:
+        using value_types = UnionTypes;
+
+        //=== constructors ===//
+        /// \effects Creates an empty set that doesn't allocate memory.
+        explicit tagged_union_hash_set(Hash hash = Hash(), KeyEqual equal = KeyEqual())
+        : hash_(std::move(hash)), equal_(std::move(equal)), size_(0), used_(0), capacity_(0)
+        {}
+
+        tagged_union_hash_set(const tagged_union_hash_set&) = delete;
+        tagged_union_hash_set& operator=(const tagged_union_hash_set&) = delete;
+
+        /// \effects Destroys all objects.
+        ~tagged_union_hash_set() noexcept
+        {
+            clear();
+        }
+
+        //=== accessors ===//
+        /// \returns The number of objects.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no objects.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The number of slots.
+        std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /// \returns A pointer to the object equal to `key`, or `nullptr` if there is none.
+        /// \group find
+        template <typename T>
+        T* find(const T& key)
+        {
+            auto index = find_index(key, hash_(key));
+            return index == capacity_ ? nullptr : &slots_[index].template value<T>();
+        }
+        /// \group find
+        template <typename T>
+        const T* find(const T& key) const
+        {
+            auto index = find_index(key, hash_(key));
+            return index == capacity_ ? nullptr : &slots_[index].template value<T>();
+        }
+
+        /// \returns Whether or not there is an object equal to `key`.
+        template <typename T>
+        bool contains(const T& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        /// \effects Calls `f(obj)` for every object `obj` with the object type it has.
+        /// \group for_each
+        template <typename Fn>
+        void for_each(Fn f)
+        {
+            for (std::size_t i = 0; i != capacity_; ++i)
+                if (has_object(i))
+                    hash_set_detail::visit<0>(slots_[i], f, types{});
+        }
+        /// \group for_each
+        template <typename Fn>
+        void for_each(Fn f) const
+        {
+            for (std::size_t i = 0; i != capacity_; ++i)
+                if (has_object(i))
+                    hash_set_detail::visit<0>(static_cast<const slot&>(slots_[i]), f, types{});
+        }
+
+        //=== modifiers ===//
+        /// \effects Inserts `obj` if there is no equal object.
+        /// \returns A pointer to the inserted object or the equal one,
+        /// and whether or not it has been inserted.
+        template <typename T>
+        std::pair<T*, bool> insert(T obj)
+        {
+            auto hash = std::size_t(hash_(obj));
+
+            auto existing = find_index(obj, hash);
+            if (existing != capacity_)
+                return std::make_pair(&slots_[existing].template value<T>(), false);
+
+            if ((used_ + 1u) * 8u > capacity_ * 7u)
+                // more than 7/8 of the slots are used, so grow or just remove erased ones
+                rehash(2u * (size_ + 1u) > capacity_ ? 2u * capacity_ : capacity_);
+
+            auto index    = insert_index(hash);
+            auto was_used = fingerprint_of(index) != empty_slot;
+            slots_[index].template create_value<T>(std::move(obj));
+            // after the object has been created, so its constructor can't overwrite it,
+            // and nothing changes if it throws
+            set_fingerprint(index, fingerprint_from(hash));
+            if (!was_used)
+                ++used_;
+            ++size_;
+
+            return std::make_pair(&slots_[index].template value<T>(), true);
+        }
+
+        /// \effects Erases the object equal to `key`, if there is one.
+        /// \returns Whether or not an object has been erased.
+        template <typename T>
+        bool erase(const T& key)
+        {
+            auto index = find_index(key, hash_(key));
+            if (index == capacity_)
+                return false;
+
+            slots_[index].template destroy_value<T>();
+            set_fingerprint(index, erased_slot);
+            --size_;
+            return true;
+        }
+
+        /// \effects Erases all objects, but keeps the slots.
+        void clear() noexcept
+        {
+            for (std::size_t i = 0; i != capacity_; ++i)
+            {
+                if (has_object(i))
+                    destroy_object(slots_[i]);
+                set_fingerprint(i, empty_slot);
+            }
+            size_ = 0;
+            used_ = 0;
+        }
+
+        /// \effects Makes sure that `n` objects can be stored without rehashing.
+        void reserve(std::size_t n)
+        {
+            auto new_capacity = capacity_ == 0u ? 8u : capacity_;
+            while (n * 8u > new_capacity * 7u)
+                new_capacity *= 2u;
+            if (new_capacity != capacity_)
+                rehash(new_capacity);
+        }
+
+    private:
+        // writes the hashes of the objects into consecutive elements
+        struct hash_object
+        {
+            const Hash*  hash;
+            std::size_t* result;
+
+            template <typename T>
+            void operator()(const T& obj)
+            {
+                *result++ = std::size_t((*hash)(obj));
+            }
+        };
+
+        // moves the objects into a new table if that can't throw, copies them otherwise
+        struct transfer_object
+        {
+            slot*              slots;
+            std::size_t        capacity;
+            const std::size_t* hash;
+
+            template <typename T>
+            void operator()(T& obj)
+            {
+                auto index = insert_index(slots, capacity, *hash);
+                slots[index].template create_value<T>(std::move_if_noexcept(obj));
+                set_fingerprint(slots[index], fingerprint_from(*hash));
+                ++hash;
+            }
+        };
+
+        // destroys the objects of a new table unless it is released by setting capacity to 0,
+        // so a partially filled table is cleaned up if a copy throws
+        struct table_guard
+        {
+            slot*       slots;
+            std::size_t capacity;
+
+            ~table_guard() noexcept
+            {
+                for (std::size_t i = 0; i != capacity; ++i)
+                    if (fingerprint_of(slots[i]) > erased_slot)
+                        destroy_object(slots[i]);
+            }
+        };
+
+        static void destroy_object(slot& s) noexcept
+        {
+            hash_set_detail::destroy_value<slot> destroy{&s};
+            hash_set_detail::visit<0>(s, destroy, types{});
+        }
+
+        static unsigned fingerprint_of(const slot& s) noexcept
+        {
+            return s.union_tag().tiny_view(fingerprint{}).tiny();
+        }
+        unsigned fingerprint_of(std::size_t index) const noexcept
+        {
+            return fingerprint_of(slots_[index]);
+        }
+
+        static void set_fingerprint(slot& s, unsigned value) noexcept
+        {
+            s.union_tag().tiny_view(fingerprint{}).tiny() = value;
+        }
+        void set_fingerprint(std::size_t index, unsigned value) noexcept
+        {
+            set_fingerprint(slots_[index], value);
+        }
+
+        bool has_object(std::size_t index) const noexcept
+        {
+            return fingerprint_of(index) > erased_slot;
+        }
+
+        // uses the upper bits of the hash, as the lower bits select the slot
+        static unsigned fingerprint_from(std::size_t hash) noexcept
+        {
+            constexpr auto max    = (std::size_t(1) << FingerprintBits) - 1u;
+            constexpr auto offset = std::size_t(erased_slot) + 1u;
+
+            auto upper = hash >> (sizeof(std::size_t) * CHAR_BIT - FingerprintBits);
+            return static_cast<unsigned>(offset + upper % (max - erased_slot));
+        }
+
+        // returns capacity_ if there is no equal object
+        template <typename T>
+        std::size_t find_index(const T& key, std::size_t hash) const
+        {
+            if (capacity_ == 0u)
+                return capacity_;
+
+            auto expected = fingerprint_from(hash);
+            for (auto index = hash & (capacity_ - 1u);; index = (index + 1u) & (capacity_ - 1u))
+            {
+                auto cur = fingerprint_of(index);
+                if (cur == empty_slot)
+                    return capacity_;
+                else if (cur == expected && slots_[index].template has_value<T>()
+                         && equal_(slots_[index].template value<T>(), key))
+                    return index;
+            }
+        }
+
+        // returns the first slot without an object
+        static std::size_t insert_index(const slot* slots, std::size_t capacity,
+                                        std::size_t hash) noexcept
+        {
+            auto index = hash & (capacity - 1u);
+            while (fingerprint_of(slots[index]) > erased_slot)
+                index = (index + 1u) & (capacity - 1u);
+            return index;
+        }
+        std::size_t insert_index(std::size_t hash) const noexcept
+        {
+            return insert_index(slots_.get(), capacity_, hash);
+        }
+
+        // the set is only changed once nothing can throw anymore
+        void rehash(std::size_t new_capacity)
+        {
+            if (new_capacity == 0u)
+                new_capacity = 8u;
+
+            std::unique_ptr<std::size_t[]> hashes(new std::size_t[size_]);
+            hash_object                    hash{&hash_, hashes.get()};
+            for (std::size_t i = 0; i != capacity_; ++i)
+                if (has_object(i))
+                    hash_set_detail::visit<0>(static_cast<const slot&>(slots_[i]), hash,
+                                              types{});
+
+            std::unique_ptr<slot[]> new_slots(new slot[new_capacity]);
+            for (std::size_t i = 0; i != new_capacity; ++i)
+                set_fingerprint(new_slots[i], empty_slot);
+
+            table_guard     guard{new_slots.get(), new_capacity};
+            transfer_object transfer{new_slots.get(), new_capacity, hashes.get()};
+            for (std::size_t i = 0; i != capacity_; ++i)
+                if (has_object(i))
+                    hash_set_detail::visit<0>(slots_[i], transfer, types{});
+            guard.capacity = 0u;
+
+            for (std::size_t i = 0; i != capacity_; ++i)
+                if (has_object(i))
+                    destroy_object(slots_[i]);
+            slots_    = std::move(new_slots);
+            capacity_ = new_capacity;
+            used_     = size_;
+        }
+
+        std::unique_ptr<slot[]> slots_;
+        Hash                    hash_;
+        KeyEqual                equal_;
+        std::size_t             size_, used_, capacity_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TAGGED_UNION_HASH_SET_HPP_INCLUDED
@@ -7,8 +7,10 @@
 
 #include <new>
 
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/tombstone.hpp>
 
 namespace foonathan
 {
@@ -19,6 +21,9 @@ namespace tiny
     {
         template <class UnionTypes, std::size_t I, typename... T>
         union types_storage;
+
+        template <class UnionTypes>
+        struct tombstone_traits_impl;
     } // namespace tagged_union_detail
 
     template <class UnionTypes>
@@ -33,6 +38,9 @@ namespace tiny
 
         /// \exclude
         using storage = tagged_union_detail::types_storage<union_types<T...>, 0, T...>;
+
+        /// \exclude
+        static constexpr std::size_t size = sizeof...(T);
     };
 
     /// The tag of a [tiny::tagged_union_impl]().
@@ -105,10 +113,31 @@ namespace tiny
             return make_tiny_proxy<tiny_tag>(tag_cview(storage_));
         }
 
+        // access to the tag bits that don't correspond to a type
+        void set_tag_bits(std::size_t bits) noexcept
+        {
+            tag_view(storage_).put(bits);
+        }
+        std::size_t get_tag_bits() const noexcept
+        {
+            return static_cast<std::size_t>(tag_cview(storage_).extract());
+        }
+
+        storage_view spare_view() noexcept
+        {
+            return storage_view(storage_);
+        }
+        storage_cview spare_view() const noexcept
+        {
+            return storage_cview(storage_);
+        }
+
         template <class, std::size_t, typename...>
         friend union tagged_union_detail::types_storage;
         template <class>
         friend class tagged_union_impl;
+        template <class>
+        friend struct tagged_union_detail::tombstone_traits_impl;
     };
 
     /// \exclude
@@ -298,10 +327,115 @@ namespace tiny
             return storage_.get(tagged_union_detail::type_tag<T>{});
         }
 
+        /// \returns A reference to the tag,
+        /// so the tiny types in its spare bits can be accessed even in the invalid state.
+        /// \group union_tag
+        tagged_union_tag<UnionTypes>& union_tag() noexcept
+        {
+            return storage_.tag;
+        }
+        /// \group union_tag
+        const tagged_union_tag<UnionTypes>& union_tag() const noexcept
+        {
+            return storage_.tag;
+        }
+
     private:
         tagged_union_detail::types_storage_for<UnionTypes> storage_;
+
+        friend tagged_union_detail::tombstone_traits_impl<UnionTypes>;
     };
 
+    /// \exclude
+    namespace tagged_union_detail
+    {
+        template <class UnionTypes>
+        struct tombstone_traits_impl
+        {
+        private:
+            static constexpr std::size_t tag_bits = UnionTypes::tag::bit_size();
+            // the tag values that don't correspond to a type
+            static constexpr std::size_t unused_tags
+                = (std::size_t(1) << tag_bits) - UnionTypes::size;
+
+            static constexpr std::size_t max_spare_bits
+                = sizeof(std::size_t) * CHAR_BIT - 1u - tag_bits;
+            static constexpr std::size_t spare_bits
+                = tagged_union_tag<UnionTypes>::spare_bits < max_spare_bits
+                      ? tagged_union_tag<UnionTypes>::spare_bits
+                      : max_spare_bits;
+
+            // avoid division by zero if there are no tombstones
+            static constexpr std::size_t divisor = unused_tags == 0u ? 1u : unused_tags;
+
+        public:
+            using object_type     = tagged_union_impl<UnionTypes>;
+            using storage_type    = tagged_union_impl<UnionTypes>;
+            using reference       = object_type&;
+            using const_reference = const object_type&;
+
+            // every unused tag combined with every value of the spare bits,
+            // as the spare bits are meaningless without an object
+            static constexpr std::size_t tombstone_count = unused_tags << spare_bits;
+
+            static void create_tombstone(storage_type& storage,
+                                         std::size_t   tombstone_index) noexcept
+            {
+                auto& tag = storage.storage_.tag;
+                tag.set_tag_bits(UnionTypes::size + tombstone_index % divisor);
+                tag.spare_view().template subview<0, spare_bits>().put(tombstone_index / divisor);
+            }
+
+            // tagged_union_impl only has a default constructor
+            static void create_object(storage_type& storage) noexcept
+            {
+                // the union is in the invalid state, so any valid tag is fine
+                storage.storage_.tag.set_tag_bits(0);
+            }
+
+            static void destroy_object(storage_type&) noexcept {}
+
+            static std::size_t get_tombstone(const storage_type& storage) noexcept
+            {
+                auto& tag      = storage.storage_.tag;
+                auto  tag_bits = tag.get_tag_bits();
+                if (tag_bits < UnionTypes::size)
+                    // tag of a type, so no tombstone
+                    return tombstone_count;
+
+                auto spare = static_cast<std::size_t>(
+                    tag.spare_view().template subview<0, spare_bits>().extract());
+                return tag_bits - UnionTypes::size + spare * unused_tags;
+            }
+
+            static reference get_object(storage_type& storage) noexcept
+            {
+                return storage;
+            }
+            static const_reference get_object(const storage_type& storage) noexcept
+            {
+                return storage;
+            }
+        };
+    } // namespace tagged_union_detail
+
+    /// Specialization of the tombstone traits for [tiny::tagged_union_impl]().
+    ///
+    /// It uses the tag values that do not correspond to a type as tombstones,
+    /// combined with all values of the spare bits of the tag.
+    template <class UnionTypes>
+    struct tombstone_traits<tagged_union_impl<UnionTypes>>
+    : tagged_union_detail::tombstone_traits_impl<UnionTypes>
+    {};
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::tagged_union_impl]().
+    ///
+    /// It is trivially relocatable if all types of the union are.
+    template <class... T>
+    struct is_trivially_relocatable<tagged_union_impl<union_types<T...>>>
+    : relocation_detail::all_trivially_relocatable<T...>
+    {};
+
     /// Dummy type to allow an empty [tiny::tagged_union_impl]().
     template <class UnionTypes>
     struct tagged_union_empty
@@ -26,19 +26,19 @@ namespace tiny
         class proxy
         {
         public:
-            const proxy& operator=(bool value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(bool value) const noexcept
             {
                 view_.put(value ? 1 : 0);
                 return *this;
             }
 
-            operator bool() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 operator bool() const noexcept
             {
                 return view_.extract() != 0;
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
             BitView view_;
 
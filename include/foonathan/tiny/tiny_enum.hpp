@@ -38,7 +38,7 @@ namespace tiny
         class proxy
         {
         public:
-            const proxy& operator=(object_type value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(object_type value) const noexcept
             {
                 DEBUG_ASSERT(is_valid_enum_value<traits>(value), detail::precondition_handler{},
                              "not a valid enum value");
@@ -46,13 +46,13 @@ namespace tiny
                 return *this;
             }
 
-            operator object_type() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 operator object_type() const noexcept
             {
                 return static_cast<object_type>(view_.extract());
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
             BitView view_;
 
@@ -5,6 +5,8 @@
 #ifndef FOONATHAN_TINY_TINY_FLAG_SET_HPP_INCLUDED
 #define FOONATHAN_TINY_TINY_FLAG_SET_HPP_INCLUDED
 
+#include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/detail/index_sequence.hpp>
 #include <foonathan/tiny/detail/select_integer.hpp>
 #include <foonathan/tiny/enum_traits.hpp>
 #include <foonathan/tiny/tiny_type.hpp>
@@ -21,58 +23,245 @@ namespace tiny
             return enum_size<Enum>();
         }
 
+        // flags are stored in words of at most 64 bits
         template <typename Enum>
-        using flag_storage_type = detail::uint_least_n_t<flag_bit_size<Enum>()>;
+        constexpr std::size_t flag_word_count() noexcept
+        {
+            return flag_bit_size<Enum>() == 0u
+                       ? 1u
+                       : (flag_bit_size<Enum>() + max_uint_bits - 1u) / max_uint_bits;
+        }
 
         template <typename Enum>
-        constexpr flag_storage_type<Enum> as_flag(Enum e) noexcept
+        using flag_word_type = detail::uint_least_n_t<(
+            flag_bit_size<Enum>() == 0u
+                ? 1u
+                : (flag_bit_size<Enum>() < max_uint_bits ? flag_bit_size<Enum>() : max_uint_bits))>;
+
+        // the range of bits stored in the given word
+        template <typename Enum, std::size_t Word>
+        struct flag_word_range
         {
-            return flag_storage_type<Enum>(
-                1ull << static_cast<typename std::underlying_type<Enum>::type>(e));
+            static constexpr std::size_t begin = Word * max_uint_bits;
+            static constexpr std::size_t end   = begin + max_uint_bits < flag_bit_size<Enum>()
+                                                   ? begin + max_uint_bits
+                                                   : flag_bit_size<Enum>();
+        };
+
+        template <typename Enum>
+        constexpr std::size_t flag_word_index(Enum e) noexcept
+        {
+            return static_cast<std::size_t>(e) / max_uint_bits;
         }
 
-        template <typename Enum, typename... Flags>
-        detail::flag_storage_type<Enum> combine_flags(Flags... flags) noexcept
+        template <typename Enum>
+        constexpr flag_word_type<Enum> as_flag(Enum e) noexcept
         {
-            flag_storage_type<Enum> storage = 0;
-            bool                    for_each[]
-                = {(storage = flag_storage_type<Enum>(storage | as_flag(flags)), true)..., true};
-            (void)for_each;
-            return storage;
+            return flag_word_type<Enum>(1ull << (static_cast<std::size_t>(e) % max_uint_bits));
+        }
+
+        // the bits of the given word that correspond to a flag
+        template <typename Enum>
+        constexpr flag_word_type<Enum> flag_word_mask(std::size_t word) noexcept
+        {
+            return word + 1u < flag_word_count<Enum>()
+                           || flag_bit_size<Enum>() % max_uint_bits == 0u
+                       ? flag_word_type<Enum>(-1)
+                       : flag_word_type<Enum>((1ull << flag_bit_size<Enum>() % max_uint_bits)
+                                              - 1u);
         }
     } // namespace detail
 
+    template <typename Enum>
+    class tiny_flag_set;
+
     /// Stores a combination of flags.
     ///
     /// This type is the `object_type` of [tiny::tiny_flag_set](),
     /// which means a tiny flag set can be constructed giving it an initial combination of flags.
+    ///
+    /// The flags are stored in an array of words,
+    /// so there is no limit on the number of flags.
+    /// All operations work on one word at a time.
     template <typename Enum>
     class flag_combo
     {
-        flag_combo(detail::flag_storage_type<Enum> flags) noexcept : flags_(flags) {}
+        using word_type                         = detail::flag_word_type<Enum>;
+        static constexpr std::size_t word_count = detail::flag_word_count<Enum>();
+
+    public:
+        //=== single flag operation ===//
+        /// \returns Whether or not the specified flag is set.
+        FOONATHAN_TINY_CONSTEXPR14 bool is_set(Enum flag) const noexcept
+        {
+            return (words_[detail::flag_word_index(flag)] & detail::as_flag(flag)) != 0u;
+        }
+
+        //=== multi flag operations ===//
+        /// \returns Whether or not any flag is set.
+        FOONATHAN_TINY_CONSTEXPR14 bool any() const noexcept
+        {
+            word_type result = 0;
+            for (std::size_t i = 0; i != word_count; ++i)
+                result = word_type(result | words_[i]);
+            return result != 0u;
+        }
+
+        /// \returns Whether or not all flags are set.
+        FOONATHAN_TINY_CONSTEXPR14 bool all() const noexcept
+        {
+            word_type result = 0;
+            for (std::size_t i = 0; i != word_count; ++i)
+                result = word_type(result | (words_[i] ^ detail::flag_word_mask<Enum>(i)));
+            return result == 0u;
+        }
+
+        /// \returns Whether or not no flags are set.
+        FOONATHAN_TINY_CONSTEXPR14 bool none() const noexcept
+        {
+            return !any();
+        }
+
+        /// \returns Whether or not all flags set in `*this` are also set in `other`.
+        FOONATHAN_TINY_CONSTEXPR14 bool is_subset_of(const flag_combo& other) const noexcept
+        {
+            word_type result = 0;
+            for (std::size_t i = 0; i != word_count; ++i)
+                result = word_type(result | (words_[i] & ~other.words_[i]));
+            return result == 0u;
+        }
+
+        /// \returns Whether or not all flags set in `other` are also set in `*this`.
+        FOONATHAN_TINY_CONSTEXPR14 bool is_superset_of(const flag_combo& other) const noexcept
+        {
+            return other.is_subset_of(*this);
+        }
+
+        /// \returns Whether or not at least one flag is set in both.
+        FOONATHAN_TINY_CONSTEXPR14 bool intersects(const flag_combo& other) const noexcept
+        {
+            word_type result = 0;
+            for (std::size_t i = 0; i != word_count; ++i)
+                result = word_type(result | (words_[i] & other.words_[i]));
+            return result != 0u;
+        }
+
+        //=== set algebra ===//
+        /// \effects Sets all flags that are set in `other` (union).
+        FOONATHAN_TINY_CONSTEXPR14 flag_combo& operator|=(const flag_combo& other) noexcept
+        {
+            for (std::size_t i = 0; i != word_count; ++i)
+                words_[i] = word_type(words_[i] | other.words_[i]);
+            return *this;
+        }
 
-        detail::flag_storage_type<Enum> flags_;
+        /// \effects Resets all flags that are not set in `other` (intersection).
+        FOONATHAN_TINY_CONSTEXPR14 flag_combo& operator&=(const flag_combo& other) noexcept
+        {
+            for (std::size_t i = 0; i != word_count; ++i)
+                words_[i] = word_type(words_[i] & other.words_[i]);
+            return *this;
+        }
+
+        /// \effects Resets all flags that are set in `other` (difference).
+        FOONATHAN_TINY_CONSTEXPR14 flag_combo& operator-=(const flag_combo& other) noexcept
+        {
+            for (std::size_t i = 0; i != word_count; ++i)
+                words_[i] = word_type(words_[i] & ~other.words_[i]);
+            return *this;
+        }
+
+        /// \effects Toggles all flags that are set in `other` (symmetric difference).
+        FOONATHAN_TINY_CONSTEXPR14 flag_combo& operator^=(const flag_combo& other) noexcept
+        {
+            for (std::size_t i = 0; i != word_count; ++i)
+                words_[i] = word_type(words_[i] ^ other.words_[i]);
+            return *this;
+        }
+
+        /// \returns The union, intersection, difference or symmetric difference of the flags.
+        /// \group set_algebra
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo operator|(flag_combo        lhs,
+                                                               const flag_combo& rhs) noexcept
+        {
+            return lhs |= rhs;
+        }
+        /// \group set_algebra
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo operator&(flag_combo        lhs,
+                                                               const flag_combo& rhs) noexcept
+        {
+            return lhs &= rhs;
+        }
+        /// \group set_algebra
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo operator-(flag_combo        lhs,
+                                                               const flag_combo& rhs) noexcept
+        {
+            return lhs -= rhs;
+        }
+        /// \group set_algebra
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo operator^(flag_combo        lhs,
+                                                               const flag_combo& rhs) noexcept
+        {
+            return lhs ^= rhs;
+        }
+
+        //=== comparison ===//
+        friend FOONATHAN_TINY_CONSTEXPR14 bool operator==(const flag_combo& lhs,
+                                                          const flag_combo& rhs) noexcept
+        {
+            word_type result = 0;
+            for (std::size_t i = 0; i != word_count; ++i)
+                result = word_type(result | (lhs.words_[i] ^ rhs.words_[i]));
+            return result == 0u;
+        }
+        friend FOONATHAN_TINY_CONSTEXPR14 bool operator!=(const flag_combo& lhs,
+                                                          const flag_combo& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        constexpr flag_combo() noexcept : words_{} {}
+
+        template <typename... Flags>
+        static FOONATHAN_TINY_CONSTEXPR14 flag_combo combine(Flags... flags) noexcept
+        {
+            flag_combo result;
+            bool       for_each[] = {(result.set(flags), true)..., true};
+            (void)for_each;
+            return result;
+        }
+
+        FOONATHAN_TINY_CONSTEXPR14 void set(Enum flag) noexcept
+        {
+            auto& word = words_[detail::flag_word_index(flag)];
+            word       = word_type(word | detail::as_flag(flag));
+        }
+
+        // invariant: bits that do not correspond to a flag are always zero
+        word_type words_[word_count];
 
         template <typename E, typename... Flags>
-        friend flag_combo<E> flags(Flags... flags) noexcept;
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo<E> flags(Flags... flags) noexcept;
         template <typename FirstFlag, typename... OtherFlags>
-        friend flag_combo<FirstFlag> flags(FirstFlag first, OtherFlags... other) noexcept;
-        template <typename E>
-        friend class tiny_flag_set;
+        friend FOONATHAN_TINY_CONSTEXPR14 flag_combo<FirstFlag> flags(FirstFlag first,
+                                                                      OtherFlags... other) noexcept;
+        friend tiny_flag_set<Enum>;
     };
 
     /// \returns A combination of the specified flags.
     /// \group flags
     template <typename Enum, typename... Flags>
-    flag_combo<Enum> flags(Flags... flags) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 flag_combo<Enum> flags(Flags... flags) noexcept
     {
-        return detail::combine_flags<Enum>(flags...);
+        return flag_combo<Enum>::combine(flags...);
     }
     /// \group flags
     template <typename FirstFlag, typename... OtherFlags>
-    flag_combo<FirstFlag> flags(FirstFlag first, OtherFlags... other) noexcept
+    FOONATHAN_TINY_CONSTEXPR14 flag_combo<FirstFlag> flags(FirstFlag first,
+                                                           OtherFlags... other) noexcept
     {
-        return detail::combine_flags<FirstFlag>(first, other...);
+        return flag_combo<FirstFlag>::combine(first, other...);
     }
 
     /// A tiny set of flags.
@@ -80,6 +269,8 @@ namespace tiny
     /// The `Enum` must be an `unsigned` contiguous enum, i.e. it must specialize the
     /// [tiny::enum_traits]() appropriately. Each enum value corresponds to one flag that can either
     /// be set or not set.
+    /// There is no limit on the number of flags,
+    /// operations on all flags are done one word of 64 flags at a time.
     ///
     /// \notes Add a final `flag_count_` or `_count_flag` enum value to get a traits specialization
     /// automatically.
@@ -95,14 +286,59 @@ namespace tiny
         static_assert(traits::is_contiguous, "flags must be contiguous");
         static_assert(traits::min() == enum_type(0), "flags must be unsigned");
 
-        static std::size_t get_flag_index(Enum e) noexcept
+        static constexpr std::size_t get_flag_index(Enum e) noexcept
         {
             return static_cast<std::size_t>(e);
         }
 
-        static std::uintmax_t get_flags(flag_combo<Enum> combo) noexcept
+        using word_type = detail::flag_word_type<Enum>;
+        using words     = detail::make_index_sequence<detail::flag_word_count<Enum>()>;
+
+        template <std::size_t Word, class BitView>
+        static constexpr auto word_view(BitView view) noexcept
+            -> decltype(view.template subview<detail::flag_word_range<Enum, Word>::begin,
+                                              detail::flag_word_range<Enum, Word>::end>())
         {
-            return combo.flags_;
+            return view.template subview<detail::flag_word_range<Enum, Word>::begin,
+                                         detail::flag_word_range<Enum, Word>::end>();
+        }
+
+        template <class BitView, std::size_t... Words>
+        static FOONATHAN_TINY_CONSTEXPR14 flag_combo<Enum> load_words(
+            BitView view, detail::index_sequence<Words...>) noexcept
+        {
+            flag_combo<Enum> result;
+            bool             for_each[]
+                = {(result.words_[Words] = static_cast<word_type>(word_view<Words>(view).extract()),
+                    true)...,
+                   true};
+            (void)for_each;
+            return result;
+        }
+
+        template <class BitView, std::size_t... Words>
+        static FOONATHAN_TINY_CONSTEXPR14 void store_words(
+            BitView view, const flag_combo<Enum>& combo, detail::index_sequence<Words...>) noexcept
+        {
+            bool for_each[] = {(word_view<Words>(view).put(combo.words_[Words]), true)..., true};
+            (void)for_each;
+        }
+
+        template <class BitView, std::size_t... Words>
+        static FOONATHAN_TINY_CONSTEXPR14 void fill_words(
+            BitView view, std::uintmax_t bits, detail::index_sequence<Words...>) noexcept
+        {
+            bool for_each[] = {(word_view<Words>(view).put(bits), true)..., true};
+            (void)for_each;
+        }
+
+        template <class BitView, std::size_t... Words>
+        static FOONATHAN_TINY_CONSTEXPR14 void toggle_words(
+            BitView view, detail::index_sequence<Words...>) noexcept
+        {
+            bool for_each[]
+                = {(word_view<Words>(view).put(~word_view<Words>(view).extract()), true)..., true};
+            (void)for_each;
         }
 
     public:
@@ -118,9 +354,10 @@ namespace tiny
         {
         public:
             /// \effects Assigns the same flags as in the combination.
-            const proxy& operator=(flag_combo<Enum> combo) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(const flag_combo<Enum>& combo) const
+                noexcept
             {
-                view_.put(get_flags(combo));
+                store_words(view_, combo, words{});
                 return *this;
             }
 
@@ -131,9 +368,20 @@ namespace tiny
                 return view_[get_flag_index(flag)];
             }
 
+            /// \returns The combination of all flags that are currently set.
+            FOONATHAN_TINY_CONSTEXPR14 flag_combo<Enum> combo() const noexcept
+            {
+                return load_words(view_, words{});
+            }
+
             /// \returns An integer where the `i`th bit is set if the `i`th flag is set.
-            std::uintmax_t get() const noexcept
+            /// \notes This function is only available if there are no more than 64 flags,
+            /// use `combo()` otherwise.
+            template <std::size_t Size = bit_size()>
+            FOONATHAN_TINY_CONSTEXPR14 std::uintmax_t get() const noexcept
             {
+                static_assert(Size <= bit_view_detail::max_extract_bits,
+                              "too many flags for an integer, use combo() instead");
                 return view_.extract();
             }
 
@@ -170,80 +418,110 @@ namespace tiny
 
             //=== multi flag operations ===//
             /// \returns Whether or not any flag is set.
-            bool any() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bool any() const noexcept
             {
-                return view_.extract() != 0;
+                return combo().any();
             }
 
             /// \returns Whether or not all flags are set.
-            bool all() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bool all() const noexcept
             {
-                return view_.extract() == clear_other_bits<0, bit_size()>(~0ull);
+                return combo().all();
             }
 
             /// \returns Whether or not no flags are set.
-            bool none() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bool none() const noexcept
             {
-                return view_.extract() == 0;
+                return combo().none();
             }
 
             /// \effects Sets all flags to `value`.
-            void set_all(bool value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 void set_all(bool value) const noexcept
             {
-                if (value)
-                    view_.put(~0ull);
-                else
-                    view_.put(0);
+                fill_words(view_, value ? ~std::uintmax_t(0) : std::uintmax_t(0), words{});
             }
 
             /// \effects Sets all flags to `true`.
-            void set_all() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 void set_all() const noexcept
             {
                 set_all(true);
             }
 
             /// \effects Sets all flags to `false`.
-            void reset_all() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 void reset_all() const noexcept
             {
                 set_all(false);
             }
 
             /// \effects Toggles all flags.
-            void toggle_all() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 void toggle_all() const noexcept
+            {
+                toggle_words(view_, words{});
+            }
+
+            //=== set algebra ===//
+            /// \effects Sets all flags that are set in `combo`.
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator|=(
+                const flag_combo<Enum>& combo) const noexcept
+            {
+                return *this = this->combo() | combo;
+            }
+
+            /// \effects Resets all flags that are not set in `combo`.
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator&=(
+                const flag_combo<Enum>& combo) const noexcept
+            {
+                return *this = this->combo() & combo;
+            }
+
+            /// \effects Resets all flags that are set in `combo`.
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator-=(
+                const flag_combo<Enum>& combo) const noexcept
+            {
+                return *this = this->combo() - combo;
+            }
+
+            /// \effects Toggles all flags that are set in `combo`.
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator^=(
+                const flag_combo<Enum>& combo) const noexcept
             {
-                view_.put(~view_.extract());
+                return *this = this->combo() ^ combo;
             }
 
             //=== comparison ===//
-            friend bool operator==(const proxy& lhs, const proxy& rhs) noexcept
+            friend FOONATHAN_TINY_CONSTEXPR14 bool operator==(const proxy& lhs,
+                                                              const proxy& rhs) noexcept
             {
-                return lhs.get() == rhs.get();
+                return lhs.combo() == rhs.combo();
             }
-            friend bool operator!=(const proxy& lhs, const proxy& rhs) noexcept
+            friend FOONATHAN_TINY_CONSTEXPR14 bool operator!=(const proxy& lhs,
+                                                              const proxy& rhs) noexcept
             {
-                return lhs.get() != rhs.get();
+                return lhs.combo() != rhs.combo();
             }
 
-            bool operator==(flag_combo<Enum> rhs) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bool operator==(const flag_combo<Enum>& rhs) const noexcept
             {
-                return get() == get_flags(rhs);
+                return combo() == rhs;
             }
-            bool operator!=(flag_combo<Enum> rhs) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bool operator!=(const flag_combo<Enum>& rhs) const noexcept
             {
-                return get() != get_flags(rhs);
+                return combo() != rhs;
             }
 
-            friend bool operator==(flag_combo<Enum> lhs, const proxy& rhs) noexcept
+            friend FOONATHAN_TINY_CONSTEXPR14 bool operator==(const flag_combo<Enum>& lhs,
+                                                              const proxy&            rhs) noexcept
             {
                 return rhs == lhs;
             }
-            friend bool operator!=(flag_combo<Enum> lhs, const proxy& rhs) noexcept
+            friend FOONATHAN_TINY_CONSTEXPR14 bool operator!=(const flag_combo<Enum>& lhs,
+                                                              const proxy&            rhs) noexcept
             {
                 return rhs != lhs;
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
             BitView view_;
 
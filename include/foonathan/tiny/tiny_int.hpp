@@ -40,12 +40,12 @@ namespace tiny
         class proxy
         {
         public:
-            operator object_type() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 operator object_type() const noexcept
             {
                 return get();
             }
 
-            const proxy& operator=(object_type value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(object_type value) const noexcept
             {
                 DEBUG_ASSERT((are_only_bits<0, bit_size()>(value)), detail::precondition_handler{},
                              "overflow in tiny unsigned");
@@ -53,42 +53,42 @@ namespace tiny
                 return *this;
             }
 
-            const proxy& operator+=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator+=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() + i);
             }
-            const proxy& operator-=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator-=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() - i);
             }
-            const proxy& operator*=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator*=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() * i);
             }
-            const proxy& operator/=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator/=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() / i);
             }
-            const proxy& operator%=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator%=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() % i);
             }
 
-            const proxy& operator++() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator++() const noexcept
             {
                 return *this += 1;
             }
-            object_type operator++(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator++(int) const noexcept
             {
                 auto copy = get();
                 ++*this;
                 return copy;
             }
-            const proxy& operator--() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator--() const noexcept
             {
                 return *this -= 1;
             }
-            object_type operator--(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator--(int) const noexcept
             {
                 auto copy = get();
                 --*this;
@@ -96,9 +96,9 @@ namespace tiny
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
-            object_type get() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type get() const noexcept
             {
                 return static_cast<object_type>(view_.extract());
             }
@@ -134,53 +134,53 @@ namespace tiny
         class proxy
         {
         public:
-            operator object_type() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 operator object_type() const noexcept
             {
                 return get();
             }
 
-            const proxy& operator=(object_type value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(object_type value) const noexcept
             {
                 assign(value);
                 return *this;
             }
 
-            const proxy& operator+=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator+=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() + i);
             }
-            const proxy& operator-=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator-=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() - i);
             }
-            const proxy& operator*=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator*=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() * i);
             }
-            const proxy& operator/=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator/=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() / i);
             }
-            const proxy& operator%=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator%=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() % i);
             }
 
-            const proxy& operator++() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator++() const noexcept
             {
                 return *this += 1u;
             }
-            object_type operator++(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator++(int) const noexcept
             {
                 auto copy = get();
                 ++*this;
                 return copy;
             }
-            const proxy& operator--() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator--() const noexcept
             {
                 return *this -= 1u;
             }
-            object_type operator--(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator--(int) const noexcept
             {
                 auto copy = get();
                 --*this;
@@ -188,23 +188,22 @@ namespace tiny
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
             // note: assuming two's complement representation here
             using unsigned_type = typename std::make_unsigned<Integer>::type;
 
-            object_type get() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type get() const noexcept
             {
+                auto rep = static_cast<unsigned_type>(view_.extract());
                 // look at the most significant bit, which determines the sign
-                if (!view_[Bits - 1])
+                if (((rep >> (Bits - 1)) & 1u) == 0u)
                     // bit not set, positive value
                     // so just return that
-                    return static_cast<object_type>(view_.extract());
+                    return static_cast<object_type>(rep);
                 else
                 {
                     // bit set, negative value
-                    auto rep = static_cast<unsigned_type>(view_.extract());
-
                     // take complement and add one to get the absolute value
                     // and clear any overflow bits
                     auto absolute_value = static_cast<unsigned_type>(~rep + 1);
@@ -218,7 +217,7 @@ namespace tiny
             static constexpr auto min = object_type(-(1ll << (Bits - 1)));
             static constexpr auto max = object_type((1ll << (Bits - 1)) - 1);
 
-            void assign(object_type value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 void assign(object_type value) const noexcept
             {
                 // can't do an overflow check by looking at the bits,
                 // as negative values have ones in the higher bits
@@ -227,7 +226,7 @@ namespace tiny
 
                 // we can however, simply store the `Bits` lower bits,
                 // as truncation will preserve signed-ness
-                auto rep = reinterpret_cast<unsigned_type&>(value);
+                auto rep = static_cast<unsigned_type>(value);
                 view_.put(static_cast<std::uintmax_t>(rep));
             }
 
@@ -273,12 +272,12 @@ namespace tiny
         class proxy
         {
         public:
-            operator object_type() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 operator object_type() const noexcept
             {
                 return get();
             }
 
-            const proxy& operator=(object_type value) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator=(object_type value) const noexcept
             {
                 DEBUG_ASSERT(Min <= value, detail::precondition_handler{},
                              "overflow in tiny_int_range");
@@ -290,42 +289,42 @@ namespace tiny
                 return *this;
             }
 
-            const proxy& operator+=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator+=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() + i);
             }
-            const proxy& operator-=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator-=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() - i);
             }
-            const proxy& operator*=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator*=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() * i);
             }
-            const proxy& operator/=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator/=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() / i);
             }
-            const proxy& operator%=(object_type i) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator%=(object_type i) const noexcept
             {
                 return *this = static_cast<object_type>(get() % i);
             }
 
-            const proxy& operator++() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator++() const noexcept
             {
                 return *this += 1;
             }
-            object_type operator++(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator++(int) const noexcept
             {
                 auto copy = get();
                 ++*this;
                 return copy;
             }
-            const proxy& operator--() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 const proxy& operator--() const noexcept
             {
                 return *this -= 1;
             }
-            object_type operator--(int) const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type operator--(int) const noexcept
             {
                 auto copy = get();
                 --*this;
@@ -333,9 +332,9 @@ namespace tiny
             }
 
         private:
-            explicit proxy(BitView view) noexcept : view_(view) {}
+            explicit constexpr proxy(BitView view) noexcept : view_(view) {}
 
-            object_type get() const noexcept
+            FOONATHAN_TINY_CONSTEXPR14 object_type get() const noexcept
             {
                 return static_cast<object_type>(std::intmax_t(view_.extract()) + Min);
             }
@@ -7,7 +7,10 @@
 
 #include <cstring>
 
+#include <foonathan/tiny/detail/config.hpp>
 #include <foonathan/tiny/detail/index_sequence.hpp>
+#include <foonathan/tiny/detail/select_integer.hpp>
+#include <foonathan/tiny/relocation.hpp>
 #include <foonathan/tiny/tiny_type.hpp>
 
 namespace foonathan
@@ -16,7 +19,85 @@ namespace tiny
 {
     namespace tiny_storage_detail
     {
-        //=== is_target ===//
+        //=== bit_view_of ===//
+#if FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS
+        // flat lookup: the type is found using overload resolution on an indexed base,
+        // everything else is computed by folds, so there is no recursive instantiation
+        template <std::size_t Index, class TinyType>
+        struct indexed_type
+        {
+            using type = TinyType;
+        };
+
+        template <class Indices, class... TinyTypes>
+        struct indexed_types;
+
+        template <std::size_t... Indices, class... TinyTypes>
+        struct indexed_types<detail::index_sequence<Indices...>, TinyTypes...>
+        : indexed_type<Indices, TinyTypes>...
+        {};
+
+        template <std::size_t Index, class TinyType>
+        indexed_type<Index, TinyType> get_indexed(const indexed_type<Index, TinyType>&);
+
+        template <bool Found, std::size_t Index, class IndexedTypes>
+        struct type_at
+        {
+            using type = void;
+        };
+
+        template <std::size_t Index, class IndexedTypes>
+        struct type_at<true, Index, IndexedTypes>
+        {
+            using type = typename decltype(get_indexed<Index>(std::declval<IndexedTypes>()))::type;
+        };
+
+        template <std::size_t Index, class Indices, class... TinyTypes>
+        struct offset_before;
+
+        template <std::size_t Index, std::size_t... Indices, class... TinyTypes>
+        struct offset_before<Index, detail::index_sequence<Indices...>, TinyTypes...>
+        : std::integral_constant<std::size_t,
+                                 ((Indices < Index ? TinyTypes::bit_size() : 0u) + ... + 0u)>
+        {};
+
+        template <typename Target, class Indices, class... TinyTypes>
+        struct find_impl;
+
+        // lookup by type
+        template <typename Target, std::size_t... Indices, class... TinyTypes>
+        struct find_impl<Target, detail::index_sequence<Indices...>, TinyTypes...>
+        {
+            static constexpr std::size_t found_count
+                = (std::size_t(std::is_same<Target, TinyTypes>::value) + ... + 0u);
+            static constexpr std::size_t index
+                = ((std::is_same<Target, TinyTypes>::value ? Indices : 0u) + ... + 0u);
+        };
+
+        // lookup by index
+        template <std::size_t Index, std::size_t... Indices, class... TinyTypes>
+        struct find_impl<std::integral_constant<std::size_t, Index>,
+                         detail::index_sequence<Indices...>, TinyTypes...>
+        {
+            static constexpr std::size_t found_count = Index < sizeof...(TinyTypes) ? 1u : 0u;
+            static constexpr std::size_t index       = Index;
+        };
+
+        template <typename Target, class... TinyTypes>
+        struct find
+        {
+            using indices = detail::make_index_sequence<sizeof...(TinyTypes)>;
+            using result  = find_impl<Target, indices, TinyTypes...>;
+            static_assert(result::found_count > 0, "tiny type not stored");
+            static_assert(result::found_count <= 1, "tiny type ambiguous, use index");
+
+            using type = typename type_at<result::found_count == 1, result::index,
+                                          indexed_types<indices, TinyTypes...>>::type;
+
+            static constexpr std::size_t offset
+                = offset_before<result::index, indices, TinyTypes...>::value;
+        };
+#else
         template <std::size_t Index, typename Target, class TinyType>
         struct is_target : std::false_type
         {};
@@ -30,7 +111,6 @@ namespace tiny
         : std::true_type
         {};
 
-        //=== bit_view_of ===//
         template <typename Target, std::size_t CurIndex, std::size_t CurOffset, class... TinyTypes>
         struct find_impl
         {
@@ -63,6 +143,7 @@ namespace tiny
 
             static constexpr std::size_t offset = result::offset;
         };
+#endif
 
         template <typename Target, class... TinyTypes>
         using tiny_type = typename find<Target, TinyTypes...>::type;
@@ -74,6 +155,12 @@ namespace tiny
         }
 
         //=== total_size ===//
+#if FOONATHAN_TINY_HAS_FOLD_EXPRESSIONS
+        template <class... TinyTypes>
+        struct total_size
+        : std::integral_constant<std::size_t, (TinyTypes::bit_size() + ... + 0u)>
+        {};
+#else
         template <class... TinyTypes>
         struct total_size;
 
@@ -85,6 +172,7 @@ namespace tiny
         struct total_size<Head, Tail...>
         : std::integral_constant<std::size_t, Head::bit_size() + total_size<Tail...>::value>
         {};
+#endif
 
     } // namespace tiny_storage_detail
 
@@ -120,58 +208,101 @@ namespace tiny
         static constexpr auto bit_size_needed = total_bit_size<TinyTypes...>();
         static_assert(bit_size_needed <= BitView::size(), "bit view overflow");
 
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+        // the proxies count the accesses to each tiny type
+        template <std::size_t Begin, std::size_t End>
+        static constexpr auto proxy_view(BitView view) noexcept -> decltype(
+            detail::instrument<tiny_types<TinyTypes...>>(view.template subview<Begin, End>()))
+        {
+            return detail::instrument<tiny_types<TinyTypes...>>(
+                view.template subview<Begin, End>());
+        }
+#else
+        template <std::size_t Begin, std::size_t End>
+        static constexpr auto proxy_view(BitView view) noexcept
+            -> decltype(view.template subview<Begin, End>())
+        {
+            return view.template subview<Begin, End>();
+        }
+#endif
+
         template <class Type, std::size_t Offset>
         using proxy = decltype(make_tiny_proxy<Type>(
-            std::declval<BitView>().template subview<Offset, Offset + Type::bit_size()>()));
+            proxy_view<Offset, Offset + Type::bit_size()>(std::declval<BitView>())));
 
         template <typename Tag>
         using proxy_of = proxy<tiny_storage_detail::tiny_type<Tag, TinyTypes...>,
                                tiny_storage_detail::offset_of<Tag, TinyTypes...>()>;
+
+        template <std::size_t I>
+        using bits_of_t = decltype(std::declval<BitView>().template subview<
+                                   tiny_storage_detail::offset_of<
+                                       std::integral_constant<std::size_t, I>, TinyTypes...>(),
+                                   tiny_storage_detail::offset_of<
+                                       std::integral_constant<std::size_t, I>, TinyTypes...>()
+                                       + tiny_storage_detail::tiny_type<
+                                           std::integral_constant<std::size_t, I>,
+                                           TinyTypes...>::bit_size()>());
         template <typename Tag>
-        proxy_of<Tag> get_impl() const noexcept
+        FOONATHAN_TINY_CONSTEXPR14 proxy_of<Tag> get_impl() const noexcept
         {
             using type            = tiny_storage_detail::tiny_type<Tag, TinyTypes...>;
             constexpr auto offset = tiny_storage_detail::offset_of<Tag, TinyTypes...>();
 
-            return make_tiny_proxy<type>(
-                view_.template subview<offset, offset + type::bit_size()>());
+            return make_tiny_proxy<type>(proxy_view<offset, offset + type::bit_size()>(view_));
         }
 
     public:
         //=== constructors ====//
         /// Creates it from the given bit view.
-        basic_tiny_storage_view(BitView view) noexcept : view_(view) {}
+        constexpr basic_tiny_storage_view(BitView view) noexcept : view_(view) {}
 
         //=== access ===//
         /// Array access operator.
         /// \returns The proxy for the tiny type `T`.
         /// It is an error if there is more than one of those tiny types in the storage.
         template <class T>
-        auto operator[](T) const noexcept -> proxy_of<T>
+        FOONATHAN_TINY_CONSTEXPR14 auto operator[](T) const noexcept -> proxy_of<T>
         {
             return get_impl<T>();
         }
 
         /// \returns The proxy of the tiny type at the specified index.
         template <std::size_t I>
-        auto at() const noexcept -> proxy_of<std::integral_constant<std::size_t, I>>
+        FOONATHAN_TINY_CONSTEXPR14 auto at() const noexcept
+            -> proxy_of<std::integral_constant<std::size_t, I>>
         {
             static_assert(I < sizeof...(TinyTypes), "index out of bounds");
             return get_impl<std::integral_constant<std::size_t, I>>();
         }
 
+        /// \returns A [tiny::bit_view]() to the bits of the tiny type at the specified index,
+        /// i.e. its encoded value.
+        template <std::size_t I>
+        FOONATHAN_TINY_CONSTEXPR14 bits_of_t<I> bits_of() const noexcept
+        {
+            static_assert(I < sizeof...(TinyTypes), "index out of bounds");
+            using type = tiny_storage_detail::tiny_type<std::integral_constant<std::size_t, I>,
+                                                        TinyTypes...>;
+            constexpr auto offset
+                = tiny_storage_detail::offset_of<std::integral_constant<std::size_t, I>,
+                                                 TinyTypes...>();
+            return view_.template subview<offset, offset + type::bit_size()>();
+        }
+
         /// Convenience access for a single tiny type.
         /// \returns `at<0>()`.
         /// \requires Only one tiny type must be stored.
         template <std::size_t Dummy = sizeof...(TinyTypes)>
-        auto tiny() const noexcept -> proxy_of<std::integral_constant<std::size_t, Dummy - 1>>
+        FOONATHAN_TINY_CONSTEXPR14 auto tiny() const noexcept
+            -> proxy_of<std::integral_constant<std::size_t, Dummy - 1>>
         {
             static_assert(Dummy == 1, "only allowed for 1 tiny type");
             return at<0>();
         }
 
         /// \returns A [tiny::bit_view]() of the views that are not used but there for padding.
-        auto spare_bits() const noexcept
+        constexpr auto spare_bits() const noexcept
             -> decltype(std::declval<BitView>().template subview<bit_size_needed, last_bit>())
         {
             return view_.template subview<bit_size_needed, last_bit>();
@@ -190,6 +321,35 @@ namespace tiny
     template <class... TinyTypes>
     using tiny_storage_type_for = tiny_storage_type<total_bit_size<TinyTypes...>()>;
 
+    /// \exclude
+    namespace tiny_storage_detail
+    {
+        template <std::size_t Bits, typename = void>
+        struct word_type_impl
+        {
+            using type = detail::uint_least_n_t<Bits == 0 ? 1 : Bits>;
+        };
+
+        template <std::size_t Bits>
+        struct word_type_impl<Bits, typename std::enable_if<(Bits > detail::max_uint_bits)>::type>
+        {
+            using type
+                = std::uint_least64_t[Bits / detail::max_uint_bits
+                                      + (Bits % detail::max_uint_bits == 0 ? 0 : 1)];
+        };
+    } // namespace tiny_storage_detail
+
+    /// A type that has at least `Bits` bits, stored in words instead of bytes.
+    ///
+    /// If the bits fit into an integer, it is the smallest unsigned integer type that has at least
+    /// `Bits` bits. Otherwise, it is an array of `std::uint_least64_t`.
+    template <std::size_t Bits>
+    using tiny_storage_word_type = typename tiny_storage_detail::word_type_impl<Bits>::type;
+
+    /// A type that is able to store the specified tiny types in words.
+    template <class... TinyTypes>
+    using tiny_storage_word_type_for = tiny_storage_word_type<total_bit_size<TinyTypes...>()>;
+
     /// The basic template for storing multiple tiny types.
     ///
     /// It provides and implements the accessing function and manages the exact offsets of the tiny
@@ -220,15 +380,16 @@ namespace tiny
         /// \param 1
         /// \exclude
         template <typename T = default_ctor_tag>
-        basic_tiny_storage(typename std::enable_if<sizeof...(TinyTypes) != 0, T>::type
-                           = {}) noexcept
+        FOONATHAN_TINY_CONSTEXPR14 basic_tiny_storage(
+            typename std::enable_if<sizeof...(TinyTypes) != 0, T>::type = {}) noexcept
         {
             clear_bits(this->storage_view());
         }
 
         /// Object constructor.amazon
         /// \effects Initializes all tiny types from the corresponding object type.
-        basic_tiny_storage(typename TinyTypes::object_type... objects) noexcept
+        FOONATHAN_TINY_CONSTEXPR14 basic_tiny_storage(
+            typename TinyTypes::object_type... objects) noexcept
         : basic_tiny_storage(detail::make_index_sequence<sizeof...(TinyTypes)>{}, objects...)
         {}
 
@@ -244,13 +405,15 @@ namespace tiny
         /// It is an error if there is more than one of those tiny types in the storage.
         /// \group array
         template <class T>
-        auto operator[](T) noexcept -> decltype(std::declval<view>()[T{}])
+        FOONATHAN_TINY_CONSTEXPR14 auto operator[](T) noexcept
+            -> decltype(std::declval<view>()[T{}])
         {
             return view(this->storage_view())[T{}];
         }
         /// \group array
         template <class T>
-        auto operator[](T) const noexcept -> decltype(std::declval<cview>()[T{}])
+        FOONATHAN_TINY_CONSTEXPR14 auto operator[](T) const noexcept
+            -> decltype(std::declval<cview>()[T{}])
         {
             return cview(this->storage_view())[T{}];
         }
@@ -258,41 +421,63 @@ namespace tiny
         /// \returns The proxy of the tiny type at the specified index.
         /// \group at
         template <std::size_t I>
-        auto at() noexcept -> decltype(std::declval<view>().template at<I>())
+        FOONATHAN_TINY_CONSTEXPR14 auto at() noexcept
+            -> decltype(std::declval<view>().template at<I>())
         {
             return view(this->storage_view()).template at<I>();
         }
         /// \group at
         template <std::size_t I>
-        auto at() const noexcept -> decltype(std::declval<cview>().template at<I>())
+        FOONATHAN_TINY_CONSTEXPR14 auto at() const noexcept
+            -> decltype(std::declval<cview>().template at<I>())
         {
             return cview(this->storage_view()).template at<I>();
         }
 
+        /// \returns A [tiny::bit_view]() to the bits of the tiny type at the specified index,
+        /// i.e. its encoded value.
+        /// \group bits_of
+        template <std::size_t I>
+        FOONATHAN_TINY_CONSTEXPR14 auto bits_of() noexcept
+            -> decltype(std::declval<view>().template bits_of<I>())
+        {
+            return view(this->storage_view()).template bits_of<I>();
+        }
+        /// \group bits_of
+        template <std::size_t I>
+        FOONATHAN_TINY_CONSTEXPR14 auto bits_of() const noexcept
+            -> decltype(std::declval<cview>().template bits_of<I>())
+        {
+            return cview(this->storage_view()).template bits_of<I>();
+        }
+
         /// Convenience access for a single tiny type.
         /// \returns `at<0>()`.
         /// \requires Only one tiny type must be stored.
         /// \group tiny
         template <typename View = view>
-        auto tiny() noexcept -> decltype(std::declval<View>().tiny())
+        FOONATHAN_TINY_CONSTEXPR14 auto tiny() noexcept -> decltype(std::declval<View>().tiny())
         {
             return view(this->storage_view()).tiny();
         }
         /// \group tiny
         template <typename View = cview>
-        auto tiny() const noexcept -> decltype(std::declval<View>().tiny())
+        FOONATHAN_TINY_CONSTEXPR14 auto tiny() const noexcept
+            -> decltype(std::declval<View>().tiny())
         {
             return cview(this->storage_view()).tiny();
         }
 
         /// \returns A [tiny::bit_view]() of the views that are not used but there for padding.
         /// \group spare_bits
-        auto spare_bits() noexcept -> decltype(std::declval<view>().spare_bits())
+        FOONATHAN_TINY_CONSTEXPR14 auto spare_bits() noexcept
+            -> decltype(std::declval<view>().spare_bits())
         {
             return view(storage_policy().storage_view()).spare_bits();
         }
         /// \group spare_bits
-        auto spare_bits() const noexcept -> decltype(std::declval<cview>().spare_bits())
+        FOONATHAN_TINY_CONSTEXPR14 auto spare_bits() const noexcept
+            -> decltype(std::declval<cview>().spare_bits())
         {
             return cview(storage_policy().storage_view()).spare_bits();
         }
@@ -302,21 +487,23 @@ namespace tiny
 
         /// \returns The storage policy.
         /// \group storage_policy
-        TinyStoragePolicy& storage_policy() noexcept
+        FOONATHAN_TINY_CONSTEXPR14 TinyStoragePolicy& storage_policy() noexcept
         {
             return *this;
         }
         /// \group storage_policy
-        const TinyStoragePolicy& storage_policy() const noexcept
+        constexpr const TinyStoragePolicy& storage_policy() const noexcept
         {
             return *this;
         }
 
     private:
         template <std::size_t... Indices>
-        basic_tiny_storage(detail::index_sequence<Indices...>,
-                           typename TinyTypes::object_type... objects)
+        FOONATHAN_TINY_CONSTEXPR14 basic_tiny_storage(detail::index_sequence<Indices...>,
+                                                      typename TinyTypes::object_type... objects)
         {
+            // assigning a tiny type only changes its bits, so the others need to be initialized
+            clear_bits(this->storage_view());
             bool for_each[] = {(at<Indices>() = objects, true)..., true};
             (void)for_each;
         }
@@ -333,19 +520,43 @@ namespace tiny
 
             using storage_type = tiny_storage_type_for<TinyTypes...>;
 
-            bit_view<storage_type, 0, last_bit> storage_view() noexcept
+            FOONATHAN_TINY_CONSTEXPR14 bit_view<storage_type, 0, last_bit> storage_view() noexcept
             {
                 return make_bit_view<0, last_bit>(storage_);
             }
-            bit_view<const storage_type, 0, last_bit> storage_view() const noexcept
+            constexpr bit_view<const storage_type, 0, last_bit> storage_view() const noexcept
             {
                 return make_bit_view<0, last_bit>(storage_);
             }
 
-            storage_type storage_;
+            // initialized for constexpr, the constructors clear it anyway
+            storage_type storage_{};
 
             friend basic_tiny_storage<embedded_storage_policy<TinyTypes...>, TinyTypes...>;
         };
+
+        template <class... TinyTypes>
+        class word_storage_policy
+        {
+            using is_compressed = std::false_type;
+
+            word_storage_policy() noexcept = default;
+
+            using storage_type = tiny_storage_word_type_for<TinyTypes...>;
+
+            FOONATHAN_TINY_CONSTEXPR14 bit_view<storage_type, 0, last_bit> storage_view() noexcept
+            {
+                return make_bit_view<0, last_bit>(storage_);
+            }
+            constexpr bit_view<const storage_type, 0, last_bit> storage_view() const noexcept
+            {
+                return make_bit_view<0, last_bit>(storage_);
+            }
+
+            storage_type storage_{};
+
+            friend basic_tiny_storage<word_storage_policy<TinyTypes...>, TinyTypes...>;
+        };
     } // namespace tiny_storage_detail
 
     /// A compressed tuple of tiny types.
@@ -358,6 +569,54 @@ namespace tiny
         using basic_tiny_storage<tiny_storage_detail::embedded_storage_policy<TinyTypes...>,
                                  TinyTypes...>::basic_tiny_storage;
     };
+
+    /// A compressed tuple of tiny types that is stored in words instead of bytes.
+    ///
+    /// Unlike [tiny::tiny_storage](), a tiny type is usually accessed with a single load, shift
+    /// and mask, instead of assembling it byte by byte.
+    /// However, it has the size and alignment of the word type, which might be bigger.
+    /// If all tiny types together need at most 64 bits, no tiny type crosses a word boundary.
+    template <class... TinyTypes>
+    class word_tiny_storage
+    : public basic_tiny_storage<tiny_storage_detail::word_storage_policy<TinyTypes...>,
+                                TinyTypes...>
+    {
+    public:
+        using basic_tiny_storage<tiny_storage_detail::word_storage_policy<TinyTypes...>,
+                                 TinyTypes...>::basic_tiny_storage;
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::tiny_storage]().
+    /// \group relocatable
+    template <class... TinyTypes>
+    struct is_trivially_relocatable<tiny_storage<TinyTypes...>> : std::true_type
+    {};
+    /// \group relocatable
+    template <class... TinyTypes>
+    struct is_trivially_relocatable<word_tiny_storage<TinyTypes...>> : std::true_type
+    {};
+
+    /// \exclude
+    namespace tiny_storage_detail
+    {
+        template <class Policy, class... TinyTypes>
+        tiny_types<TinyTypes...> tiny_types_of(const basic_tiny_storage<Policy, TinyTypes...>&);
+    } // namespace tiny_storage_detail
+
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+    /// \returns The accesses counted through the proxies of the tiny type at the given index.
+    /// \requires `Storage` must be a [tiny::basic_tiny_storage]().
+    /// \notes This function is only available if `FOONATHAN_TINY_ENABLE_INSTRUMENTATION` is `1`.
+    /// Storages with the same tiny types and the same kind of storage share their counters.
+    template <class Storage, std::size_t I>
+    access_count field_access_count() noexcept
+    {
+        using field_view = typename detail::mutable_bit_view<decltype(
+            std::declval<Storage&>().template bits_of<I>())>::type;
+        using types = decltype(tiny_storage_detail::tiny_types_of(std::declval<const Storage&>()));
+        return detail::field_access_counter<field_view, types>().count();
+    }
+#endif
 } // namespace tiny
 } // namespace foonathan
 
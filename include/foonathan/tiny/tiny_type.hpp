@@ -48,25 +48,47 @@ namespace tiny
     class tiny_type_access
     {
         template <class TinyType, class View>
-        static auto make(View view) noexcept -> typename TinyType::template proxy<View>
+        static constexpr auto make(View view) noexcept -> typename TinyType::template proxy<View>
         {
             return typename TinyType::template proxy<View>(view);
         }
 
         template <class TinyType, typename Integer, std::size_t Begin, std::size_t End>
-        friend auto make_tiny_proxy(bit_view<Integer, Begin, End> view) noexcept ->
+        friend constexpr auto make_tiny_proxy(bit_view<Integer, Begin, End> view) noexcept ->
             typename TinyType::template proxy<bit_view<Integer, Begin, End>>;
+
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+        template <class TinyType, class BitView, class FieldView, class TinyTypes>
+        friend constexpr auto make_tiny_proxy(
+            detail::instrumented_bit_view<BitView, FieldView, TinyTypes> view) noexcept ->
+            typename TinyType::template proxy<
+                detail::instrumented_bit_view<BitView, FieldView, TinyTypes>>;
+#endif
     };
 
     /// Creates a `TinyType` proxy viewing the given bits.
     template <class TinyType, typename Integer, std::size_t Begin, std::size_t End>
-    auto make_tiny_proxy(bit_view<Integer, Begin, End> view) noexcept ->
+    constexpr auto make_tiny_proxy(bit_view<Integer, Begin, End> view) noexcept ->
         typename TinyType::template proxy<bit_view<Integer, Begin, End>>
     {
         static_assert(view.size() == TinyType::bit_size(), "invalid size");
         return tiny_type_access::make<TinyType>(view);
     }
 
+#if FOONATHAN_TINY_ENABLE_INSTRUMENTATION
+    /// Creates a `TinyType` proxy that counts the accesses.
+    /// \exclude
+    template <class TinyType, class BitView, class FieldView, class TinyTypes>
+    constexpr auto make_tiny_proxy(
+        detail::instrumented_bit_view<BitView, FieldView, TinyTypes> view) noexcept ->
+        typename TinyType::template proxy<
+            detail::instrumented_bit_view<BitView, FieldView, TinyTypes>>
+    {
+        static_assert(view.size() == TinyType::bit_size(), "invalid size");
+        return tiny_type_access::make<TinyType>(view);
+    }
+#endif
+
     namespace detail
     {
         template <typename T, typename = decltype(make_tiny_proxy<T>(
@@ -6,8 +6,10 @@
 #define FOONATHAN_TINY_TOMBSTONE_HPP_INCLUDED
 
 #include <cstddef>
+#include <limits>
 #include <new>
 
+#include <foonathan/tiny/enum_traits.hpp>
 #include <foonathan/tiny/padding_traits.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
@@ -80,6 +82,14 @@ namespace tiny
         /// The number of tombstones that are available.
         static constexpr std::size_t tombstone_count = 0u;
 
+        /// Whether or not a tombstone is a constant byte pattern.
+        ///
+        /// If it is `true`, `create_tombstone()` sets all bytes of the storage to values that only
+        /// depend on the tombstone index,
+        /// so a tombstone can be created by copying the bytes of a storage that contains it.
+        /// This member is optional, see [tiny::has_constant_tombstone_pattern]().
+        static constexpr bool constant_tombstone_pattern = false;
+
         /// \effects Creates the tombstone with the specified index in the storage.
         /// \requires The storage must currently contain nothing and `tombstone_index <
         /// tombstone_count`.
@@ -127,6 +137,32 @@ namespace tiny
         }
     };
 
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename T>
+        struct void_type
+        {
+            using type = void;
+        };
+    } // namespace tombstone_detail
+
+    /// Whether or not the tombstones of `T` are constant byte patterns.
+    ///
+    /// It is `true` if the [tiny::tombstone_traits]() of `T` have a member
+    /// `constant_tombstone_pattern` that is `true`, `false` otherwise.
+    template <typename T, typename = void>
+    struct has_constant_tombstone_pattern : std::false_type
+    {};
+
+    /// \exclude
+    template <typename T>
+    struct has_constant_tombstone_pattern<
+        T, typename tombstone_detail::void_type<decltype(
+               tombstone_traits<T>::constant_tombstone_pattern)>::type>
+    : std::integral_constant<bool, tombstone_traits<T>::constant_tombstone_pattern>
+    {};
+
     //=== tombstone_traits_simple ===//
     /// \exclude
     namespace tombstone_detail
@@ -220,6 +256,172 @@ namespace tiny
         }
     };
 
+    //=== tombstone_traits for pointer and size ===//
+    /// The layout of a type that consists of a pointer followed by a size.
+    ///
+    /// It is used for [tiny::tombstone_traits_pointer_size]().
+    template <typename Pointer, typename Size>
+    struct pointer_size_layout
+    {
+        Pointer pointer;
+        Size    size;
+    };
+
+    /// The layout of a type that consists of a size followed by a pointer.
+    ///
+    /// It is used for [tiny::tombstone_traits_pointer_size]().
+    template <typename Size, typename Pointer>
+    struct size_pointer_layout
+    {
+        Size    size;
+        Pointer pointer;
+    };
+
+    /// A tombstone traits implementation for types that consist of a pointer and a size,
+    /// like a `std::string_view`.
+    ///
+    /// `Layout` is either [tiny::pointer_size_layout]() or [tiny::size_pointer_layout]()
+    /// and must be layout compatible with `T`.
+    /// The tombstones are a `nullptr` with a non-zero size,
+    /// which is never a valid range.
+    ///
+    /// When specializing the traits, simply inherit from it.
+    template <typename T, class Layout>
+    struct tombstone_traits_pointer_size : tombstone_traits_simple<T, Layout>
+    {
+    private:
+        using size_type = decltype(std::declval<Layout&>().size);
+        static_assert(std::is_unsigned<size_type>::value, "size must be unsigned");
+
+        static constexpr std::size_t max_count = std::size_t(-1) >> 1;
+
+    public:
+        static constexpr std::size_t tombstone_count
+            = (std::numeric_limits<size_type>::max)() < max_count
+                  ? std::size_t((std::numeric_limits<size_type>::max)())
+                  : max_count;
+
+        // the layout is value initialized, so the padding is zero as well
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            auto layout     = ::new (memory) Layout();
+            layout->pointer = nullptr;
+            layout->size    = static_cast<size_type>(index + 1u);
+        }
+
+        static std::size_t get_tombstone_impl(const Layout& layout) noexcept
+        {
+            // a valid object with nullptr must have size zero,
+            // so subtracting one overflows to an invalid index
+            return layout.pointer == nullptr ? static_cast<std::size_t>(layout.size) - 1u
+                                             : tombstone_count;
+        }
+    };
+
+    //=== tombstone_traits using sentinels ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename T, bool IsEnum = std::is_enum<T>::value>
+        struct sentinel_integer
+        {
+            static_assert(std::is_integral<T>::value, "sentinels must be integers or enums");
+            using type = T;
+        };
+
+        template <typename T>
+        struct sentinel_integer<T, true>
+        {
+            using type = typename std::underlying_type<T>::type;
+        };
+
+        template <typename T>
+        constexpr typename sentinel_integer<T>::type to_sentinel_integer(T value) noexcept
+        {
+            return static_cast<typename sentinel_integer<T>::type>(value);
+        }
+    } // namespace tombstone_detail
+
+    /// A tombstone traits implementation that uses the specified values as tombstones.
+    ///
+    /// `T` must be an integer or enumeration type,
+    /// like a strong ID type `enum class id : std::uint32_t {}`.
+    ///
+    /// When specializing the traits, simply inherit from it.
+    /// \requires The `Sentinels` are all distinct and are never values of valid objects.
+    template <typename T, T... Sentinels>
+    struct tombstone_traits_sentinel : tombstone_traits_simple<T>
+    {
+        static_assert(sizeof...(Sentinels) > 0u, "need at least one sentinel");
+
+        static constexpr std::size_t tombstone_count = sizeof...(Sentinels);
+
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            const T sentinels[] = {Sentinels...};
+            ::new (memory) T(sentinels[index]);
+        }
+
+        static std::size_t get_tombstone_impl(const T& value) noexcept
+        {
+            const T sentinels[] = {Sentinels...};
+            for (auto i = 0u; i != tombstone_count; ++i)
+                if (sentinels[i] == value)
+                    return i;
+            return tombstone_count;
+        }
+    };
+
+    /// A tombstone traits implementation that uses all values in the range `[First, Last]` as
+    /// tombstones.
+    ///
+    /// `T` must be an integer or enumeration type.
+    ///
+    /// When specializing the traits, simply inherit from it.
+    /// \requires The values in the range are never values of valid objects.
+    template <typename T, T First, T Last>
+    struct tombstone_traits_sentinel_range : tombstone_traits_simple<T>
+    {
+    private:
+        using integer = typename tombstone_detail::sentinel_integer<T>::type;
+        static_assert(tombstone_detail::to_sentinel_integer(First)
+                          <= tombstone_detail::to_sentinel_integer(Last),
+                      "invalid range");
+
+        // computed modulo 2^N, so it works for signed integers as well
+        static constexpr std::uintmax_t first_uint
+            = static_cast<std::uintmax_t>(tombstone_detail::to_sentinel_integer(First));
+        static constexpr std::uintmax_t range_size
+            = static_cast<std::uintmax_t>(tombstone_detail::to_sentinel_integer(Last)) - first_uint;
+        static constexpr std::uintmax_t max_count = std::size_t(-1) >> 1;
+
+    public:
+        static constexpr std::size_t tombstone_count
+            = std::size_t(range_size < max_count ? range_size + 1u : max_count);
+
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            ::new (memory) T(static_cast<T>(static_cast<integer>(first_uint + index)));
+        }
+
+        static std::size_t get_tombstone_impl(const T& value) noexcept
+        {
+            auto int_value = tombstone_detail::to_sentinel_integer(value);
+            if (int_value < tombstone_detail::to_sentinel_integer(First)
+                || tombstone_detail::to_sentinel_integer(Last) < int_value)
+                return tombstone_count;
+
+            auto index = static_cast<std::uintmax_t>(int_value) - first_uint;
+            return index < tombstone_count ? std::size_t(index) : tombstone_count;
+        }
+    };
+
     //=== tombstone_traits using padding ===//
     /// A tombstone traits implementation that uses the padding bits to mark the tombstones.
     ///
@@ -371,6 +573,8 @@ namespace tiny
 
         static constexpr std::size_t tombstone_count = (1u << (CHAR_BIT - 1)) - 1;
 
+        static constexpr bool constant_tombstone_pattern = true;
+
         static void create_tombstone(storage_type& storage, std::size_t index) noexcept
         {
             // add one so that the higher bits are never zero
@@ -402,6 +606,111 @@ namespace tiny
         }
     };
 
+    //=== tombstone_traits for enums ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename Enum>
+        struct enum_tombstones
+        {
+            using traits     = enum_traits<Enum>;
+            using underlying = typename std::underlying_type<Enum>::type;
+
+            // all computations are done modulo 2^N, so the differences are correct for signed
+            // types as well
+            static constexpr std::uintmax_t as_uint(underlying value) noexcept
+            {
+                return static_cast<std::uintmax_t>(value);
+            }
+
+            static constexpr std::uintmax_t min() noexcept
+            {
+                return as_uint(static_cast<underlying>(traits::min()));
+            }
+            static constexpr std::uintmax_t max() noexcept
+            {
+                return as_uint(static_cast<underlying>(traits::max()));
+            }
+
+            static constexpr std::uintmax_t max_count = std::size_t(-1) >> 1;
+
+            static constexpr std::uintmax_t min_of(std::uintmax_t a, std::uintmax_t b) noexcept
+            {
+                return a < b ? a : b;
+            }
+
+            // tombstones above the maximal value come first, then the ones below the minimal
+            static constexpr std::uintmax_t above_count
+                = min_of(as_uint((std::numeric_limits<underlying>::max)()) - max(), max_count);
+            static constexpr std::uintmax_t below_count
+                = min_of(min() - as_uint((std::numeric_limits<underlying>::min)()),
+                         max_count - above_count);
+
+            static constexpr std::size_t count = std::size_t(above_count + below_count);
+        };
+
+        template <typename T, typename = void>
+        struct has_enum_tombstones : std::false_type
+        {};
+
+        template <typename T>
+        struct has_enum_tombstones<T, typename std::enable_if<std::is_enum<T>::value>::type>
+        : std::integral_constant<bool, enum_traits<T>::is_specialized
+                                           && enum_traits<T>::is_contiguous
+                                           && (enum_tombstones<T>::count > 0u)>
+        {};
+    } // namespace tombstone_detail
+
+    /// Specialization of the tombstone traits for enumerations with specialized
+    /// [tiny::enum_traits]().
+    ///
+    /// It will use the values of the underlying type that are outside of the range `[min, max]`,
+    /// starting with the ones after `max`.
+    /// \requires The enum must be contiguous, i.e. the enum must never store values outside of
+    /// the range.
+    template <typename Enum>
+    struct tombstone_traits<
+        Enum, typename std::enable_if<tombstone_detail::has_enum_tombstones<Enum>::value>::type>
+    : tombstone_traits_simple<Enum, typename std::underlying_type<Enum>::type>
+    {
+    private:
+        using info       = tombstone_detail::enum_tombstones<Enum>;
+        using underlying = typename info::underlying;
+
+    public:
+        static constexpr std::size_t tombstone_count = info::count;
+
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            auto value = index < info::above_count ? info::max() + 1u + index
+                                                   : info::min() - 1u - (index - info::above_count);
+            ::new (memory) underlying(static_cast<underlying>(value));
+        }
+
+        static std::size_t get_tombstone_impl(underlying value) noexcept
+        {
+            auto min = static_cast<underlying>(enum_traits<Enum>::min());
+            auto max = static_cast<underlying>(enum_traits<Enum>::max());
+
+            auto index = tombstone_count;
+            if (value > max)
+            {
+                auto above = info::as_uint(value) - info::max() - 1u;
+                if (above < info::above_count)
+                    index = std::size_t(above);
+            }
+            else if (value < min)
+            {
+                auto below = info::min() - info::as_uint(value) - 1u;
+                if (below < info::below_count)
+                    index = std::size_t(info::above_count + below);
+            }
+            return index;
+        }
+    };
+
     //=== tombstone_traits for pointers ===//
     /// \exclude
     template <typename T, std::size_t Alignment>
@@ -421,6 +730,8 @@ namespace tiny
             // alignment zero is valid
             static constexpr std::size_t tombstone_count = Alignment - 1;
 
+            static constexpr bool constant_tombstone_pattern = true;
+
             static void create_tombstone(storage_type& storage,
                                          std::size_t   tombstone_index) noexcept
             {
@@ -0,0 +1,85 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
+#define FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
+
+#include <functional>
+#include <memory>
+
+#include <foonathan/tiny/tombstone.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// Specialization of the tombstone traits for `std::unique_ptr` with the default deleter.
+    ///
+    /// Like for raw pointers, it will use the invalid alignments.
+    /// \notes It assumes that the `std::unique_ptr` is layout compatible with a pointer,
+    /// which is true for all implementations I'm aware of.
+    /// If it isn't, the specialization is disabled.
+    template <typename T>
+    struct tombstone_traits<
+        std::unique_ptr<T, std::default_delete<T>>,
+        typename std::enable_if<
+            is_layout_compatible<std::unique_ptr<T, std::default_delete<T>>,
+                                 std::uintptr_t>::value>::type>
+    : tombstone_traits_simple<std::unique_ptr<T, std::default_delete<T>>, std::uintptr_t>
+    {
+    private:
+        static constexpr std::size_t alignment = alignof(typename std::remove_extent<T>::type);
+
+    public:
+        // alignment zero is valid
+        static constexpr std::size_t tombstone_count = alignment - 1;
+
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            ::new (memory) std::uintptr_t(static_cast<std::uintptr_t>(index + 1));
+        }
+
+        static std::size_t get_tombstone_impl(std::uintptr_t ptr) noexcept
+        {
+            // same as for raw pointers
+            return (ptr % alignment) - 1;
+        }
+    };
+
+    /// Specialization of the tombstone traits for `std::reference_wrapper`.
+    ///
+    /// As a reference is never `nullptr`, it will use `nullptr` as well as the invalid
+    /// alignments.
+    /// \notes It assumes that the `std::reference_wrapper` is layout compatible with a pointer,
+    /// which is true for all implementations I'm aware of.
+    /// If it isn't, the specialization is disabled.
+    template <typename T>
+    struct tombstone_traits<std::reference_wrapper<T>,
+                            typename std::enable_if<
+                                !std::is_function<T>::value
+                                && is_layout_compatible<std::reference_wrapper<T>,
+                                                        std::uintptr_t>::value>::type>
+    : tombstone_traits_simple<std::reference_wrapper<T>, std::uintptr_t>
+    {
+        // all values less than the alignment are not valid addresses of a T
+        static constexpr std::size_t tombstone_count = alignof(T);
+
+        static constexpr bool constant_tombstone_pattern = true;
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            ::new (memory) std::uintptr_t(static_cast<std::uintptr_t>(index));
+        }
+
+        static std::size_t get_tombstone_impl(std::uintptr_t ptr) noexcept
+        {
+            return ptr < tombstone_count ? static_cast<std::size_t>(ptr) : tombstone_count;
+        }
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
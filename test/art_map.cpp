@@ -0,0 +1,155 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/art_map.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <typename Key>
+void verify(const art_map<Key, std::string>& map, const std::map<Key, std::string>& expected)
+{
+    REQUIRE(map.size() == expected.size());
+    REQUIRE(map.empty() == expected.empty());
+    for (auto& entry : expected)
+    {
+        auto value = map.find(entry.first);
+        REQUIRE(value);
+        REQUIRE(*value == entry.second);
+    }
+
+    // visited in order
+    std::vector<std::pair<Key, std::string>> visited;
+    map.for_each([&](Key key, const std::string& value) { visited.emplace_back(key, value); });
+    REQUIRE(visited == std::vector<std::pair<Key, std::string>>(expected.begin(), expected.end()));
+}
+
+template <typename Key>
+void test_map(const std::vector<Key>& keys)
+{
+    art_map<Key, std::string> map;
+    std::map<Key, std::string> expected;
+    REQUIRE(!map.contains(0u));
+    REQUIRE(!map.erase(0u));
+    REQUIRE(map.memory_usage() == 0u);
+
+    for (auto key : keys)
+    {
+        auto result = map.insert(key, std::to_string(key));
+        REQUIRE(result.second == expected.emplace(key, std::to_string(key)).second);
+        REQUIRE(*result.first == expected[key]);
+    }
+    verify(map, expected);
+
+    // not inserted again
+    auto result = map.insert(keys.front(), "new");
+    REQUIRE(!result.second);
+    REQUIRE(*result.first == std::to_string(keys.front()));
+    *result.first = "new";
+    expected[keys.front()] = "new";
+    verify(map, expected);
+
+    // erase every second key, so nodes shrink
+    auto memory = map.memory_usage();
+    for (auto i = 0u; i < keys.size(); i += 2u)
+    {
+        REQUIRE(map.erase(keys[i]) == (expected.erase(keys[i]) == 1u));
+        REQUIRE(!map.erase(keys[i]));
+    }
+    verify(map, expected);
+    REQUIRE(map.memory_usage() < memory);
+
+    // insert them again
+    for (auto i = 0u; i < keys.size(); i += 2u)
+    {
+        map.insert(keys[i], "again");
+        expected.emplace(keys[i], "again");
+    }
+    verify(map, expected);
+
+    art_map<Key, std::string> moved(std::move(map));
+    REQUIRE(map.empty());
+    verify(moved, expected);
+
+    for (auto key : keys)
+    {
+        moved.erase(key);
+        expected.erase(key);
+    }
+    verify(moved, expected);
+    REQUIRE(moved.memory_usage() == 0u);
+}
+} // namespace
+
+TEST_CASE("art_map")
+{
+    SECTION("dense")
+    {
+        // a single node with a child for every byte
+        std::vector<std::uint8_t> keys;
+        for (auto i = 0u; i != 256u; ++i)
+            keys.push_back(std::uint8_t(i * 37u));
+        test_map(keys);
+    }
+    SECTION("sequential")
+    {
+        std::vector<std::uint32_t> keys;
+        for (auto i = 0u; i != 3000u; ++i)
+            keys.push_back(i);
+        test_map(keys);
+    }
+    SECTION("sparse")
+    {
+        // few different bytes at every level, so there are long prefixes and small nodes
+        std::vector<std::uint64_t> keys;
+        for (auto i = 0u; i != 500u; ++i)
+            keys.push_back(std::uint64_t(i % 5u) << 60 | std::uint64_t(i % 3u) << 33
+                           | std::uint64_t(i / 15u) << 8 | i % 2u);
+        test_map(keys);
+    }
+    SECTION("random")
+    {
+        std::vector<std::uint64_t> keys;
+        auto                       state = std::uint64_t(42);
+        for (auto i = 0u; i != 2000u; ++i)
+        {
+            // xorshift
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            keys.push_back(i % 4u == 0u ? state : state & 0xFFFFFFFFu);
+        }
+        test_map(keys);
+    }
+    SECTION("prefix split and merge")
+    {
+        art_map<std::uint32_t, std::string> map;
+        map.insert(0x01020304u, "a");
+        map.insert(0x01020305u, "b");
+        // splits the prefix 01 02 03
+        map.insert(0x01FF0000u, "c");
+        REQUIRE(*map.find(0x01020304u) == "a");
+        REQUIRE(*map.find(0x01FF0000u) == "c");
+        REQUIRE(!map.contains(0x01020300u));
+        REQUIRE(!map.contains(0x01FF0001u));
+
+        // merges the prefix again
+        REQUIRE(map.erase(0x01FF0000u));
+        REQUIRE(*map.find(0x01020305u) == "b");
+        REQUIRE(!map.contains(0x01FF0000u));
+
+        art_map<std::uint32_t, std::string> other;
+        other.insert(0x01020304u, "a");
+        other.insert(0x01020305u, "b");
+        REQUIRE(map.memory_usage() == other.memory_usage());
+    }
+}
@@ -373,3 +373,28 @@ TEST_CASE("bit_view convenience")
     value = clear_other_bits<1, 2>(value);
     REQUIRE(value == 0);
 }
+
+#if FOONATHAN_TINY_HAS_CONSTEXPR14
+namespace
+{
+constexpr std::uintmax_t round_trip_array(std::uintmax_t bits)
+{
+    // crosses multiple array elements
+    std::uint8_t array[4] = {};
+    make_bit_view<3, 29>(array).put(bits);
+    return make_bit_view<3, 29>(array).extract() + array[0];
+}
+} // namespace
+
+TEST_CASE("bit_view constexpr")
+{
+    static_assert(put_bits<1, 3>(0u, 7u) == 6u, "");
+    static_assert(extract_bits<1, 3>(6u) == 3u, "");
+    static_assert(are_only_bits<0, 3>(7u), "");
+    static_assert(clear_other_bits<1, 2>(7u) == 2u, "");
+
+    constexpr auto result = round_trip_array(0x3ffffffu);
+    static_assert(result == 0x3ffffffu + 0xf8u, "");
+    REQUIRE(round_trip_array(0x3ffffffu) == result);
+}
+#endif
@@ -0,0 +1,132 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/enum_bitmap_index.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+enum class state
+{
+    a,
+    b,
+    c,
+    d,
+
+    unsigned_count_,
+};
+
+state state_of(std::size_t row)
+{
+    return state(row % 7u % 4u);
+}
+
+std::size_t expected_count(std::size_t size, state s1, state s2)
+{
+    std::size_t result = 0;
+    for (auto i = 0u; i != size; ++i)
+        if (state_of(i) == s1 || state_of(i) == s2)
+            ++result;
+    return result;
+}
+} // namespace
+
+TEST_CASE("row_bitmap")
+{
+    row_bitmap bitmap(130);
+    REQUIRE(bitmap.size() == 130u);
+    REQUIRE(bitmap.count() == 0u);
+
+    bitmap.set(0);
+    bitmap.set(64);
+    bitmap.set(129);
+    REQUIRE(bitmap.count() == 3u);
+    REQUIRE(bitmap.is_set(64));
+    REQUIRE(!bitmap.is_set(65));
+
+    std::vector<std::size_t> rows;
+    bitmap.for_each([&](std::size_t row) { rows.push_back(row); });
+    REQUIRE(rows == (std::vector<std::size_t>{0, 64, 129}));
+
+    row_bitmap other(130);
+    other.set(64);
+    other.set(100);
+    REQUIRE((bitmap & other).count() == 1u);
+    REQUIRE((bitmap | other).count() == 4u);
+    REQUIRE((bitmap - other).count() == 2u);
+    REQUIRE(!(bitmap - other).is_set(64));
+
+    bitmap.reset(64);
+    REQUIRE(bitmap.count() == 2u);
+    REQUIRE(bitmap != other);
+}
+
+TEST_CASE("enum_bitmap_index")
+{
+    enum_bitmap_index<state> index;
+    REQUIRE(index.empty());
+    REQUIRE(index.count(state::a) == 0u);
+
+    auto size = 1000u;
+    for (auto i = 0u; i != size; ++i)
+        index.push_back(state_of(i));
+    REQUIRE(index.size() == size);
+
+    for (auto i = 0u; i != size; ++i)
+        REQUIRE(index[i] == state_of(i));
+
+    REQUIRE(index.count(state::a) == expected_count(size, state::a, state::a));
+    REQUIRE(index.count(state::a, state::c) == expected_count(size, state::a, state::c));
+    REQUIRE(index.count(state::a, state::b, state::c, state::d) == size);
+
+    auto selected = index.select(state::b, state::d);
+    REQUIRE(selected.size() == size);
+    REQUIRE(selected.count() == expected_count(size, state::b, state::d));
+    selected.for_each([&](std::size_t row) {
+        REQUIRE((state_of(row) == state::b || state_of(row) == state::d));
+    });
+
+    SECTION("assign")
+    {
+        index.assign(3, state::a);
+        index.assign(999, state::a);
+        REQUIRE(index[3] == state::a);
+        REQUIRE(index[999] == state::a);
+        REQUIRE(index.count(state::a) == expected_count(size, state::a, state::a) + 2u);
+        REQUIRE(index.count(state::a, state::b, state::c, state::d) == size);
+    }
+    SECTION("clear")
+    {
+        index.clear();
+        REQUIRE(index.empty());
+        REQUIRE(index.count(state::a) == 0u);
+    }
+}
+
+TEST_CASE("enum_bitmap_index over tiny_enum column")
+{
+    using row = tiny_storage<tiny_enum<state>, tiny_enum<state>>;
+
+    std::vector<row> rows;
+    for (auto i = 0u; i != 100u; ++i)
+        rows.emplace_back(state_of(i), state::c);
+
+    std::vector<state> column;
+    for (auto& r : rows)
+        column.push_back(r.at<0>());
+
+    enum_bitmap_index<state> index(column.begin(), column.end());
+    REQUIRE(index.size() == 100u);
+    REQUIRE(index.count(state::a, state::c) == expected_count(100u, state::a, state::c));
+
+    rows[5].at<0>() = state::d;
+    index.assign(5, rows[5].at<0>());
+    REQUIRE(index[5] == state::d);
+}
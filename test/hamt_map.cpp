@@ -0,0 +1,134 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/hamt_map.hpp>
+
+#include <catch.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+// only uses a few bits, so there are many collisions
+struct bad_hash
+{
+    std::size_t operator()(int i) const
+    {
+        return std::size_t(i % 7);
+    }
+};
+
+// uses the higher bits, so the trie is deep
+struct deep_hash
+{
+    std::size_t operator()(int i) const
+    {
+        return std::size_t(i) << (sizeof(std::size_t) * 8u - 8u);
+    }
+};
+
+template <class Map>
+void verify(const Map& map, const std::map<int, std::string>& expected)
+{
+    REQUIRE(map.size() == expected.size());
+    REQUIRE(map.empty() == expected.empty());
+    for (auto& entry : expected)
+    {
+        auto value = map.find(entry.first);
+        REQUIRE(value);
+        REQUIRE(*value == entry.second);
+    }
+
+    std::map<int, std::string> visited;
+    map.for_each([&](int key, const std::string& value) {
+        REQUIRE(visited.count(key) == 0u);
+        visited[key] = value;
+    });
+    REQUIRE(visited == expected);
+}
+
+template <class Hash>
+void test_map()
+{
+    using map = hamt_map<int, std::string, Hash>;
+
+    map empty;
+    verify(empty, {});
+    REQUIRE(!empty.contains(0));
+    REQUIRE(empty.erase(0).empty());
+
+    // every version is kept as snapshot
+    std::vector<map>                        versions{empty};
+    std::vector<std::map<int, std::string>> expected(1u);
+    for (auto i = 0; i != 300; ++i)
+    {
+        auto key = (i * 37) % 300;
+        versions.push_back(versions.back().set(key, std::to_string(i)));
+        expected.push_back(expected.back());
+        expected.back()[key] = std::to_string(i);
+    }
+    // overwrite some
+    for (auto i = 0; i < 300; i += 3)
+    {
+        versions.push_back(versions.back().set(i, "new"));
+        expected.push_back(expected.back());
+        expected.back()[i] = "new";
+    }
+    // erase some
+    for (auto i = 0; i < 300; i += 2)
+    {
+        versions.push_back(versions.back().erase(i));
+        expected.push_back(expected.back());
+        expected.back().erase(i);
+
+        // already erased
+        REQUIRE(versions.back().erase(i).size() == versions.back().size());
+    }
+
+    for (auto i = 0u; i < versions.size(); i += 7u)
+        verify(versions[i], expected[i]);
+    verify(versions.back(), expected.back());
+
+    // erase everything
+    auto cur = versions.back();
+    for (auto& entry : expected.back())
+        cur = cur.erase(entry.first);
+    verify(cur, {});
+    verify(versions.back(), expected.back());
+}
+} // namespace
+
+TEST_CASE("hamt_map")
+{
+    SECTION("std::hash")
+    {
+        test_map<std::hash<int>>();
+    }
+    SECTION("collisions")
+    {
+        test_map<bad_hash>();
+    }
+    SECTION("deep")
+    {
+        test_map<deep_hash>();
+    }
+    SECTION("structural sharing")
+    {
+        hamt_map<int, std::string> map;
+        for (auto i = 0; i != 100; ++i)
+            map = map.set(i, std::to_string(i));
+
+        auto snapshot = map;
+        auto changed  = map.set(42, "changed");
+        REQUIRE(*snapshot.find(42) == "42");
+        REQUIRE(*changed.find(42) == "changed");
+        // unchanged keys are shared
+        REQUIRE(snapshot.find(11) == changed.find(11));
+        REQUIRE(snapshot.find(42) != changed.find(42));
+    }
+}
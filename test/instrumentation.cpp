@@ -0,0 +1,98 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compiled in a separate executable with FOONATHAN_TINY_ENABLE_INSTRUMENTATION=1
+#include <foonathan/tiny/instrumentation.hpp>
+
+#include <catch.hpp>
+
+#include <sstream>
+
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+using namespace foonathan::tiny;
+
+static_assert(FOONATHAN_TINY_ENABLE_INSTRUMENTATION, "instrumentation must be enabled");
+
+TEST_CASE("instrumentation")
+{
+    reset_access_counts();
+
+    SECTION("bit_view")
+    {
+        using view = bit_view<std::uint16_t, 2, 9>;
+
+        std::uint16_t i = 0;
+        view(i).put(42);
+        REQUIRE(view(i).extract() == 42);
+        REQUIRE(make_bit_view<2, 9>(static_cast<const std::uint16_t&>(i)).extract() == 42);
+
+        auto count = bit_view_access_count<view>();
+        REQUIRE(count.reads == 2u);
+        REQUIRE(count.writes == 1u);
+        REQUIRE(count.straddling == 0u);
+
+        unsigned char array[2] = {};
+        using array_view       = bit_view<unsigned char[2], 4, 12>;
+        array_view(array).put(0xFF);
+        REQUIRE(array_view(array).extract() == 0xFF);
+
+        count = bit_view_access_count<array_view>();
+        REQUIRE(count.reads == 1u);
+        REQUIRE(count.writes == 1u);
+        REQUIRE(count.straddling == 2u);
+
+        reset_access_counts();
+        count = bit_view_access_count<view>();
+        REQUIRE(count.reads == 0u);
+        REQUIRE(count.writes == 0u);
+    }
+    SECTION("tiny_storage")
+    {
+        using storage = tiny_storage<tiny_unsigned<3>, tiny_unsigned<7>, tiny_bool>;
+
+        storage s;
+        s.at<1>() = 100u;
+        s.at<2>() = true;
+        REQUIRE(s.at<1>() == 100u);
+        REQUIRE(s.at<2>());
+        s.at<1>() += 1u;
+
+        const auto& cs = s;
+        REQUIRE(cs.at<1>() == 101u);
+
+        auto count = field_access_count<storage, 0>();
+        REQUIRE(count.reads == 0u);
+        REQUIRE(count.writes == 0u);
+
+        count = field_access_count<storage, 1>();
+        REQUIRE(count.reads == 3u);
+        REQUIRE(count.writes == 2u);
+        REQUIRE(count.straddling == 5u);
+
+        count = field_access_count<storage, 2>();
+        REQUIRE(count.reads == 1u);
+        REQUIRE(count.writes == 1u);
+        REQUIRE(count.straddling == 0u);
+
+        std::ostringstream out;
+        dump_access_counts(out);
+        REQUIRE(out.str().find("3 reads, 2 writes, 5 straddling\n") != std::string::npos);
+    }
+    SECTION("word_tiny_storage")
+    {
+        using storage = word_tiny_storage<tiny_unsigned<3>, tiny_unsigned<7>, tiny_bool>;
+
+        storage s;
+        s.at<1>() = 100u;
+        REQUIRE(s.at<1>() == 100u);
+
+        auto count = field_access_count<storage, 1>();
+        REQUIRE(count.reads == 1u);
+        REQUIRE(count.writes == 1u);
+        REQUIRE(count.straddling == 0u);
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/layout_report.hpp>
+
+#include <catch.hpp>
+
+#include <sstream>
+
+#include <foonathan/tiny/padding_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct big_padding
+{
+    std::uint8_t  a;
+    std::uint64_t b;
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct padding_traits<big_padding>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(big_padding, a),
+                               FOONATHAN_TINY_MEMBER(big_padding, b)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("layout_report")
+{
+    SECTION("tiny_storage")
+    {
+        using report = layout_report<
+            tiny_storage<tiny_unsigned<3>, tiny_unsigned<7>, tiny_bool, tiny_unsigned<16>>>;
+        static_assert(report::field_count() == 4u, "");
+        static_assert(report::used_bits() == 27u, "");
+        static_assert(report::wasted_bits() == 5u, "");
+        static_assert(report::max_words() == 3u, "");
+
+        static_assert(report::field(0).offset == 0u, "");
+        static_assert(report::field(0).bit_size == 3u, "");
+        static_assert(report::field(0).words == 1u, "");
+        static_assert(!report::field(0).straddles_byte, "");
+        static_assert(!report::field(0).straddles_word, "");
+        static_assert(report::field(0).read_modify_write, "");
+
+        static_assert(report::field(1).offset == 3u, "");
+        static_assert(report::field(1).words == 2u, "");
+        static_assert(report::field(1).straddles_byte, "");
+        static_assert(report::field(1).straddles_word, "");
+
+        static_assert(report::field(2).offset == 10u, "");
+        static_assert(report::field(2).words == 1u, "");
+        static_assert(!report::field(2).straddles_word, "");
+
+        static_assert(report::field(3).offset == 11u, "");
+        static_assert(report::field(3).bit_size == 16u, "");
+        static_assert(report::field(3).words == 3u, "");
+    }
+    SECTION("word_tiny_storage")
+    {
+        using storage
+            = word_tiny_storage<tiny_unsigned<3>, tiny_unsigned<7>, tiny_bool, tiny_unsigned<16>>;
+        using report = layout_report<storage>;
+        static_assert(report::field_count() == 4u, "");
+        static_assert(report::used_bits() == 27u, "");
+        static_assert(report::wasted_bits() == sizeof(storage) * CHAR_BIT - 27u, "");
+        static_assert(report::max_words() == 1u, "");
+
+        static_assert(report::field(1).words == 1u, "");
+        static_assert(report::field(1).straddles_byte, "");
+        static_assert(!report::field(1).straddles_word, "");
+        static_assert(report::field(3).words == 1u, "");
+        static_assert(report::field(3).read_modify_write, "");
+
+        static_assert(check_field_words<storage, 3, 1>(), "");
+    }
+    SECTION("padding_tiny_storage")
+    {
+        using report
+            = layout_report<padding_tiny_storage<big_padding, tiny_unsigned<8>, tiny_bool>>;
+        static_assert(report::field_count() == 2u, "");
+        static_assert(report::used_bits() == 9u, "");
+        static_assert(report::wasted_bits() == 7u * CHAR_BIT - 9u, "");
+
+        static_assert(report::field(0).offset == 0u, "");
+        static_assert(report::field(0).words == 1u, "");
+        static_assert(!report::field(0).read_modify_write, "");
+        static_assert(report::field(1).offset == 8u, "");
+        static_assert(report::field(1).words == 1u, "");
+    }
+    SECTION("print")
+    {
+        std::ostringstream out;
+        print_layout_report<tiny_storage<tiny_unsigned<3>, tiny_unsigned<7>>>(out);
+        REQUIRE(out.str()
+                == "field 0: bits [0, 3), 1 word(s), read-modify-write\n"
+                   "field 1: bits [3, 10), 2 word(s), straddles word, read-modify-write\n"
+                   "used bits: 10, wasted bits: 6\n");
+    }
+}
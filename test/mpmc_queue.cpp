@@ -0,0 +1,129 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/mpmc_queue.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+TEST_CASE("mpmc_queue")
+{
+    SECTION("sequence distance")
+    {
+        using mpmc_detail::distance;
+        using mpmc_detail::sequence_mask;
+        REQUIRE(distance(5u, 5u) == 0);
+        REQUIRE(distance(5u, 3u) == 2);
+        REQUIRE(distance(3u, 5u) == -2);
+        // the position has more bits than the sequence
+        REQUIRE(distance(1u, sequence_mask + 2u) == 0);
+        REQUIRE(distance(0u, sequence_mask) == 1);
+        REQUIRE(distance(sequence_mask, 0u) == -1);
+    }
+    SECTION("single thread")
+    {
+        mpmc_queue<std::string> queue(5u);
+        REQUIRE(queue.capacity() == 8u);
+        REQUIRE(queue.size_approx() == 0u);
+        // 64 bit atomics are lock-free on all 64 bit platforms
+        if (sizeof(void*) == sizeof(std::uint64_t))
+            REQUIRE(queue.is_lock_free());
+
+        std::string result;
+        REQUIRE(!queue.try_pop(result));
+
+        // multiple rounds through the ring buffer
+        for (auto round = 0; round != 3; ++round)
+        {
+            for (auto i = 0; i != 8; ++i)
+                REQUIRE(queue.try_push(std::to_string(round * 8 + i)));
+            REQUIRE(queue.size_approx() == 8u);
+
+            std::string full("full");
+            REQUIRE(!queue.try_push(std::move(full)));
+            REQUIRE(full == "full");
+
+            for (auto i = 0; i != 8; ++i)
+            {
+                REQUIRE(queue.try_pop(result));
+                REQUIRE(result == std::to_string(round * 8 + i));
+            }
+            REQUIRE(!queue.try_pop(result));
+        }
+
+        const std::string copy = "copy";
+        REQUIRE(queue.try_push(copy));
+        REQUIRE(queue.try_pop(result));
+        REQUIRE(result == "copy");
+    }
+    SECTION("destroys remaining objects")
+    {
+        auto ptr = std::make_shared<int>(42);
+        {
+            mpmc_queue<std::shared_ptr<int>> queue(4u);
+            for (auto i = 0; i != 3; ++i)
+                queue.try_push(ptr);
+
+            std::shared_ptr<int> result;
+            REQUIRE(queue.try_pop(result));
+            REQUIRE(ptr.use_count() == 4);
+        }
+        REQUIRE(ptr.use_count() == 1);
+    }
+    SECTION("multiple threads")
+    {
+        constexpr auto producers = 4u;
+        constexpr auto consumers = 4u;
+        constexpr auto count     = 20000u;
+
+        mpmc_queue<unsigned> queue(64u);
+
+        std::vector<std::thread> threads;
+        for (auto p = 0u; p != producers; ++p)
+            threads.emplace_back([&, p] {
+                for (auto i = 0u; i != count; ++i)
+                    while (!queue.try_push(p * count + i))
+                        std::this_thread::yield();
+            });
+
+        std::vector<std::vector<unsigned>> popped(consumers);
+        for (auto c = 0u; c != consumers; ++c)
+            threads.emplace_back([&, c] {
+                unsigned value;
+                for (auto i = 0u; i != producers * count / consumers; ++i)
+                {
+                    while (!queue.try_pop(value))
+                        std::this_thread::yield();
+                    popped[c].push_back(value);
+                }
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(queue.size_approx() == 0u);
+
+        std::vector<unsigned> seen(producers * count);
+        for (auto& values : popped)
+        {
+            // the objects of a single producer are popped in order
+            std::vector<unsigned> last(producers);
+            for (auto value : values)
+            {
+                auto producer = value / count;
+                REQUIRE(value % count >= last[producer]);
+                last[producer] = value % count;
+                ++seen[value];
+            }
+        }
+        for (auto times : seen)
+            REQUIRE(times == 1u);
+    }
+}
@@ -40,6 +40,15 @@ enum class foo
     c,
     _unsigned_count,
 };
+
+enum class bar : std::uint8_t
+{
+    a,
+    b,
+    c,
+    unsigned_count_,
+};
+static_assert(sizeof(optional_impl<bar>) == sizeof(bar), "");
 } // namespace
 
 namespace foonathan
@@ -76,6 +85,12 @@ TEST_CASE("optional_impl")
         verify_optional_impl(foo::b, true);
         verify_optional_impl(foo::c, true);
     }
+    SECTION("compressed: enum with enum traits")
+    {
+        verify_optional_impl(bar::a, true);
+        verify_optional_impl(bar::b, true);
+        verify_optional_impl(bar::c, true);
+    }
     SECTION("compressed: optional optional bool")
     {
         using opt_t = optional_impl<optional_impl<bool>>;
@@ -144,3 +159,73 @@ TEST_CASE("optional_impl")
         REQUIRE(!opt.has_value());
     }
 }
+
+namespace
+{
+template <typename T>
+void verify_bulk(const T& obj)
+{
+    optional_impl<T> array[37];
+    for (auto i = 0u; i < 37u; i += 2u)
+        array[i].create_value(obj);
+
+    destroy_all(array, array + 37);
+    for (auto& opt : array)
+        REQUIRE(!opt.has_value());
+
+    for (auto& opt : array)
+        opt.create_value(obj);
+    destroy_all(array + 1, array + 36);
+    REQUIRE(array[0].has_value());
+    for (auto i = 1u; i != 36u; ++i)
+        REQUIRE(!array[i].has_value());
+    REQUIRE(array[36].has_value());
+
+    // doesn't touch the neighbours
+    fill_empty(array + 1, array + 36);
+    REQUIRE(array[0].has_value());
+    REQUIRE(array[0].value() == obj);
+    for (auto i = 1u; i != 36u; ++i)
+        REQUIRE(!array[i].has_value());
+    REQUIRE(array[36].has_value());
+    REQUIRE(array[36].value() == obj);
+    destroy_all(array, array + 37);
+
+    // empty ranges are fine
+    fill_empty(array, array);
+    destroy_all(array, array);
+}
+} // namespace
+
+TEST_CASE("optional_impl bulk")
+{
+    static_assert(has_constant_tombstone_pattern<int*>::value, "");
+    static_assert(has_constant_tombstone_pattern<bool>::value, "");
+    static_assert(has_constant_tombstone_pattern<bar>::value, "");
+    static_assert(has_constant_tombstone_pattern<optional_impl<bool>>::value, "");
+    static_assert(!has_constant_tombstone_pattern<foo>::value, "");
+    static_assert(!has_constant_tombstone_pattern<int>::value, "");
+
+    int i = 0;
+    SECTION("pointer")
+    {
+        verify_bulk(&i);
+    }
+    SECTION("bool")
+    {
+        verify_bulk(true);
+    }
+    SECTION("enum with enum traits")
+    {
+        verify_bulk(bar::b);
+    }
+    SECTION("tiny enum")
+    {
+        verify_bulk(foo::c);
+    }
+    SECTION("not compressed")
+    {
+        verify_bulk(42);
+        verify_bulk(std::string("a string that is longer than the small string buffer"));
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/packed_column.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/tiny_bool.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <class TinyType>
+void verify_kernels(const packed_column<TinyType>& column,
+                    const std::vector<typename TinyType::object_type>& values,
+                    value_range                                        range)
+{
+    std::vector<std::size_t> indices;
+    for (auto i = 0u; i != values.size(); ++i)
+        if (range.lower <= std::intmax_t(values[i]) && std::intmax_t(values[i]) < range.upper)
+            indices.push_back(i);
+
+    REQUIRE(count_if(column, range) == indices.size());
+    REQUIRE(select_indices(column, range) == indices);
+}
+
+template <class TinyType>
+void verify_column(const std::vector<typename TinyType::object_type>& values)
+{
+    packed_column<TinyType> column;
+    for (auto value : values)
+        column.push_back(value);
+    REQUIRE(column.size() == values.size());
+
+    for (auto i = 0u; i != values.size(); ++i)
+        REQUIRE(column[i] == values[i]);
+
+    auto min_value = values.front();
+    auto max_value = values.front();
+    auto sum_value = std::intmax_t(0);
+    for (auto value : values)
+    {
+        if (value < min_value)
+            min_value = value;
+        if (value > max_value)
+            max_value = value;
+        sum_value += value;
+    }
+    REQUIRE(column_min(column) == min_value);
+    REQUIRE(column_max(column) == max_value);
+    REQUIRE(sum(column) == sum_value);
+
+    using traits = ordered_tiny_traits<TinyType>;
+    for (auto lower = traits::min_value() - 1; lower <= traits::max_value() + 1; ++lower)
+        for (auto upper = lower; upper <= traits::max_value() + 2; ++upper)
+            verify_kernels(column, values, in_range(lower, upper));
+    verify_kernels(column, values, equal_to(values.back()));
+}
+} // namespace
+
+TEST_CASE("packed_column")
+{
+    SECTION("tiny_bool")
+    {
+        packed_column<tiny_bool> column;
+        REQUIRE(column.empty());
+        static_assert(packed_column<tiny_bool>::objects_per_word == 64u, "");
+
+        for (auto i = 0u; i != 100u; ++i)
+            column.push_back(i % 3 == 0);
+        REQUIRE(column.size() == 100u);
+        for (auto i = 0u; i != 100u; ++i)
+            REQUIRE(column[i] == (i % 3 == 0));
+
+        column.set(1, true);
+        REQUIRE(column[1]);
+        REQUIRE(!column[2]);
+
+        column.clear();
+        REQUIRE(column.empty());
+    }
+    SECTION("tiny_unsigned")
+    {
+        // 21 objects per word, so there are unused bits
+        std::vector<unsigned> values;
+        for (auto i = 0u; i != 100u; ++i)
+            values.push_back((i * 5u + 3u) % 8u);
+        verify_column<tiny_unsigned<3>>(values);
+
+        // less than a word
+        values.resize(10);
+        verify_column<tiny_unsigned<3>>(values);
+
+        // exactly one word
+        values.clear();
+        for (auto i = 0u; i != 8u; ++i)
+            values.push_back(255u - i * 20u);
+        verify_column<tiny_unsigned<8>>(values);
+    }
+    SECTION("tiny_int_range")
+    {
+        std::vector<int> values;
+        for (auto i = 0; i != 77; ++i)
+            values.push_back((i * 7) % 11 - 5);
+        verify_column<tiny_int_range<-5, 5>>(values);
+    }
+}
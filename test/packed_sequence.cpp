@@ -0,0 +1,109 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/packed_sequence.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <typename Integer>
+void verify_sequence(const std::vector<Integer>& values)
+{
+    packed_sequence<Integer> seq(values.begin(), values.end());
+    REQUIRE(seq.size() == values.size());
+    REQUIRE(seq.empty() == values.empty());
+    REQUIRE(seq.block_count() == (values.size() + 127u) / 128u);
+
+    for (auto i = 0u; i != values.size(); ++i)
+        REQUIRE(seq[i] == values[i]);
+
+    Integer block[128];
+    for (auto b = 0u; b != seq.block_count(); ++b)
+    {
+        auto count = seq.decode_block(b, block);
+        REQUIRE(count == (b + 1u == seq.block_count() ? values.size() - b * 128u : 128u));
+        for (auto i = 0u; i != count; ++i)
+            REQUIRE(block[i] == values[b * 128u + i]);
+    }
+}
+} // namespace
+
+TEST_CASE("packed_sequence")
+{
+    SECTION("empty")
+    {
+        packed_sequence<unsigned> seq;
+        REQUIRE(seq.empty());
+        REQUIRE(seq.block_count() == 0u);
+        REQUIRE(seq.lower_bound(0u) == 0u);
+    }
+    SECTION("sorted timestamps")
+    {
+        std::vector<std::uint64_t> values;
+        auto                       timestamp = std::uint64_t(1) << 40;
+        for (auto i = 0u; i != 1000u; ++i)
+        {
+            timestamp += (i * 7u) % 13u;
+            values.push_back(timestamp);
+        }
+        verify_sequence(values);
+
+        packed_sequence<std::uint64_t> seq(values.begin(), values.end());
+        // a block spans at most 128 * 12 = 1536, which needs 11 bits
+        for (auto b = 0u; b != seq.block_count(); ++b)
+            REQUIRE(seq.block_bit_width(b) <= 11u);
+        REQUIRE(seq.memory_usage() < values.size() * sizeof(std::uint64_t) / 4u);
+
+        REQUIRE(seq.lower_bound(0u) == 0u);
+        REQUIRE(seq.lower_bound(values.back() + 1u) == values.size());
+        for (auto i = 0u; i != values.size(); ++i)
+        {
+            auto expected = std::size_t(
+                std::lower_bound(values.begin(), values.end(), values[i]) - values.begin());
+            REQUIRE(seq.lower_bound(values[i]) == expected);
+            REQUIRE(seq.lower_bound(values[i] + 1u)
+                    == std::size_t(std::lower_bound(values.begin(), values.end(), values[i] + 1u)
+                                   - values.begin()));
+        }
+    }
+    SECTION("constant")
+    {
+        std::vector<unsigned> values(300, 42u);
+        verify_sequence(values);
+
+        packed_sequence<unsigned> seq(values.begin(), values.end());
+        REQUIRE(seq.block_bit_width(0) == 0u);
+        REQUIRE(seq.lower_bound(42u) == 0u);
+        REQUIRE(seq.lower_bound(43u) == 300u);
+    }
+    SECTION("all widths")
+    {
+        for (auto width = 0u; width <= 64u; ++width)
+        {
+            std::vector<std::uint64_t> values;
+            auto max = width == 64u ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1u;
+            for (auto i = 0u; i != 200u; ++i)
+                values.push_back(i % 3u == 0u ? max : i * 0x9E3779B97F4A7C15ull & max);
+            values[0] = 0u;
+            verify_sequence(values);
+
+            packed_sequence<std::uint64_t> seq(values.begin(), values.end());
+            REQUIRE(seq.block_bit_width(0) == width);
+        }
+    }
+    SECTION("signed")
+    {
+        std::vector<std::int16_t> values;
+        for (auto i = 0; i != 500; ++i)
+            values.push_back(static_cast<std::int16_t>((i * 37) % 201 - 100));
+        values.push_back(std::numeric_limits<std::int16_t>::min());
+        values.push_back(std::numeric_limits<std::int16_t>::max());
+        verify_sequence(values);
+    }
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/packed_shared_ptr.hpp>
+
+#include <catch.hpp>
+
+#include <type_traits>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct base : packed_ref_counted
+{
+    static int destroyed;
+
+    int value;
+
+    explicit base(int value) : value(value) {}
+    virtual ~base() noexcept
+    {
+        ++destroyed;
+    }
+};
+int base::destroyed = 0;
+
+struct derived : base
+{
+    derived() : base(42) {}
+};
+
+struct non_virtual_base : packed_ref_counted
+{};
+
+struct non_virtual_derived : non_virtual_base
+{};
+
+// deleting through non_virtual_base* would be undefined behavior
+static_assert(std::is_constructible<packed_shared_ptr<base>, packed_shared_ptr<derived>>::value,
+              "");
+static_assert(!std::is_constructible<packed_shared_ptr<non_virtual_base>,
+                                     packed_shared_ptr<non_virtual_derived>>::value,
+              "");
+static_assert(!std::is_constructible<packed_shared_ptr<non_virtual_base>,
+                                     const packed_shared_ptr<non_virtual_derived>&>::value,
+              "");
+} // namespace
+
+TEST_CASE("packed_shared_ptr")
+{
+    static_assert(sizeof(packed_shared_ptr<base>) == sizeof(base*), "");
+    base::destroyed = 0;
+
+    SECTION("null")
+    {
+        packed_shared_ptr<base> ptr;
+        REQUIRE(!ptr);
+        REQUIRE(ptr == nullptr);
+        REQUIRE(ptr.get() == nullptr);
+        REQUIRE(ptr.use_count() == 0u);
+
+        packed_shared_ptr<base> copy(ptr);
+        REQUIRE(copy == nullptr);
+        REQUIRE(copy == ptr);
+    }
+    SECTION("basic")
+    {
+        {
+            auto ptr = make_packed_shared<base>(11);
+            REQUIRE(ptr);
+            REQUIRE(ptr != nullptr);
+            REQUIRE(ptr->value == 11);
+            REQUIRE((*ptr).value == 11);
+            REQUIRE(ptr.use_count() == 1u);
+
+            {
+                auto copy = ptr;
+                REQUIRE(copy == ptr);
+                REQUIRE(ptr.use_count() == 2u);
+                REQUIRE(copy.use_count() == 2u);
+
+                auto moved = std::move(copy);
+                REQUIRE(copy == nullptr);
+                REQUIRE(moved == ptr);
+                REQUIRE(ptr.use_count() == 2u);
+            }
+            REQUIRE(ptr.use_count() == 1u);
+            REQUIRE(base::destroyed == 0);
+
+            auto other = make_packed_shared<base>(12);
+            ptr        = other;
+            REQUIRE(base::destroyed == 1);
+            REQUIRE(ptr == other);
+            REQUIRE(ptr.use_count() == 2u);
+
+            ptr.reset();
+            REQUIRE(ptr == nullptr);
+            REQUIRE(other.use_count() == 1u);
+        }
+        REQUIRE(base::destroyed == 2);
+    }
+    SECTION("conversion")
+    {
+        {
+            packed_shared_ptr<base> ptr = make_packed_shared<derived>();
+            REQUIRE(ptr->value == 42);
+            REQUIRE(ptr.use_count() == 1u);
+
+            auto                    d = make_packed_shared<derived>();
+            packed_shared_ptr<base> copy(d);
+            REQUIRE(copy == d);
+            REQUIRE(d.use_count() == 2u);
+        }
+        REQUIRE(base::destroyed == 2);
+    }
+    SECTION("overflow")
+    {
+        {
+            auto ptr = make_packed_shared<base>(0);
+
+            std::vector<packed_shared_ptr<base>> copies;
+            for (auto i = 1u; i != 3 * packed_ref_counted::inline_count_max; ++i)
+            {
+                REQUIRE(ptr.use_count() == i);
+                copies.push_back(ptr);
+            }
+            REQUIRE(ptr.use_count() == 3 * packed_ref_counted::inline_count_max);
+
+            while (!copies.empty())
+            {
+                copies.pop_back();
+                REQUIRE(ptr.use_count() == copies.size() + 1u);
+            }
+            REQUIRE(base::destroyed == 0);
+        }
+        REQUIRE(base::destroyed == 1);
+    }
+    SECTION("detach, share and adopt")
+    {
+        {
+            auto  ptr = make_packed_shared<base>(0);
+            base* raw = ptr.detach();
+            REQUIRE(!ptr);
+            REQUIRE(raw->use_count() == 1u);
+
+            auto shared = packed_shared_ptr<base>::share(raw);
+            REQUIRE(shared.get() == raw);
+            REQUIRE(shared.use_count() == 2u);
+
+            auto adopted = packed_shared_ptr<base>::adopt(raw);
+            REQUIRE(adopted.get() == raw);
+            REQUIRE(adopted.use_count() == 2u);
+
+            shared.reset();
+            REQUIRE(adopted.use_count() == 1u);
+            REQUIRE(base::destroyed == 0);
+        }
+        REQUIRE(base::destroyed == 1);
+
+        REQUIRE(!packed_shared_ptr<base>::share(nullptr));
+        REQUIRE(!packed_shared_ptr<base>::adopt(nullptr));
+    }
+    SECTION("copy of object")
+    {
+        auto ptr = make_packed_shared<base>(0);
+        auto two = ptr;
+
+        base copy(*ptr);
+        REQUIRE(copy.use_count() == 0u);
+        *two = copy;
+        REQUIRE(ptr.use_count() == 2u);
+    }
+}
@@ -0,0 +1,169 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/padded_object_pool.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct big_padding
+{
+    std::uint8_t  a;
+    std::uint64_t b;
+
+    big_padding(std::uint8_t a, std::uint64_t b) : a(a), b(b) {}
+};
+
+struct small_padding
+{
+    std::uint8_t  a;
+    std::uint32_t b;
+
+    small_padding(std::uint8_t a, std::uint32_t b) : a(a), b(b) {}
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct padding_traits<big_padding>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(big_padding, a),
+                               FOONATHAN_TINY_MEMBER(big_padding, b)>
+    {};
+
+    template <>
+    struct padding_traits<small_padding>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(small_padding, a),
+                               FOONATHAN_TINY_MEMBER(small_padding, b)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+namespace
+{
+template <class Pool>
+void verify(const Pool& pool, const std::vector<pool_handle>& handles,
+            const std::vector<std::uint8_t>& values)
+{
+    REQUIRE(pool.size() == handles.size());
+    for (auto i = 0u; i != handles.size(); ++i)
+    {
+        REQUIRE(pool.contains(handles[i]));
+        REQUIRE(pool[handles[i]].a == values[i]);
+        REQUIRE(pool[handles[i]].b == values[i] * 1000u);
+    }
+
+    std::size_t count = 0;
+    pool.for_each([&](pool_handle h, const typename Pool::value_type& obj) {
+        REQUIRE(pool.contains(h));
+        REQUIRE(obj.b == obj.a * 1000u);
+        ++count;
+    });
+    REQUIRE(count == handles.size());
+}
+
+template <class Pool>
+void test_pool()
+{
+    using value_type = typename Pool::value_type;
+
+    Pool pool;
+    REQUIRE(pool.empty());
+    REQUIRE(!pool.contains(pool_handle()));
+
+    std::vector<pool_handle>  handles;
+    std::vector<std::uint8_t> values;
+    for (auto i = 0u; i != 10u; ++i)
+    {
+        handles.push_back(pool.insert(value_type(std::uint8_t(i), i * 1000u)));
+        values.push_back(std::uint8_t(i));
+    }
+    REQUIRE(pool.slot_count() == 10u);
+    verify(pool, handles, values);
+
+    // erase every other object
+    std::vector<pool_handle> erased;
+    for (auto i = 0u; i != 5u; ++i)
+    {
+        pool.erase(handles[i + 1]);
+        erased.push_back(handles[i + 1]);
+        handles.erase(handles.begin() + i + 1);
+        values.erase(values.begin() + i + 1);
+    }
+    verify(pool, handles, values);
+    for (auto h : erased)
+        REQUIRE(!pool.contains(h));
+
+    // slots are reused, old handles stay invalid
+    for (auto i = 0u; i != 5u; ++i)
+    {
+        handles.push_back(pool.emplace(std::uint8_t(100u + i), (100u + i) * 1000u));
+        values.push_back(std::uint8_t(100u + i));
+    }
+    REQUIRE(pool.slot_count() == 10u);
+    verify(pool, handles, values);
+    for (auto h : erased)
+        REQUIRE(!pool.contains(h));
+
+    // changing the objects keeps the bookkeeping
+    pool.assign(handles[0], value_type(42, 42000u));
+    values[0] = 42;
+    pool.modify(handles[1], [](value_type& obj) {
+        obj.a = 11;
+        obj.b = 11000u;
+    });
+    values[1] = 11;
+    verify(pool, handles, values);
+
+    pool.clear();
+    REQUIRE(pool.empty());
+    REQUIRE(pool.slot_count() == 0u);
+    REQUIRE(!pool.contains(handles[0]));
+}
+} // namespace
+
+TEST_CASE("padded_object_pool")
+{
+    SECTION("compressed")
+    {
+        using pool = padded_object_pool<big_padding>;
+        static_assert(pool::is_compressed, "");
+        test_pool<pool>();
+
+        pool p;
+        p.insert(big_padding(1, 2));
+        REQUIRE(p.memory_usage() == sizeof(big_padding));
+    }
+    SECTION("not compressed")
+    {
+        using pool = padded_object_pool<small_padding>;
+        static_assert(!pool::is_compressed, "");
+        test_pool<pool>();
+    }
+    SECTION("generation overflow")
+    {
+        padded_object_pool<big_padding, 8, 2> pool;
+
+        auto first = pool.insert(big_padding(1, 1000u));
+        pool.erase(first);
+        for (auto i = 0u; i != 3u; ++i)
+        {
+            auto h = pool.insert(big_padding(1, 1000u));
+            REQUIRE(h.index() == first.index());
+            REQUIRE(pool.contains(h));
+            pool.erase(h);
+        }
+
+        // generation wraps around after 2^2 values, 2 of them alive
+        auto h = pool.insert(big_padding(1, 1000u));
+        REQUIRE(h == first);
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/padding_aware.hpp>
+
+#include <catch.hpp>
+
+#include <unordered_set>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+// padding in the middle of the object and in the last (partial) word
+struct small_key
+{
+    std::uint8_t  a;
+    std::uint16_t b;
+    std::uint8_t  c;
+};
+
+// padding in multiple words
+struct big_key
+{
+    std::uint8_t  a;
+    std::uint32_t b;
+    std::uint64_t c;
+    std::uint8_t  d;
+};
+
+template <typename T>
+T make_garbage(unsigned char garbage)
+{
+    T result;
+    std::memset(&result, garbage, sizeof(T));
+    return result;
+}
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct padding_traits<small_key>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(small_key, a),
+                               FOONATHAN_TINY_MEMBER(small_key, b),
+                               FOONATHAN_TINY_MEMBER(small_key, c)>
+    {};
+
+    template <>
+    struct padding_traits<big_key>
+    : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(big_key, a),
+                               FOONATHAN_TINY_MEMBER(big_key, b), FOONATHAN_TINY_MEMBER(big_key, c),
+                               FOONATHAN_TINY_MEMBER(big_key, d)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("padding_aware_hash and padding_aware_equal")
+{
+    padding_aware_hash<big_key>  hash;
+    padding_aware_equal<big_key> equal;
+
+    auto a = make_garbage<big_key>(0x00);
+    auto b = make_garbage<big_key>(0xFF);
+    a.a = b.a = 1;
+    a.b = b.b = 2;
+    a.c = b.c = 3;
+    a.d = b.d = 4;
+    REQUIRE(std::memcmp(&a, &b, sizeof(big_key)) != 0);
+
+    REQUIRE(equal(a, b));
+    REQUIRE(hash(a) == hash(b));
+
+    SECTION("different value")
+    {
+        b.d = 5;
+        REQUIRE(!equal(a, b));
+        REQUIRE(hash(a) != hash(b));
+
+        b.d = 4;
+        b.c = 1ull << 63;
+        REQUIRE(!equal(a, b));
+        REQUIRE(hash(a) != hash(b));
+    }
+    SECTION("partial word")
+    {
+        padding_aware_hash<small_key>  small_hash;
+        padding_aware_equal<small_key> small_equal;
+
+        auto c = make_garbage<small_key>(0x00);
+        auto d = make_garbage<small_key>(0xFF);
+        c.a = d.a = 1;
+        c.b = d.b = 2;
+        c.c = d.c = 3;
+        REQUIRE(small_equal(c, d));
+        REQUIRE(small_hash(c) == small_hash(d));
+
+        d.c = 4;
+        REQUIRE(!small_equal(c, d));
+        REQUIRE(small_hash(c) != small_hash(d));
+    }
+    SECTION("unordered_set")
+    {
+        std::unordered_set<big_key, padding_aware_hash<big_key>, padding_aware_equal<big_key>> set;
+        set.insert(a);
+        REQUIRE(set.count(b) == 1u);
+
+        b.a = 0;
+        REQUIRE(set.count(b) == 0u);
+    }
+}
+
+TEST_CASE("copy_value_bytes")
+{
+    auto src = make_garbage<big_key>(0x00);
+    src.a    = 1;
+    src.b    = 2;
+    src.c    = 3;
+    src.d    = 4;
+
+    auto dest = make_garbage<big_key>(0xAB);
+    padding_of(dest).subview<0, 64>().put(0x0123456789ABCDEFull);
+    copy_value_bytes(src, dest);
+
+    REQUIRE(dest.a == 1);
+    REQUIRE(dest.b == 2);
+    REQUIRE(dest.c == 3);
+    REQUIRE(dest.d == 4);
+    REQUIRE(padding_of(dest).subview<0, 64>().extract() == 0x0123456789ABCDEFull);
+    REQUIRE(padding_of(dest).subview<64, last_bit>().extract() == 0xABABu);
+}
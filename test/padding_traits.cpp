@@ -182,3 +182,90 @@ TEST_CASE("padding_traits layout compatible")
 {
     REQUIRE(padding_bit_size<compatible>() == 8);
 }
+
+static_assert(check_padding<aggregate_padding, 8>(), "");
+FOONATHAN_TINY_CHECK_PADDING(compatible, 8);
+
+#if FOONATHAN_TINY_HAS_AGGREGATE_REFLECTION
+namespace
+{
+struct reflected_complex
+{
+    std::uint8_t  a;
+    std::uint32_t b;
+    std::uint64_t c;
+    std::uint8_t  d;
+};
+
+struct reflected_nested
+{
+    const std::uint16_t a;
+    aggregate_padding   b;
+    std::uint8_t        c;
+    double              d;
+};
+
+// b is at offset 2 instead of 1, but the size is the same
+struct reflected_over_aligned
+{
+    char           a;
+    alignas(2) char b;
+    int            c;
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct padding_traits<reflected_complex> : padding_traits_reflect<reflected_complex>
+    {};
+
+    template <>
+    struct padding_traits<reflected_nested> : padding_traits_reflect<reflected_nested>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("padding_traits_reflect")
+{
+    SECTION("complex")
+    {
+        using manual
+            = padding_traits_aggregate<FOONATHAN_TINY_MEMBER(reflected_complex, a),
+                                       FOONATHAN_TINY_MEMBER(reflected_complex, b),
+                                       FOONATHAN_TINY_MEMBER(reflected_complex, c),
+                                       FOONATHAN_TINY_MEMBER(reflected_complex, d)>;
+        using manual_view = decltype(manual::padding_view(std::declval<unsigned char*>()));
+        REQUIRE(std::is_same<padding_view_t<reflected_complex>, manual_view>::value);
+        FOONATHAN_TINY_CHECK_PADDING(reflected_complex, (3 + 7) * CHAR_BIT);
+    }
+    SECTION("nested")
+    {
+        using manual = padding_traits_aggregate<FOONATHAN_TINY_MEMBER(reflected_nested, a),
+                                                FOONATHAN_TINY_MEMBER(reflected_nested, b),
+                                                FOONATHAN_TINY_MEMBER(reflected_nested, c),
+                                                FOONATHAN_TINY_MEMBER(reflected_nested, d)>;
+        using manual_view = decltype(manual::padding_view(std::declval<unsigned char*>()));
+        REQUIRE(std::is_same<padding_view_t<reflected_nested>, manual_view>::value);
+        // the padding inside of b is not included
+        FOONATHAN_TINY_CHECK_PADDING(reflected_nested, CHAR_BIT);
+
+        reflected_nested obj{1, {2, 3}, 4, 5.};
+        padding_of(obj).put(~0ull);
+        REQUIRE(obj.a == 1);
+        REQUIRE(obj.b.a == 2);
+        REQUIRE(obj.b.b == 3);
+        REQUIRE(obj.c == 4);
+        REQUIRE(obj.d == 5.);
+    }
+    SECTION("offsets")
+    {
+        REQUIRE(reflect_detail::has_reflected_offsets(reflected_complex{}));
+        REQUIRE(reflect_detail::has_reflected_offsets(reflected_nested{1, {2, 3}, 4, 5.}));
+        // can't be detected at compile-time
+        REQUIRE(!reflect_detail::has_reflected_offsets(reflected_over_aligned{}));
+    }
+}
+#endif
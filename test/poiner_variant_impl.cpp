@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <foonathan/tiny/optional_impl.hpp>
+
 using namespace foonathan::tiny;
 
 namespace
@@ -116,3 +118,59 @@ TEST_CASE("pointer_variant_impl")
         verify_variant_impl<std::int32_t, aligned_obj<char, 4>, aligned_obj<signed char, 8>>(true);
     }
 }
+
+namespace
+{
+    template <typename A, typename B, typename C>
+    void verify_variant_tombstones(std::size_t expected_count)
+    {
+        using variant = pointer_variant_impl<A, B, C>;
+        using traits  = tombstone_traits<variant>;
+
+        std::size_t count = traits::tombstone_count;
+        REQUIRE(count == expected_count);
+
+        typename traits::storage_type storage;
+        for (auto i = 0u; i != count; ++i)
+        {
+            traits::create_tombstone(storage, i);
+            REQUIRE(traits::get_tombstone(storage) == i);
+        }
+
+        traits::create_object(storage, nullptr);
+        REQUIRE(traits::get_tombstone(storage) >= count);
+        traits::get_object(storage).reset(get_pointer<C>::get());
+        REQUIRE(traits::get_tombstone(storage) >= count);
+        traits::destroy_object(storage);
+
+        static_assert(sizeof(optional_impl<variant>) == sizeof(variant), "");
+
+        optional_impl<variant> opt;
+        REQUIRE(!opt.has_value());
+        opt.create_value(get_pointer<C>::get());
+        REQUIRE(opt.has_value());
+        REQUIRE(opt.value().tag() == 2u);
+        opt.destroy_value();
+        REQUIRE(!opt.has_value());
+    }
+} // namespace
+
+TEST_CASE("pointer_variant_impl tombstone_traits")
+{
+    using nested = optional_impl<optional_impl<pointer_variant_impl<char, int, long>>>;
+    static_assert(sizeof(nested) == sizeof(pointer_variant_impl<char, int, long>), "");
+
+    SECTION("not compressed")
+    {
+        verify_variant_tombstones<std::int32_t, std::int64_t, const char>(256 - 3);
+    }
+    SECTION("compressed")
+    {
+        verify_variant_tombstones<std::int32_t, std::int64_t, const std::uint32_t>(1);
+    }
+    SECTION("compressed: spare bits")
+    {
+        verify_variant_tombstones<aligned_obj<std::int32_t, 16>, aligned_obj<std::int64_t, 16>,
+                                  aligned_obj<char, 16>>(16 - 3);
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/radix_sort.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+enum class priority
+{
+    low,
+    normal,
+    high,
+
+    unsigned_count_,
+};
+
+template <class Storage>
+std::vector<Storage> make_records(std::size_t size)
+{
+    std::vector<Storage> result;
+    for (auto i = 0u; i != size; ++i)
+    {
+        auto random = i * 2654435761u >> 5;
+        result.emplace_back(static_cast<std::uint16_t>(random % 1000u),
+                            static_cast<priority>(random % 3u), random % 7u == 0u,
+                            static_cast<std::uint16_t>(i));
+    }
+    return result;
+}
+
+template <class Storage>
+void test_radix_sort()
+{
+    auto records = make_records<Storage>(1000u);
+
+    SECTION("single")
+    {
+        auto expected = records;
+        std::stable_sort(expected.begin(), expected.end(), [](const Storage& a, const Storage& b) {
+            return a.template at<0>() < b.template at<0>();
+        });
+
+        radix_sort<0>(records.begin(), records.end());
+        for (auto i = 0u; i != records.size(); ++i)
+            REQUIRE(records[i].template at<3>() == expected[i].template at<3>());
+    }
+    SECTION("multiple")
+    {
+        auto key = [](const Storage& s) {
+            return std::make_tuple(priority(s.template at<1>()), bool(s.template at<2>()),
+                                   std::uint16_t(s.template at<0>()));
+        };
+        auto expected = records;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [&](const Storage& a, const Storage& b) { return key(a) < key(b); });
+
+        radix_sort<1, 2, 0>(records.begin(), records.end());
+        for (auto i = 0u; i != records.size(); ++i)
+            REQUIRE(records[i].template at<3>() == expected[i].template at<3>());
+    }
+    SECTION("empty")
+    {
+        records.clear();
+        radix_sort<0>(records.begin(), records.end());
+        REQUIRE(records.empty());
+    }
+}
+} // namespace
+
+TEST_CASE("radix_sort")
+{
+    SECTION("tiny_storage")
+    {
+        test_radix_sort<tiny_storage<tiny_unsigned<10, std::uint16_t>, tiny_enum<priority>,
+                                     tiny_bool, tiny_unsigned<16, std::uint16_t>>>();
+    }
+    SECTION("word_tiny_storage")
+    {
+        test_radix_sort<word_tiny_storage<tiny_unsigned<10, std::uint16_t>, tiny_enum<priority>,
+                                          tiny_bool, tiny_unsigned<16, std::uint16_t>>>();
+    }
+    SECTION("custom key")
+    {
+        std::vector<std::uint32_t> values;
+        for (auto i = 0u; i != 1000u; ++i)
+            values.push_back(i * 2654435761u);
+
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        radix_sort<32>(values.begin(), values.end(), [](std::uint32_t i) { return i; });
+        REQUIRE(values == expected);
+    }
+}
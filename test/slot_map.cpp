@@ -0,0 +1,132 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/slot_map.hpp>
+
+#include <catch.hpp>
+
+#include <map>
+#include <string>
+
+using namespace foonathan::tiny;
+
+TEST_CASE("slot_map")
+{
+    using map = slot_map<std::string, 8, 3>;
+    static_assert(sizeof(map::handle) == sizeof(std::uint16_t), "handle isn't a single word");
+    static_assert(sizeof(slot_map<int>::handle) == sizeof(std::uint64_t),
+                  "handle isn't a single word");
+
+    map m;
+    REQUIRE(m.empty());
+    REQUIRE(!map::handle());
+    REQUIRE(!m.contains(map::handle()));
+    REQUIRE(m.find(map::handle()) == nullptr);
+
+    // the expected contents
+    std::map<std::uint32_t, std::pair<map::handle, std::string>> expected;
+    auto verify = [&] {
+        REQUIRE(m.size() == expected.size());
+        for (auto& entry : expected)
+        {
+            auto h = entry.second.first;
+            REQUIRE(h);
+            REQUIRE(h.index() == entry.first);
+            REQUIRE(m.contains(h));
+            REQUIRE(m[h] == entry.second.second);
+            REQUIRE(m.find(h) == &m[h]);
+        }
+
+        std::size_t i = 0;
+        for (auto& value : m)
+        {
+            auto h = m.handle_at(i++);
+            REQUIRE(m.contains(h));
+            REQUIRE(&m[h] == &value);
+        }
+        REQUIRE(i == m.size());
+    };
+
+    for (auto i = 0u; i != 10u; ++i)
+    {
+        auto h = m.insert(std::to_string(i));
+        REQUIRE(h.index() == i);
+        REQUIRE(h.generation() == 0u);
+        expected[i] = std::make_pair(h, std::to_string(i));
+    }
+    verify();
+
+    SECTION("erase and reuse")
+    {
+        std::vector<map::handle> erased;
+        for (auto i : {0u, 9u, 4u, 5u})
+        {
+            erased.push_back(expected[i].first);
+            m.erase(expected[i].first);
+            expected.erase(i);
+            verify();
+        }
+        for (auto h : erased)
+        {
+            REQUIRE(!m.contains(h));
+            REQUIRE(m.find(h) == nullptr);
+        }
+
+        // the slots are reused with the next generation
+        for (auto i = 0u; i != 4u; ++i)
+        {
+            auto h = m.emplace(3u, 'a' + char(i));
+            REQUIRE(h.generation() == 1u);
+            expected[h.index()] = std::make_pair(h, std::string(3u, 'a' + char(i)));
+        }
+        REQUIRE(m.size() == 10u);
+        verify();
+        for (auto h : erased)
+            REQUIRE(!m.contains(h));
+    }
+    SECTION("modify")
+    {
+        m[expected[3].first] = "hello";
+        expected[3].second   = "hello";
+        verify();
+    }
+    SECTION("generation overflow")
+    {
+        auto h = expected[2].first;
+        m.erase(h);
+        for (auto i = 1u; i != 8u; ++i)
+        {
+            auto new_h = m.insert("new");
+            REQUIRE(new_h.index() == h.index());
+            REQUIRE(new_h.generation() == i);
+            m.erase(new_h);
+        }
+
+        // the generation has 3 bits, so it wraps around
+        auto new_h = m.insert("new");
+        REQUIRE(new_h == h);
+    }
+    SECTION("throwing constructor")
+    {
+        // std::string throws std::length_error, the map is unchanged
+        REQUIRE_THROWS(m.emplace(std::string::npos, 'a'));
+        verify();
+
+        m.erase(expected[3].first);
+        expected.erase(3u);
+        REQUIRE_THROWS(m.emplace(std::string::npos, 'a'));
+        verify();
+
+        auto h = m.insert("new");
+        REQUIRE(h.index() == 3u);
+        expected[3u] = std::make_pair(h, "new");
+        verify();
+    }
+    SECTION("clear")
+    {
+        m.clear();
+        REQUIRE(m.empty());
+        REQUIRE(!m.contains(expected[0].first));
+    }
+}
@@ -0,0 +1,348 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/small_vector.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+#include <foonathan/tiny/optional_impl.hpp>
+#include <foonathan/tiny/padding_tiny_storage.hpp>
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/pointer_variant_impl.hpp>
+#include <foonathan/tiny/tagged_union_impl.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+// not trivially copyable, but trivially relocatable
+struct counted
+{
+    static int live;
+
+    int* value;
+
+    explicit counted(int i) : value(new int(i))
+    {
+        ++live;
+    }
+    counted(const counted& other) : value(new int(*other.value))
+    {
+        ++live;
+    }
+    counted& operator=(const counted& other)
+    {
+        *value = *other.value;
+        return *this;
+    }
+    ~counted() noexcept
+    {
+        delete value;
+        --live;
+    }
+};
+
+int counted::live = 0;
+
+struct trivial_member
+{
+    int i;
+};
+
+struct string_member
+{
+    std::string str;
+};
+
+// copied when relocated, as it has no nothrow move constructor
+struct throwing_copy
+{
+    static int live;
+    static int copies_until_throw;
+
+    int value;
+
+    explicit throwing_copy(int i) : value(i)
+    {
+        ++live;
+    }
+    throwing_copy(const throwing_copy& other) : value(other.value)
+    {
+        if (copies_until_throw-- == 0)
+            throw 0;
+        ++live;
+    }
+    ~throwing_copy() noexcept
+    {
+        --live;
+    }
+};
+
+int throwing_copy::live               = 0;
+int throwing_copy::copies_until_throw = -1;
+
+struct padded
+{
+    std::uint32_t a;
+    std::uint8_t  b;
+
+    padded() noexcept : a(0), b(0) {}
+    padded(const padded& other) noexcept : a(other.a), b(other.b) {}
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct is_trivially_relocatable<counted> : std::true_type
+    {};
+
+    template <>
+    struct is_trivially_relocatable<padded> : std::true_type
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("is_trivially_relocatable")
+{
+    static_assert(is_trivially_relocatable<int>::value, "");
+    static_assert(!is_trivially_relocatable<std::string>::value, "");
+
+    static_assert(is_trivially_relocatable<optional_impl<int*>>::value, "");
+    static_assert(is_trivially_relocatable<optional_impl<int>>::value, "");
+    static_assert(is_trivially_relocatable<optional_impl<counted>>::value, "");
+    static_assert(!is_trivially_relocatable<optional_impl<std::string>>::value, "");
+
+    static_assert(
+        is_trivially_relocatable<tagged_union_impl<union_types<trivial_member, counted>>>::value,
+        "");
+    static_assert(!is_trivially_relocatable<
+                      tagged_union_impl<union_types<trivial_member, string_member>>>::value,
+                  "");
+
+    static_assert(is_trivially_relocatable<pointer_variant_impl<int, std::string>>::value, "");
+
+    static_assert(is_trivially_relocatable<tiny_storage<tiny_bool, tiny_unsigned<3>>>::value, "");
+    static_assert(is_trivially_relocatable<word_tiny_storage<tiny_bool, tiny_unsigned<3>>>::value,
+                  "");
+    static_assert(is_trivially_relocatable<pointer_tiny_storage<int, tiny_bool>>::value, "");
+    static_assert(is_trivially_relocatable<padding_tiny_storage<padded, tiny_bool>>::value, "");
+    static_assert(!is_trivially_relocatable<padding_tiny_storage<string_member, tiny_bool>>::value,
+                  "");
+}
+
+TEST_CASE("relocate")
+{
+    SECTION("trivially relocatable")
+    {
+        alignas(counted) unsigned char src_memory[3 * sizeof(counted)];
+        alignas(counted) unsigned char dest_memory[3 * sizeof(counted)];
+        auto                           src  = reinterpret_cast<counted*>(src_memory);
+        auto                           dest = reinterpret_cast<counted*>(dest_memory);
+
+        for (auto i = 0; i != 3; ++i)
+            ::new (static_cast<void*>(src + i)) counted(i);
+        REQUIRE(counted::live == 3);
+
+        // no copy and destroy
+        relocate(src, 3u, dest);
+        REQUIRE(counted::live == 3);
+        for (auto i = 0; i != 3; ++i)
+        {
+            REQUIRE(*dest[i].value == i);
+            dest[i].~counted();
+        }
+        REQUIRE(counted::live == 0);
+    }
+    SECTION("not trivially relocatable")
+    {
+        alignas(std::string) unsigned char src_memory[2 * sizeof(std::string)];
+        alignas(std::string) unsigned char dest_memory[2 * sizeof(std::string)];
+        auto                               src  = reinterpret_cast<std::string*>(src_memory);
+        auto                               dest = reinterpret_cast<std::string*>(dest_memory);
+
+        ::new (static_cast<void*>(src)) std::string("short");
+        ::new (static_cast<void*>(src + 1)) std::string("a string that does not use SSO");
+
+        relocate(src, 2u, dest);
+        REQUIRE(dest[0] == "short");
+        REQUIRE(dest[1] == "a string that does not use SSO");
+
+        using std::string;
+        dest[0].~string();
+        dest[1].~string();
+    }
+    SECTION("throwing copy")
+    {
+        alignas(throwing_copy) unsigned char src_memory[3 * sizeof(throwing_copy)];
+        alignas(throwing_copy) unsigned char dest_memory[3 * sizeof(throwing_copy)];
+        auto                                 src  = reinterpret_cast<throwing_copy*>(src_memory);
+        auto                                 dest = reinterpret_cast<throwing_copy*>(dest_memory);
+
+        for (auto i = 0; i != 3; ++i)
+            ::new (static_cast<void*>(src + i)) throwing_copy(i);
+
+        // the two copies are destroyed, the originals are unchanged
+        throwing_copy::copies_until_throw = 2;
+        REQUIRE_THROWS(relocate(src, 3u, dest));
+        REQUIRE(throwing_copy::live == 3);
+
+        throwing_copy::copies_until_throw = -1;
+        relocate(src, 3u, dest);
+        REQUIRE(throwing_copy::live == 3);
+        for (auto i = 0; i != 3; ++i)
+        {
+            REQUIRE(dest[i].value == i);
+            dest[i].~throwing_copy();
+        }
+        REQUIRE(throwing_copy::live == 0);
+    }
+}
+
+TEST_CASE("small_vector")
+{
+    SECTION("int")
+    {
+        small_vector<int, 4> vec;
+        REQUIRE(vec.empty());
+        REQUIRE(vec.is_inline());
+        REQUIRE(vec.capacity() == 4u);
+
+        for (auto i = 0; i != 4; ++i)
+            vec.push_back(i);
+        REQUIRE(vec.is_inline());
+
+        // refers to an object that is relocated
+        vec.push_back(vec[1]);
+        REQUIRE(!vec.is_inline());
+        REQUIRE(vec.size() == 5u);
+        REQUIRE(vec.capacity() == 8u);
+        REQUIRE(vec.back() == 1);
+
+        auto iter = vec.erase(vec.begin() + 1, vec.begin() + 3);
+        REQUIRE(iter == vec.begin() + 1);
+        REQUIRE(vec.size() == 3u);
+        REQUIRE(vec[0] == 0);
+        REQUIRE(vec[1] == 3);
+        REQUIRE(vec[2] == 1);
+
+        small_vector<int, 4> copy(vec);
+        REQUIRE(copy.size() == 3u);
+        REQUIRE(copy[1] == 3);
+
+        small_vector<int, 4> moved(std::move(vec));
+        REQUIRE(vec.empty());
+        REQUIRE(vec.is_inline());
+        REQUIRE(moved.size() == 3u);
+        REQUIRE(moved.front() == 0);
+
+        moved.resize(1u);
+        REQUIRE(moved.size() == 1u);
+        moved.resize(3u);
+        REQUIRE(moved[2] == 0);
+    }
+    SECTION("trivially relocatable")
+    {
+        {
+            small_vector<counted, 2> vec;
+            for (auto i = 0; i != 10; ++i)
+                vec.emplace_back(i);
+            REQUIRE(counted::live == 10);
+
+            vec.erase(vec.begin() + 3);
+            REQUIRE(counted::live == 9);
+            for (auto i = 0u; i != vec.size(); ++i)
+                REQUIRE(*vec[i].value == int(i < 3u ? i : i + 1u));
+
+            small_vector<counted, 2> inline_vec;
+            inline_vec.emplace_back(42);
+
+            vec = std::move(inline_vec);
+            REQUIRE(counted::live == 1);
+            REQUIRE(vec.size() == 1u);
+            REQUIRE(*vec[0].value == 42);
+        }
+        REQUIRE(counted::live == 0);
+    }
+    SECTION("not trivially relocatable")
+    {
+        small_vector<std::string, 2> vec;
+        for (auto i = 0; i != 10; ++i)
+            vec.push_back(std::string(20u, char('a' + i)));
+
+        vec.erase(vec.begin(), vec.begin() + 2);
+        REQUIRE(vec.size() == 8u);
+        for (auto i = 0u; i != vec.size(); ++i)
+            REQUIRE(vec[i] == std::string(20u, char('c' + i)));
+
+        small_vector<std::string, 2> copy(vec);
+        REQUIRE(copy.size() == 8u);
+        REQUIRE(copy.back() == vec.back());
+
+        vec.clear();
+        REQUIRE(vec.empty());
+        vec = copy;
+        REQUIRE(vec.size() == 8u);
+    }
+    SECTION("throwing copy")
+    {
+        {
+            small_vector<throwing_copy, 2> vec;
+            vec.emplace_back(0);
+            vec.emplace_back(1);
+
+            // growing copies the existing objects, the vector is unchanged if that throws
+            throwing_copy::copies_until_throw = 1;
+            REQUIRE_THROWS(vec.emplace_back(2));
+            REQUIRE(vec.size() == 2u);
+            REQUIRE(vec.is_inline());
+            REQUIRE(throwing_copy::live == 2);
+
+            throwing_copy::copies_until_throw = 0;
+            REQUIRE_THROWS(vec.reserve(8u));
+            REQUIRE(vec.capacity() == 2u);
+            REQUIRE(throwing_copy::live == 2);
+
+            throwing_copy::copies_until_throw = -1;
+            vec.emplace_back(2);
+            REQUIRE(!vec.is_inline());
+            for (auto i = 0; i != 3; ++i)
+                REQUIRE(vec[std::size_t(i)].value == i);
+        }
+        REQUIRE(throwing_copy::live == 0);
+    }
+    SECTION("optional_impl")
+    {
+        // optional_impl is neither copyable nor movable
+        small_vector<optional_impl<int*>> vec;
+        int                               obj = 0;
+        for (auto i = 0; i != 9; ++i)
+        {
+            auto& opt = vec.emplace_back();
+            if (i % 3 == 0)
+                opt.create_value(&obj);
+        }
+        REQUIRE(vec.size() == 9u);
+        for (auto i = 0u; i != vec.size(); ++i)
+        {
+            REQUIRE(vec[i].has_value() == (i % 3u == 0u));
+            if (vec[i].has_value())
+                REQUIRE(vec[i].value() == &obj);
+        }
+
+        vec.erase(vec.begin());
+        REQUIRE(vec.size() == 8u);
+        REQUIRE(vec[2].has_value());
+        REQUIRE(vec[5].has_value());
+
+        small_vector<optional_impl<int*>> moved(std::move(vec));
+        REQUIRE(moved.size() == 8u);
+        REQUIRE(moved[2].value() == &obj);
+    }
+}
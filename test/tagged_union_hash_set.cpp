@@ -0,0 +1,312 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/tagged_union_hash_set.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <functional>
+#include <set>
+#include <string>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+using types = union_types<struct id_entry, struct name_entry>;
+
+struct id_entry
+{
+    tagged_union_tag<types> tag;
+    int                     id;
+
+    explicit id_entry(int id) : id(id) {}
+
+    friend bool operator==(const id_entry& lhs, const id_entry& rhs)
+    {
+        return lhs.id == rhs.id;
+    }
+};
+
+// tagged_union_impl requires trivially destructible types
+struct name_entry
+{
+    tagged_union_tag<types> tag;
+    char                    name[8];
+
+    explicit name_entry(const std::string& str)
+    {
+        REQUIRE(str.size() < sizeof(name));
+        std::strcpy(name, str.c_str());
+    }
+
+    friend bool operator==(const name_entry& lhs, const name_entry& rhs)
+    {
+        return std::strcmp(lhs.name, rhs.name) == 0;
+    }
+};
+
+struct entry_hash
+{
+    std::size_t operator()(const id_entry& entry) const
+    {
+        return std::hash<int>{}(entry.id) * 0x9E3779B97F4A7C15ull;
+    }
+    std::size_t operator()(const name_entry& entry) const
+    {
+        return std::hash<std::string>{}(std::string(entry.name));
+    }
+};
+
+// every object has the same hash value
+struct bad_hash
+{
+    template <typename T>
+    std::size_t operator()(const T&) const
+    {
+        return 42u;
+    }
+};
+
+// throws once the given number of hashes or copies has been computed
+int calls_left = -1;
+
+void count_call()
+{
+    if (calls_left == 0)
+        throw 0;
+    else if (calls_left > 0)
+        --calls_left;
+}
+
+struct throwing_hash : entry_hash
+{
+    template <typename T>
+    std::size_t operator()(const T& entry) const
+    {
+        count_call();
+        return entry_hash::operator()(entry);
+    }
+};
+
+using copy_types = union_types<struct copy_entry>;
+
+// doesn't have a move constructor, so it is copied when the set grows
+struct copy_entry
+{
+    tagged_union_tag<copy_types> tag;
+    int                          id;
+
+    explicit copy_entry(int id) : id(id) {}
+
+    copy_entry(const copy_entry& other) : id(other.id)
+    {
+        count_call();
+    }
+
+    friend bool operator==(const copy_entry& lhs, const copy_entry& rhs)
+    {
+        return lhs.id == rhs.id;
+    }
+};
+
+struct copy_hash
+{
+    std::size_t operator()(const copy_entry& entry) const
+    {
+        return std::hash<int>{}(entry.id);
+    }
+};
+
+template <class Set>
+void verify(const Set& set, const std::set<int>& ids, const std::set<std::string>& names)
+{
+    REQUIRE(set.size() == ids.size() + names.size());
+    for (auto id : ids)
+    {
+        auto ptr = set.find(id_entry(id));
+        REQUIRE(ptr);
+        REQUIRE(ptr->id == id);
+    }
+    for (auto& name : names)
+    {
+        auto ptr = set.find(name_entry(name));
+        REQUIRE(ptr);
+        REQUIRE(ptr->name == name);
+    }
+
+    struct counter
+    {
+        std::size_t* ids;
+        std::size_t* names;
+
+        void operator()(const id_entry&) const
+        {
+            ++*ids;
+        }
+        void operator()(const name_entry&) const
+        {
+            ++*names;
+        }
+    };
+    std::size_t id_count = 0, name_count = 0;
+    set.for_each(counter{&id_count, &name_count});
+    REQUIRE(id_count == ids.size());
+    REQUIRE(name_count == names.size());
+}
+
+template <class Hash>
+void test_set()
+{
+    tagged_union_hash_set<types, Hash> set;
+    REQUIRE(set.empty());
+    REQUIRE(set.capacity() == 0u);
+    REQUIRE(!set.contains(id_entry(0)));
+
+    std::set<int>         ids;
+    std::set<std::string> names;
+    for (auto i = 0; i != 200; ++i)
+    {
+        auto id = set.insert(id_entry(i));
+        REQUIRE(id.second);
+        REQUIRE(id.first->id == i);
+        ids.insert(i);
+
+        auto name = set.insert(name_entry(std::to_string(i)));
+        REQUIRE(name.second);
+        names.insert(std::to_string(i));
+    }
+    verify(set, ids, names);
+    REQUIRE(set.capacity() * 7u >= set.size() * 8u);
+
+    // the id and the name are different objects, even with the same hash
+    REQUIRE(!set.contains(id_entry(-1)));
+    REQUIRE(!set.contains(name_entry("-1")));
+
+    SECTION("duplicates")
+    {
+        auto id = set.insert(id_entry(42));
+        REQUIRE(!id.second);
+        REQUIRE(id.first == set.find(id_entry(42)));
+
+        auto name = set.insert(name_entry("42"));
+        REQUIRE(!name.second);
+        REQUIRE(std::string(name.first->name) == "42");
+        verify(set, ids, names);
+    }
+    SECTION("erase")
+    {
+        for (auto i = 0; i < 200; i += 2)
+        {
+            REQUIRE(set.erase(id_entry(i)));
+            ids.erase(i);
+            REQUIRE(set.erase(name_entry(std::to_string(i + 1))));
+            names.erase(std::to_string(i + 1));
+        }
+        REQUIRE(!set.erase(id_entry(0)));
+        verify(set, ids, names);
+
+        // reuses erased slots
+        auto capacity = set.capacity();
+        for (auto i = 0; i < 100; i += 2)
+        {
+            REQUIRE(set.insert(id_entry(i)).second);
+            ids.insert(i);
+        }
+        REQUIRE(set.capacity() == capacity);
+        verify(set, ids, names);
+
+        // erase and insert often, so erased slots need to be removed
+        for (auto i = 0; i != 2000; ++i)
+        {
+            REQUIRE(set.insert(id_entry(1000 + i)).second);
+            REQUIRE(set.erase(id_entry(1000 + i)));
+        }
+        REQUIRE(set.capacity() == capacity);
+        verify(set, ids, names);
+    }
+    SECTION("clear")
+    {
+        auto capacity = set.capacity();
+        set.clear();
+        REQUIRE(set.empty());
+        REQUIRE(set.capacity() == capacity);
+        verify(set, {}, {});
+
+        set.insert(name_entry("hello"));
+        verify(set, {}, {"hello"});
+    }
+}
+} // namespace
+
+TEST_CASE("tagged_union_hash_set")
+{
+    static_assert(tagged_union_tag<types>::spare_bits == 7u, "");
+
+    SECTION("good hash")
+    {
+        test_set<entry_hash>();
+    }
+    SECTION("bad hash")
+    {
+        test_set<bad_hash>();
+    }
+    SECTION("reserve")
+    {
+        tagged_union_hash_set<types, entry_hash> set;
+        set.reserve(100u);
+        auto capacity = set.capacity();
+        REQUIRE(capacity * 7u >= 100u * 8u);
+
+        for (auto i = 0; i != 100; ++i)
+            set.insert(id_entry(i));
+        REQUIRE(set.capacity() == capacity);
+    }
+    SECTION("throwing hash")
+    {
+        tagged_union_hash_set<types, throwing_hash> set;
+        std::set<int>                               ids;
+        for (auto i = 0; i != 7; ++i)
+        {
+            set.insert(id_entry(i));
+            ids.insert(i);
+        }
+        REQUIRE(set.capacity() == 8u);
+
+        // the insert needs to grow, which throws while hashing the third object
+        calls_left = 3;
+        REQUIRE_THROWS_AS(set.insert(id_entry(7)), int);
+        calls_left = -1;
+        REQUIRE(set.capacity() == 8u);
+        verify(set, ids, {});
+
+        set.insert(id_entry(7));
+        ids.insert(7);
+        REQUIRE(set.capacity() == 16u);
+        verify(set, ids, {});
+    }
+    SECTION("throwing copy")
+    {
+        tagged_union_hash_set<copy_types, copy_hash> set;
+        for (auto i = 0; i != 7; ++i)
+            set.insert(copy_entry(i));
+        REQUIRE(set.capacity() == 8u);
+
+        // the insert needs to grow, which throws while copying the third object
+        calls_left = 2;
+        REQUIRE_THROWS_AS(set.insert(copy_entry(7)), int);
+        calls_left = -1;
+        REQUIRE(set.size() == 7u);
+        REQUIRE(set.capacity() == 8u);
+        for (auto i = 0; i != 7; ++i)
+            REQUIRE(set.contains(copy_entry(i)));
+
+        set.insert(copy_entry(7));
+        REQUIRE(set.size() == 8u);
+        REQUIRE(set.capacity() == 16u);
+        for (auto i = 0; i != 8; ++i)
+            REQUIRE(set.contains(copy_entry(i)));
+    }
+}
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <foonathan/tiny/optional_impl.hpp>
+
 using namespace foonathan::tiny;
 
 namespace
@@ -89,3 +91,68 @@ TEST_CASE("tagged_union_impl")
     verify_union<C>(cu, 2);
     u.destroy_value<C>();
 }
+
+TEST_CASE("tagged_union_impl tombstone_traits")
+{
+    using union_t = tagged_union_impl<types>;
+    using traits  = tombstone_traits<union_t>;
+
+    // one unused tag value combined with the six spare bits
+    std::size_t count = traits::tombstone_count;
+    REQUIRE(count == 64u);
+
+    union_t u;
+    for (auto i = 0u; i != count; ++i)
+    {
+        traits::create_tombstone(u, i);
+        REQUIRE(traits::get_tombstone(u) == i);
+    }
+
+    traits::create_object(u);
+    REQUIRE(traits::get_tombstone(u) >= count);
+
+    u.create_value<B>();
+    REQUIRE(traits::get_tombstone(u) >= count);
+    verify_union<B>(u, 1);
+    u.destroy_value<B>();
+
+    u.create_value<C>();
+    REQUIRE(traits::get_tombstone(u) >= count);
+    verify_union<C>(u, 2);
+    u.destroy_value<C>();
+
+    // no unused tag values
+    using types4 = union_types<A, B, C, int>;
+    static_assert(tombstone_traits<tagged_union_impl<types4>>::tombstone_count == 0u, "");
+}
+
+TEST_CASE("tagged_union_impl nested optional")
+{
+    using union_t = tagged_union_impl<types>;
+    static_assert(sizeof(optional_impl<union_t>) == sizeof(union_t), "");
+    static_assert(sizeof(optional_impl<optional_impl<union_t>>) == sizeof(union_t), "");
+
+    optional_impl<optional_impl<union_t>> opt;
+    REQUIRE(!opt.has_value());
+
+    opt.create_value();
+    REQUIRE(opt.has_value());
+    REQUIRE(!opt.value().has_value());
+
+    opt.value().create_value();
+    REQUIRE(opt.has_value());
+    REQUIRE(opt.value().has_value());
+
+    opt.value().value().create_value<B>();
+    REQUIRE(opt.has_value());
+    REQUIRE(opt.value().has_value());
+    verify_union<B>(opt.value().value(), 1);
+    opt.value().value().destroy_value<B>();
+
+    opt.value().destroy_value();
+    REQUIRE(opt.has_value());
+    REQUIRE(!opt.value().has_value());
+
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+}
@@ -11,6 +11,44 @@
 
 using namespace foonathan::tiny;
 
+#if FOONATHAN_TINY_HAS_CONSTEXPR14
+namespace
+{
+using table_entry = tiny_storage<tiny_unsigned<5>, tiny_int<4>, tiny_bool>;
+using wide_entry
+    = word_tiny_storage<tiny_unsigned<60, std::uint64_t>, tiny_int<10>, tiny_bool>;
+
+struct table
+{
+    table_entry entries[16];
+    wide_entry  wide_entries[16];
+};
+
+constexpr table make_table()
+{
+    table result{};
+    for (auto i = 0u; i != 16u; ++i)
+    {
+        result.entries[i] = table_entry(2u * i, int(i) - 8, i % 3u == 0u);
+
+        result.wide_entries[i].at<0>() = (std::uint64_t(1) << 59) + i;
+        result.wide_entries[i].at<1>() = -30 * int(i);
+        result.wide_entries[i].at<2>() = i % 2u == 0u;
+    }
+    return result;
+}
+
+constexpr auto lookup_table = make_table();
+static_assert(lookup_table.entries[3].at<0>() == 6u, "");
+static_assert(lookup_table.entries[3].at<1>() == -5, "");
+static_assert(lookup_table.entries[3].at<2>(), "");
+static_assert(lookup_table.entries[15][tiny_unsigned<5>{}] == 30u, "");
+static_assert(lookup_table.wide_entries[5].at<0>() == (std::uint64_t(1) << 59) + 5u, "");
+static_assert(lookup_table.wide_entries[5].at<1>() == -150, "");
+static_assert(!lookup_table.wide_entries[5].at<2>(), "");
+} // namespace
+#endif
+
 TEST_CASE("tiny_storage")
 {
     SECTION("basic")
@@ -46,11 +84,87 @@ TEST_CASE("tiny_storage")
         REQUIRE(s.at<0>() == 7);
         REQUIRE(s.at<1>() == false);
         REQUIRE(s.at<2>() == true);
+
+        REQUIRE(s.bits_of<0>().size() == 7u);
+        REQUIRE(s.bits_of<0>().extract() == 7u);
+        REQUIRE(cs.bits_of<2>().extract() == 1u);
+        s.bits_of<1>().put(1u);
+        REQUIRE(s.at<1>() == true);
     }
     SECTION("empty")
     {
         using storage = tiny_storage<>;
 
+        storage s;
+        REQUIRE(s.spare_bits().size() == CHAR_BIT);
+    }
+#if FOONATHAN_TINY_HAS_CONSTEXPR14
+    SECTION("constexpr")
+    {
+        for (auto i = 0u; i != 16u; ++i)
+        {
+            REQUIRE(lookup_table.entries[i].at<0>() == 2u * i);
+            REQUIRE(lookup_table.entries[i].at<1>() == int(i) - 8);
+            REQUIRE(lookup_table.entries[i].at<2>() == (i % 3u == 0u));
+
+            REQUIRE(lookup_table.wide_entries[i].at<0>() == (std::uint64_t(1) << 59) + i);
+            REQUIRE(lookup_table.wide_entries[i].at<1>() == -30 * int(i));
+            REQUIRE(lookup_table.wide_entries[i].at<2>() == (i % 2u == 0u));
+        }
+    }
+#endif
+}
+
+TEST_CASE("word_tiny_storage")
+{
+    SECTION("single word")
+    {
+        using storage = word_tiny_storage<tiny_unsigned<5>, tiny_unsigned<20>, tiny_bool>;
+        static_assert(sizeof(storage) == sizeof(std::uint32_t), "");
+
+        storage     s;
+        const auto& cs = s;
+
+        REQUIRE(s.at<0>() == 0u);
+        REQUIRE(s.at<1>() == 0u);
+        REQUIRE(s.at<2>() == false);
+
+        s.at<0>() = 31;
+        s.at<1>() = (1u << 20) - 1;
+        s.at<2>() = true;
+        REQUIRE(cs.at<0>() == 31u);
+        REQUIRE(cs.at<1>() == (1u << 20) - 1);
+        REQUIRE(cs.at<2>() == true);
+
+        s.at<1>() = 12345;
+        REQUIRE(cs.at<0>() == 31u);
+        REQUIRE(cs.at<1>() == 12345u);
+        REQUIRE(cs.at<2>() == true);
+
+        s = storage(7, 42, false);
+        REQUIRE(s.at<0>() == 7u);
+        REQUIRE(s.at<1>() == 42u);
+        REQUIRE(s.at<2>() == false);
+        REQUIRE(s.spare_bits().size() == 32u - 26u);
+    }
+    SECTION("multiple words")
+    {
+        using storage
+            = word_tiny_storage<tiny_unsigned<60, std::uint64_t>, tiny_unsigned<10>, tiny_bool>;
+        static_assert(sizeof(storage) == 2 * sizeof(std::uint64_t), "");
+
+        storage s;
+        s.at<0>() = (std::uint64_t(1) << 59) + 1;
+        s.at<1>() = 1000;
+        s.at<2>() = true;
+        REQUIRE(s.at<0>() == (std::uint64_t(1) << 59) + 1);
+        REQUIRE(s.at<1>() == 1000u);
+        REQUIRE(s.at<2>() == true);
+    }
+    SECTION("empty")
+    {
+        using storage = word_tiny_storage<>;
+
         storage s;
         REQUIRE(s.spare_bits().size() == CHAR_BIT);
     }
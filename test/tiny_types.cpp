@@ -461,3 +461,122 @@ TEST_CASE("tiny_flag_set")
         }
     }
 }
+
+TEST_CASE("flag_combo")
+{
+    auto none = flags<test_flags>();
+    auto ab   = flags(test_flags::a, test_flags::b);
+    auto bc   = flags(test_flags::b, test_flags::c);
+    auto all  = flags(test_flags::a, test_flags::b, test_flags::c);
+
+    REQUIRE(none.none());
+    REQUIRE(ab.any());
+    REQUIRE(!ab.all());
+    REQUIRE(all.all());
+
+    REQUIRE(ab.is_set(test_flags::a));
+    REQUIRE(!ab.is_set(test_flags::c));
+
+    REQUIRE((ab | bc) == all);
+    REQUIRE((ab & bc) == flags(test_flags::b));
+    REQUIRE((ab - bc) == flags(test_flags::a));
+    REQUIRE((ab ^ bc) == flags(test_flags::a, test_flags::c));
+
+    REQUIRE(none.is_subset_of(ab));
+    REQUIRE(ab.is_subset_of(all));
+    REQUIRE(!ab.is_subset_of(bc));
+    REQUIRE(all.is_superset_of(bc));
+    REQUIRE(ab.intersects(bc));
+    REQUIRE(!flags(test_flags::a).intersects(flags(test_flags::c)));
+
+    tiny_storage storage = 0;
+    auto         proxy   = make_proxy<tiny_flag_set<test_flags>>(storage);
+    proxy                = ab;
+    REQUIRE(proxy.combo() == ab);
+
+    proxy |= bc;
+    REQUIRE(proxy == all);
+    proxy -= flags(test_flags::b);
+    REQUIRE(proxy == flags(test_flags::a, test_flags::c));
+    proxy &= ab;
+    REQUIRE(proxy == flags(test_flags::a));
+    proxy ^= all;
+    REQUIRE(proxy == bc);
+}
+
+#if FOONATHAN_TINY_HAS_CONSTEXPR14
+TEST_CASE("flag_combo constexpr")
+{
+    constexpr auto ab  = flags(test_flags::a, test_flags::b);
+    constexpr auto bc  = flags(test_flags::b, test_flags::c);
+    constexpr auto all = ab | bc;
+    static_assert(all.all(), "");
+    static_assert((ab & bc) == flags(test_flags::b), "");
+    static_assert(ab.is_subset_of(all), "");
+    static_assert(!ab.is_set(test_flags::c), "");
+    REQUIRE(all == flags(test_flags::a, test_flags::b, test_flags::c));
+}
+#endif
+
+namespace
+{
+enum class many_flags
+{
+    flag_count_ = 200,
+};
+
+many_flags many_flag(int i)
+{
+    return static_cast<many_flags>(i);
+}
+} // namespace
+
+TEST_CASE("tiny_flag_set with many flags")
+{
+    // start at an offset, so words are not aligned
+    std::uint8_t storage[26] = {};
+    auto         view        = make_bit_view<3, 3 + 200>(storage);
+    auto         proxy       = make_tiny_proxy<tiny_flag_set<many_flags>>(view);
+
+    REQUIRE(proxy.none());
+    REQUIRE(proxy == flags<many_flags>());
+
+    proxy = flags(many_flag(0), many_flag(63), many_flag(64), many_flag(199));
+    REQUIRE(proxy.any());
+    REQUIRE(!proxy.all());
+    for (auto i = 0; i != 200; ++i)
+    {
+        auto expected = i == 0 || i == 63 || i == 64 || i == 199;
+        REQUIRE(proxy.is_set(many_flag(i)) == expected);
+        REQUIRE(proxy[many_flag(i)] == expected);
+    }
+    REQUIRE((storage[0] & 0x7) == 0);
+    REQUIRE((storage[25] & ~0x7) == 0);
+
+    auto combo = proxy.combo();
+    REQUIRE(combo.is_set(many_flag(199)));
+    REQUIRE(combo.is_subset_of(combo | flags(many_flag(100))));
+    REQUIRE(!(combo | flags(many_flag(100))).is_subset_of(combo));
+
+    proxy.set(many_flag(150));
+    REQUIRE(proxy == (combo | flags(many_flag(150))));
+
+    proxy -= flags(many_flag(63), many_flag(150));
+    REQUIRE(proxy == flags(many_flag(0), many_flag(64), many_flag(199)));
+
+    proxy.toggle_all();
+    REQUIRE(!proxy.is_set(many_flag(0)));
+    REQUIRE(proxy.is_set(many_flag(1)));
+    REQUIRE(!proxy.is_set(many_flag(199)));
+    REQUIRE(proxy.any());
+    REQUIRE(!proxy.all());
+
+    proxy.set_all();
+    REQUIRE(proxy.all());
+    REQUIRE(proxy.combo().all());
+    REQUIRE((storage[0] & 0x7) == 0);
+    REQUIRE((storage[25] & ~0x7) == 0);
+
+    proxy.reset_all();
+    REQUIRE(proxy.none());
+}
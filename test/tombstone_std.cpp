@@ -0,0 +1,81 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/tombstone_std.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/check_size.hpp>
+#include <foonathan/tiny/optional_impl.hpp>
+
+using namespace foonathan::tiny;
+
+FOONATHAN_TINY_CHECK_SIZE(optional_impl<std::unique_ptr<int>>, sizeof(int*));
+FOONATHAN_TINY_CHECK_SIZE(optional_impl<std::unique_ptr<int[]>>, sizeof(int*));
+FOONATHAN_TINY_CHECK_SIZE(optional_impl<std::reference_wrapper<int>>, sizeof(int*));
+FOONATHAN_TINY_CHECK_SIZE(optional_impl<std::reference_wrapper<const char>>, sizeof(char*));
+
+namespace
+{
+template <typename T>
+void verify_tombstones(std::size_t tc)
+{
+    using traits = tombstone_traits<T>;
+
+    std::size_t count = traits::tombstone_count;
+    REQUIRE(count == tc);
+
+    typename traits::storage_type storage;
+    for (auto i = 0u; i != count; ++i)
+    {
+        traits::create_tombstone(storage, i);
+        REQUIRE(traits::get_tombstone(storage) == i);
+    }
+}
+} // namespace
+
+TEST_CASE("tombstone_traits std::unique_ptr")
+{
+    verify_tombstones<std::unique_ptr<char>>(0);
+    verify_tombstones<std::unique_ptr<std::uint32_t>>(3);
+    verify_tombstones<std::unique_ptr<std::uint32_t[]>>(3);
+
+    using opt_t = optional_impl<std::unique_ptr<std::uint32_t>>;
+    REQUIRE(opt_t::is_compressed::value);
+
+    opt_t opt;
+    REQUIRE(!opt.has_value());
+
+    opt.create_value(nullptr);
+    REQUIRE(opt.has_value());
+    REQUIRE(opt.value() == nullptr);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+
+    opt.create_value(new std::uint32_t(42));
+    REQUIRE(opt.has_value());
+    REQUIRE(*opt.value() == 42u);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+}
+
+TEST_CASE("tombstone_traits std::reference_wrapper")
+{
+    verify_tombstones<std::reference_wrapper<char>>(1);
+    verify_tombstones<std::reference_wrapper<const std::uint32_t>>(4);
+
+    using opt_t = optional_impl<std::reference_wrapper<int>>;
+    REQUIRE(opt_t::is_compressed::value);
+
+    opt_t opt;
+    REQUIRE(!opt.has_value());
+
+    int i = 42;
+    opt.create_value(i);
+    REQUIRE(opt.has_value());
+    REQUIRE(&opt.value().get() == &i);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+    REQUIRE(optional_impl<std::reference_wrapper<char>>::is_compressed::value);
+}
@@ -190,6 +190,166 @@ TEST_CASE("tombstone_traits padded")
     }
 }
 
+namespace
+{
+class string_ref
+{
+public:
+    string_ref(const char* str, std::size_t size) : size_(size), str_(str) {}
+
+    friend bool operator==(string_ref lhs, string_ref rhs)
+    {
+        return lhs.str_ == rhs.str_ && lhs.size_ == rhs.size_;
+    }
+
+private:
+    std::size_t size_;
+    const char* str_;
+};
+
+struct short_string_ref
+{
+    const char*   str;
+    std::uint16_t size;
+
+    friend bool operator==(short_string_ref lhs, short_string_ref rhs)
+    {
+        return lhs.str == rhs.str && lhs.size == rhs.size;
+    }
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct tombstone_traits<string_ref>
+    : tombstone_traits_pointer_size<string_ref, size_pointer_layout<std::size_t, const char*>>
+    {};
+
+    template <>
+    struct tombstone_traits<short_string_ref>
+    : tombstone_traits_pointer_size<short_string_ref,
+                                    pointer_size_layout<const char*, std::uint16_t>>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("tombstone_traits pointer size")
+{
+    SECTION("size pointer")
+    {
+        storage<string_ref> s;
+        REQUIRE(s.tombstone_count() == std::size_t(-1) >> 1);
+        for (auto i : {std::size_t(0), std::size_t(1), std::size_t(1024), s.tombstone_count() - 1})
+        {
+            s.create_tombstone(i);
+            REQUIRE(s.tombstone() == i);
+        }
+
+        verify_object(string_ref(nullptr, 0));
+        verify_object(string_ref("abc", 0));
+        verify_object(string_ref("abc", 3));
+    }
+    SECTION("pointer size")
+    {
+        verify_tombstones<short_string_ref>(UINT16_MAX);
+        verify_object(short_string_ref{nullptr, 0});
+        verify_object(short_string_ref{"abc", 0});
+        verify_object(short_string_ref{"abc", 3});
+    }
+}
+
+namespace
+{
+enum class row_id : std::uint32_t
+{
+};
+
+enum class column_id : std::int16_t
+{
+};
+
+enum class offset : long
+{
+};
+
+enum class node_index : std::uint32_t
+{
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct tombstone_traits<row_id> : tombstone_traits_sentinel<row_id, row_id(UINT32_MAX)>
+    {};
+
+    template <>
+    struct tombstone_traits<column_id>
+    : tombstone_traits_sentinel<column_id, column_id(-1), column_id(INT16_MIN), column_id(42)>
+    {};
+
+    template <>
+    struct tombstone_traits<offset>
+    : tombstone_traits_sentinel_range<offset, offset(-16), offset(-1)>
+    {};
+
+    // everything above 2^31 is a tombstone
+    template <>
+    struct tombstone_traits<node_index>
+    : tombstone_traits_sentinel_range<node_index, node_index(1u << 31), node_index(UINT32_MAX)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+static_assert(sizeof(optional_impl<row_id>) == sizeof(row_id), "");
+static_assert(sizeof(optional_impl<node_index>) == sizeof(node_index), "");
+
+TEST_CASE("tombstone_traits sentinel")
+{
+    SECTION("single")
+    {
+        verify_tombstones<row_id>(1);
+        verify_object(row_id(0));
+        verify_object(row_id(UINT32_MAX - 1));
+    }
+    SECTION("multiple")
+    {
+        verify_tombstones<column_id>(3);
+        verify_object(column_id(0));
+        verify_object(column_id(-2));
+        verify_object(column_id(INT16_MAX));
+    }
+    SECTION("signed range")
+    {
+        verify_tombstones<offset>(16);
+        verify_object(offset(0));
+        verify_object(offset(-17));
+        verify_object(offset(LONG_MIN));
+        verify_object(offset(LONG_MAX));
+    }
+    SECTION("unsigned range")
+    {
+        storage<node_index> s;
+        // limited to half the range of std::size_t, so only 2^31 - 1 on 32 bit targets
+        auto range_size = std::uintmax_t(1) << 31;
+        auto max_count  = std::uintmax_t(std::size_t(-1) >> 1);
+        REQUIRE(s.tombstone_count() == (range_size < max_count ? range_size : max_count));
+        for (auto i : {std::size_t(0), std::size_t(1), s.tombstone_count() - 1})
+        {
+            s.create_tombstone(i);
+            REQUIRE(s.tombstone() == i);
+        }
+
+        verify_object(node_index(0));
+        verify_object(node_index((1u << 31) - 1));
+    }
+}
+
 TEST_CASE("tombstone_traits tiny")
 {
     SECTION("bool")
@@ -221,6 +381,96 @@ TEST_CASE("tombstone_traits tiny")
     }
 }
 
+namespace
+{
+enum class signed_enum : std::int8_t
+{
+    min = -2,
+    max = 2,
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct enum_traits<signed_enum>
+    : enum_traits_signed<signed_enum, signed_enum::min, signed_enum::max>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("tombstone_traits enum")
+{
+    SECTION("unsigned")
+    {
+        enum class foo : std::uint8_t
+        {
+            a,
+            b,
+            c,
+            unsigned_count_,
+        };
+
+        verify_tombstones<foo>(253);
+        verify_object(foo::a);
+        verify_object(foo::b);
+        verify_object(foo::c);
+
+        storage<foo> s;
+        s.create_tombstone(0);
+        REQUIRE(static_cast<std::uint8_t>(s.storage.object) == 3u);
+        s.create_tombstone(252);
+        REQUIRE(static_cast<std::uint8_t>(s.storage.object) == 255u);
+    }
+    SECTION("signed")
+    {
+        verify_tombstones<signed_enum>(256 - 5);
+        for (auto i = -2; i <= 2; ++i)
+            verify_object(static_cast<signed_enum>(i));
+
+        storage<signed_enum> s;
+        s.create_tombstone(0);
+        REQUIRE(static_cast<std::int8_t>(s.storage.object) == 3);
+        s.create_tombstone(124);
+        REQUIRE(static_cast<std::int8_t>(s.storage.object) == 127);
+        s.create_tombstone(125);
+        REQUIRE(static_cast<std::int8_t>(s.storage.object) == -3);
+        s.create_tombstone(250);
+        REQUIRE(static_cast<std::int8_t>(s.storage.object) == -128);
+    }
+    SECTION("big")
+    {
+        enum class foo : std::uint64_t
+        {
+            a,
+            b,
+            unsigned_count_,
+        };
+
+        storage<foo> s;
+        REQUIRE(s.tombstone_count() == std::size_t(-1) >> 1);
+        for (auto i : {std::size_t(0), std::size_t(1), s.tombstone_count() - 1})
+        {
+            s.create_tombstone(i);
+            REQUIRE(s.tombstone() == i);
+        }
+        verify_object(foo::a);
+        verify_object(foo::b);
+    }
+    SECTION("no traits")
+    {
+        enum class foo : std::uint8_t
+        {
+            a,
+            b,
+        };
+
+        verify_tombstones<foo>(0);
+    }
+}
+
 TEST_CASE("tombstone_traits optional_impl")
 {
     SECTION("not compressed")